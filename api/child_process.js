@@ -449,7 +449,10 @@ export class ChildProcess extends EventEmitter {
 }
 
 /**
- * Spawns a child process exeucting `command` with `args`
+ * Spawns a child process exeucting `command` with `args`. Output is read in
+ * lines unless `options.stream` is `true`, in which case it is streamed in
+ * raw chunks and reading from the child process is paused while its
+ * `stdout` or `stderr` streams are not drained.
  * @param {string} command
  * @param {string[]|object=} [args]
  * @param {object=} [options
@@ -494,7 +497,10 @@ export function exec (command, options, callback) {
       }
 
       stdout.push(Buffer.from(data))
-      stdout.push(Buffer.from('\n'))
+      // streamed output is not split into lines
+      if (!options?.stream) {
+        stdout.push(Buffer.from('\n'))
+      }
     })
   }
 
@@ -505,7 +511,9 @@ export function exec (command, options, callback) {
       }
 
       stderr.push(Buffer.from(data))
-      stderr.push(Buffer.from('\n'))
+      if (!options?.stream) {
+        stderr.push(Buffer.from('\n'))
+      }
     })
   }
 
@@ -600,6 +608,33 @@ export function exec (command, options, callback) {
   })
 }
 
+/**
+ * Decodes the percent encoded output of `child_process.exec` into the exact
+ * bytes the child process wrote.
+ * @ignore
+ * @param {string} value
+ * @return {Buffer}
+ */
+function decodeExecOutput (value) {
+  if (typeof value !== 'string' || value.length === 0) {
+    return Buffer.alloc(0)
+  }
+
+  const bytes = Buffer.alloc(value.length)
+  let length = 0
+
+  for (let i = 0; i < value.length; ++i) {
+    if (value[i] === '%' && i + 2 < value.length) {
+      bytes[length++] = parseInt(value.slice(i + 1, i + 3), 16)
+      i += 2
+    } else {
+      bytes[length++] = value.charCodeAt(i)
+    }
+  }
+
+  return bytes.subarray(0, length)
+}
+
 export function execSync (command, options) {
   const result = ipc.sendSync('child_process.exec', {
     id: rand64(),
@@ -612,6 +647,12 @@ export function execSync (command, options) {
     killSignal: options?.killSignal ?? signal.SIGTERM
   })
 
+  const encoding = options?.encoding && options.encoding !== 'buffer'
+    ? options.encoding
+    : null
+
+  const toOutput = (buffer) => encoding ? buffer.toString(encoding) : buffer
+
   if (result.err) {
     // @ts-ignore
     if (!result.err.code) {
@@ -619,19 +660,23 @@ export function execSync (command, options) {
     }
 
     // @ts-ignore
-    const { stdout, stderr, signal: errorSignal, code, pid } = result.err
+    const { signal: errorSignal, code, pid } = result.err
+    // @ts-ignore
+    const stdout = decodeExecOutput(result.err.stdout)
+    // @ts-ignore
+    const stderr = decodeExecOutput(result.err.stderr)
     const message = code === 'ETIMEDOUT'
       ? 'execSync ETIMEDOUT'
-      : stderr.join('\n')
+      : stderr.toString()
 
     const error = Object.assign(new Error(message), {
       pid,
-      stdout,
-      stderr,
+      stdout: toOutput(stdout),
+      stderr: toOutput(stderr),
       code: typeof code === 'string' ? code : null,
       signal: errorSignal || signal.toString(options?.killSignal) || null,
       status: Number.isFinite(code) ? code : null,
-      output: [null, stdout.join('\n'), stderr.join('\n')]
+      output: [null, toOutput(stdout), toOutput(stderr)]
     })
 
     // @ts-ignore
@@ -645,21 +690,23 @@ export function execSync (command, options) {
     throw error
   }
 
-  const { stdout, stderr, signal: errorSignal, code, pid } = result.data
+  const { signal: errorSignal, code, pid } = result.data
+  const stdout = decodeExecOutput(result.data.stdout)
+  const stderr = decodeExecOutput(result.data.stderr)
 
   if (code) {
     const message = code === 'ETIMEDOUT'
       ? 'execSync ETIMEDOUT'
-      : stderr.join('\n')
+      : stderr.toString()
 
     const error = Object.assign(new Error(message), {
       pid,
-      stdout,
-      stderr,
+      stdout: toOutput(stdout),
+      stderr: toOutput(stderr),
       code: typeof code === 'string' ? code : null,
       signal: errorSignal || null,
       status: Number.isFinite(code) ? code : null,
-      output: [null, stdout, stderr]
+      output: [null, toOutput(stdout), toOutput(stderr)]
     })
 
     // @ts-ignore
@@ -673,11 +720,7 @@ export function execSync (command, options) {
     throw error
   }
 
-  const output = stdout && options?.encoding === 'utf8'
-    ? stdout
-    : Buffer.from(stdout)
-
-  return output
+  return toOutput(stdout)
 }
 
 export const execFile = exec
@@ -1,10 +1,13 @@
 import { parentPort } from '../worker_threads.js'
 import process from '../process.js'
 import signal from '../process/signal.js'
-import ipc from '../ipc.js'
+import ipc, { IPCSearchParams } from '../ipc.js'
 
 const state = {}
 
+// the number of output streams waiting for a 'drain' event
+let pending = 0
+
 const propagateWorkerError = err => parentPort.postMessage({
   worker_threads: {
     error: {
@@ -16,6 +19,57 @@ const propagateWorkerError = err => parentPort.postMessage({
   }
 })
 
+/**
+ * Pauses reading the output of the child process until `writable` drained.
+ * @ignore
+ * @param {import('../stream.js').Writable} writable
+ * @return {Promise}
+ */
+async function drain (writable) {
+  if (pending++ === 0) {
+    await ipc.send('child_process.pause', { id: state.id })
+  }
+
+  await new Promise((resolve) => writable.once('drain', resolve))
+
+  if (--pending === 0) {
+    await ipc.send('child_process.resume', { id: state.id })
+  }
+}
+
+/**
+ * Reads the streamed `source` output of the child process into `writable`,
+ * pausing the child process while `writable` is not drained. Output is
+ * still read, and discarded, without a `writable`.
+ * @ignore
+ * @param {'stdout'|'stderr'} source
+ * @param {import('../stream.js').Writable=} [writable]
+ * @return {Promise}
+ */
+async function stream (source, writable) {
+  const params = new IPCSearchParams({ id: state.id, source })
+  const response = await fetch(`ipc://child_process.stream?${params}`)
+
+  if (!response.ok) {
+    const result = await response.json().catch(() => null)
+    return propagateWorkerError(result?.err ?? new Error(response.statusText))
+  }
+
+  const reader = response.body.getReader()
+
+  while (true) {
+    const { done, value } = await reader.read()
+
+    if (done) {
+      break
+    }
+
+    if (writable && writable.write(value) === false) {
+      await drain(writable)
+    }
+  }
+}
+
 if (process.stdin) {
   process.stdin.on('data', async (data) => {
     const { id } = state
@@ -39,7 +93,8 @@ parentPort.onmessage = async ({ data: { id, method, args } }) => {
       cwd: opts?.cwd ?? '',
       stdin: opts?.stdin !== false,
       stdout: opts?.stdout !== false,
-      stderr: opts?.stderr !== false
+      stderr: opts?.stderr !== false,
+      stream: opts?.stream === true
     }
 
     const result = await ipc.send('childProcess.spawn', params)
@@ -56,7 +111,21 @@ parentPort.onmessage = async ({ data: { id, method, args } }) => {
 
     parentPort.postMessage({ method: 'state', args: [state] })
 
-    globalThis.addEventListener('data', ({ detail }) => {
+    // the child process is closed once its output was read
+    const streams = []
+
+    // output is posted as raw chunks where the runtime cannot stream it
+    if (params.stream && result.data.stream) {
+      if (params.stdout) {
+        streams.push(stream('stdout', process.stdout))
+      }
+
+      if (params.stderr) {
+        streams.push(stream('stderr', process.stderr))
+      }
+    }
+
+    globalThis.addEventListener('data', async ({ detail }) => {
       const { err, data, source } = detail.params
       const buffer = detail.data
 
@@ -67,18 +136,19 @@ parentPort.onmessage = async ({ data: { id, method, args } }) => {
       if (!data || BigInt(data.id) !== state.id) return
 
       if (source === 'childProcess.spawn' && data.source === 'stdout') {
-        if (process.stdout) {
-          process.stdout.write(buffer)
+        if (process.stdout && process.stdout.write(buffer) === false && params.stream) {
+          drain(process.stdout)
         }
       }
 
       if (source === 'childProcess.spawn' && data.source === 'stderr') {
-        if (process.stderr) {
-          process.stderr.write(buffer)
+        if (process.stderr && process.stderr.write(buffer) === false && params.stream) {
+          drain(process.stderr)
         }
       }
 
       if (source === 'childProcess.spawn' && data.status === 'close') {
+        await Promise.all(streams)
         state.exitCode = data.code
         state.lifecycle = 'close'
         parentPort.postMessage({ method: 'state', args: [state] })
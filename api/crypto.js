@@ -12,8 +12,10 @@
  * ```
  */
 
+import { fileURLToPath } from './url.js'
 import { toBuffer } from './util.js'
 import { Buffer } from './buffer.js'
+import ipc from './ipc.js'
 
 import * as exports from './crypto.js'
 
@@ -142,6 +144,87 @@ export function randomBytes (size) {
   return Buffer.concat(buffers)
 }
 
+/**
+ * Maximum size of random bytes generated natively per request.
+ */
+export const MAX_RANDOM_FILL_SIZE = 64 * 1024 * 1024
+
+/**
+ * Fills `buffer`, or `size` elements of it from `offset`, with
+ * cryptographically strong random values generated natively, off the main
+ * thread for large buffers. Like Node's `crypto.randomFill()`, `callback`
+ * is called with `(err, buffer)` when given, otherwise a promise is returned.
+ * @param {TypedArray|DataView|ArrayBuffer} buffer
+ * @param {number=} [offset = 0] - The element to start filling at
+ * @param {number=} [size = buffer.length - offset] - The number of elements to fill
+ * @param {function(Error?, TypedArray|DataView|ArrayBuffer)=} [callback]
+ * @return {Promise<TypedArray|DataView|ArrayBuffer>|undefined}
+ */
+export function randomFill (buffer, offset, size, callback) {
+  if (typeof offset === 'function') {
+    callback = offset
+    offset = undefined
+  } else if (typeof size === 'function') {
+    callback = size
+    size = undefined
+  }
+
+  if (!ArrayBuffer.isView(buffer) && !(buffer instanceof ArrayBuffer)) {
+    throw new TypeError('Expecting buffer to be an ArrayBuffer, TypedArray or DataView')
+  }
+
+  const elementSize = buffer.BYTES_PER_ELEMENT ?? 1
+  const length = buffer.byteLength / elementSize
+
+  offset = offset ?? 0
+  size = size ?? length - offset
+
+  if (!Number.isInteger(offset) || offset < 0 || offset > length) {
+    throw new RangeError(`Expecting offset to be an integer between 0 and ${length}`)
+  }
+
+  if (!Number.isInteger(size) || size < 0 || offset + size > length) {
+    throw new RangeError(`Expecting size to be an integer between 0 and ${length - offset}`)
+  }
+
+  const output = ArrayBuffer.isView(buffer)
+    ? Buffer.from(buffer.buffer, buffer.byteOffset + offset * elementSize, size * elementSize)
+    : Buffer.from(buffer, offset, size)
+
+  const promise = fillRandomBytes(output).then(() => buffer)
+
+  if (typeof callback === 'function') {
+    promise.then((result) => callback(null, result), (err) => callback(err))
+    return
+  }
+
+  return promise
+}
+
+/**
+ * Fills `output` with random bytes generated natively.
+ * @ignore
+ * @param {Buffer} output
+ * @return {Promise}
+ */
+async function fillRandomBytes (output) {
+  let offset = 0
+
+  while (offset < output.byteLength) {
+    const size = Math.min(MAX_RANDOM_FILL_SIZE, output.byteLength - offset)
+    const result = await ipc.request('crypto.getRandomValues', { size }, {
+      responseType: 'arraybuffer'
+    })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    Buffer.from(result.data).copy(output, offset)
+    offset += size
+  }
+}
+
 /**
  * @param {string} algorithm - `SHA-1` | `SHA-256` | `SHA-384` | `SHA-512`
  * @param {Buffer | TypedArray | DataView} message - An instance of socket.Buffer, TypedArray or Dataview.
@@ -151,6 +234,60 @@ export async function createDigest (algorithm, buf) {
   return Buffer.from(await webcrypto.subtle.digest(algorithm, buf))
 }
 
+/**
+ * Computes a digest of `input` natively, off the main thread. Files are
+ * hashed without their contents being read into JavaScript.
+ * @param {string} algorithm - `sha1` | `sha256` | `blake3`
+ * @param {string|URL|import('./fs/handle.js').FileHandle|Buffer|TypedArray|ArrayBuffer} input
+ *   A path, an open `FileHandle` or bytes to hash.
+ * @param {{ onprogress?: function({ bytes: number, size: number }): void }=} [options]
+ * @returns {Promise<Buffer>} - A promise that resolves with the digest.
+ */
+export async function digest (algorithm, input, options = null) {
+  const params = { algorithm }
+  const progress = typeof options?.onprogress === 'function' ? rand64() : 0n
+  let result = null
+
+  function onprogress ({ detail }) {
+    const { data, source } = detail.params
+    if (source === 'crypto.digest' && data && BigInt(data.id) === progress) {
+      options.onprogress({ bytes: data.bytes, size: data.size })
+    }
+  }
+
+  if (progress) {
+    params.progress = progress
+    globalThis.addEventListener('data', onprogress)
+  }
+
+  try {
+    if (typeof input === 'string') {
+      params.path = input
+      result = await ipc.request('crypto.digest', params)
+    } else if (input instanceof URL) {
+      // the file is opened natively, so a URL is given as the path it names
+      params.path = decodeURIComponent(fileURLToPath(input))
+        .replace(/^\/([a-zA-Z]:)/, '$1')
+      result = await ipc.request('crypto.digest', params)
+    } else if (input && typeof input === 'object' && 'fd' in input && input.id) {
+      params.id = input.id
+      result = await ipc.request('crypto.digest', params)
+    } else {
+      result = await ipc.write('crypto.digest', params, toBuffer(input))
+    }
+  } finally {
+    if (progress) {
+      globalThis.removeEventListener('data', onprogress)
+    }
+  }
+
+  if (result.err) {
+    throw result.err
+  }
+
+  return Buffer.from(result.data.digest, 'hex')
+}
+
 /**
  * A murmur3 hash implementation based on https://github.com/jwerle/murmurhash.c
  * that works on strings and `ArrayBuffer` views (typed arrays)
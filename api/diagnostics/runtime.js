@@ -88,6 +88,65 @@ export class UVDiagnostic extends Diagnostic {
  */
 export class PostsDiagnostic extends Diagnostic {}
 
+/**
+ * A container for queued response diagnostics.
+ */
+export class QueuedResponsesDiagnostic extends Diagnostic {
+  /**
+   * A container for the time between queueing a response and it being
+   * fetched, in milliseconds.
+   */
+  static HitLatency = class HitLatency {
+    /**
+     * The average hit latency.
+     * @type {number}
+     */
+    average = 0
+
+    /**
+     * The maximum hit latency.
+     * @type {number}
+     */
+    max = 0
+  }
+
+  /**
+   * The number of live bytes held by queued responses.
+   * @type {number}
+   */
+  bytes = 0
+
+  /**
+   * The number of queued responses that expired before being fetched.
+   * @type {number}
+   */
+  expirations = 0
+
+  /**
+   * The number of queued responses evicted to stay within the byte budget.
+   * @type {number}
+   */
+  evictions = 0
+
+  /**
+   * The number of queued responses that were fetched.
+   * @type {number}
+   */
+  hits = 0
+
+  /**
+   * The number of fetches for queued responses that did not exist.
+   * @type {number}
+   */
+  misses = 0
+
+  /**
+   * Hit latency of fetched queued responses.
+   * @type {QueuedResponsesDiagnostic.HitLatency}
+   */
+  hitLatency = new QueuedResponsesDiagnostic.HitLatency()
+}
+
 /**
  * A container for child process diagnostics.
  */
@@ -175,17 +234,69 @@ export class TimersDiagnostic extends Diagnostic {
  */
 export class UDPDiagnostic extends Diagnostic {}
 
+/**
+ * A container for service worker diagnostics.
+ */
+export class ServiceWorkerDiagnostic extends Diagnostic {
+  /**
+   * A container for in-flight service worker fetch diagnostics.
+   */
+  static FetchesDiagnostic = class FetchesDiagnostic extends Diagnostic {}
+
+  /**
+   * A container for service worker fetches waiting for their
+   * registration to activate.
+   */
+  static PendingFetchesDiagnostic = class PendingFetchesDiagnostic extends Diagnostic {}
+
+  /**
+   * @type {ServiceWorkerDiagnostic.FetchesDiagnostic}
+   */
+  fetches = new ServiceWorkerDiagnostic.FetchesDiagnostic()
+
+  /**
+   * @type {ServiceWorkerDiagnostic.PendingFetchesDiagnostic}
+   */
+  pendingFetches = new ServiceWorkerDiagnostic.PendingFetchesDiagnostic()
+}
+
+/**
+ * A container for IPC route diagnostics.
+ */
+export class IPCDiagnostic {
+  /**
+   * A container for the counters of a called IPC route. Latencies are in
+   * microseconds, from the route being invoked until it replies.
+   */
+  static RouteDiagnostic = class RouteDiagnostic {
+    calls = 0
+    replies = 0
+    errors = 0
+    bytes = { in: 0, out: 0 }
+    latency = { average: 0, p50: 0, p99: 0, max: 0 }
+  }
+
+  /**
+   * Counters of the routes that were called, keyed by route name.
+   * @type {Object<string, IPCDiagnostic.RouteDiagnostic>}
+   */
+  routes = {}
+}
+
 /**
  * A container for various queried runtime diagnostics.
  */
 export class QueryDiagnostic {
   posts = new PostsDiagnostic()
+  queuedResponses = new QueuedResponsesDiagnostic()
   childProcess = new ChildProcessDiagnostic()
   ai = new AIDiagnostic()
   fs = new FSDiagnostic()
   timers = new TimersDiagnostic()
   udp = new UDPDiagnostic()
   uv = new UVDiagnostic()
+  serviceWorker = new ServiceWorkerDiagnostic()
+  ipc = new IPCDiagnostic()
 }
 
 /**
@@ -376,6 +376,7 @@ class WebAssemblyExtensionRuntimeBuffer extends WebAssemblyExtensionRuntimeObjec
   pointer = NULL
   #buffer = new Uint8Array(0)
   #bufferPointer = NULL
+  #ownedPointer = NULL
 
   constructor (adapter, context) {
     super(adapter)
@@ -395,8 +396,36 @@ class WebAssemblyExtensionRuntimeBuffer extends WebAssemblyExtensionRuntimeObjec
     this.#buffer = new Uint8Array(size)
     this.#buffer.fill(0)
     this.#buffer.set(this.adapter.get(pointer, size))
+    this.#release()
     this.#bufferPointer = pointer
   }
+
+  /**
+   * Copies `size` bytes at `pointer` into heap memory owned by this buffer,
+   * so the caller may free `pointer` right after. The copy lives until the
+   * buffer is set again or its context is released.
+   * @param {number} pointer
+   * @param {number} size
+   */
+  copy (pointer, size) {
+    this.set(pointer, size)
+
+    if (size > 0) {
+      const bufferPointer = this.context.alloc(size)
+      this.adapter.set(bufferPointer, this.#buffer)
+      this.#bufferPointer = bufferPointer
+      this.#ownedPointer = bufferPointer
+    } else {
+      this.#bufferPointer = NULL
+    }
+  }
+
+  #release () {
+    if (this.#ownedPointer) {
+      this.context.free(this.#ownedPointer)
+      this.#ownedPointer = NULL
+    }
+  }
 }
 
 class WebAssemblyExtensionRuntimeJSON extends WebAssemblyExtensionRuntimeObject {
@@ -3809,6 +3838,20 @@ function createWebAssemblyExtensionImports (env) {
   Object.assign(imports.env, {
   })
 
+  // bytes handed to the `*_owned` functions are copied into memory the
+  // runtime owns, so they are released right away
+  function releaseOwnedBytes (bytesPointer, freePointer, dataPointer) {
+    if (!bytesPointer) {
+      return
+    }
+
+    if (freePointer) {
+      env.adapter.indirectFunctionTable.call(freePointer, bytesPointer, dataPointer)
+    } else {
+      env.adapter.heap.free(bytesPointer)
+    }
+  }
+
   // <socket/extension.h>
   Object.assign(imports.env, {
     // utils
@@ -3959,6 +4002,74 @@ function createWebAssemblyExtensionImports (env) {
       }
     },
 
+    sapi_context_queue_work (contextPointer, dataPointer, workCallbackPointer, afterWorkCallbackPointer) {
+      if (!contextPointer || !workCallbackPointer) {
+        return NULL
+      }
+
+      const context = env.adapter.getExternalReferenceValue(contextPointer)
+
+      if (typeof context?.createExternalReferenceValue !== 'function') {
+        return NULL
+      }
+
+      // there are no worker threads for WebAssembly extensions, so work is
+      // called later on this thread
+      const work = { cancelled: false, done: false }
+      const workPointer = context.createExternalReferenceValue(work)
+
+      setTimeout(() => {
+        try {
+          if (!work.cancelled) {
+            env.adapter.indirectFunctionTable.call(
+              workCallbackPointer,
+              workPointer,
+              dataPointer
+            )
+          }
+
+          work.done = true
+
+          if (afterWorkCallbackPointer) {
+            env.adapter.indirectFunctionTable.call(
+              afterWorkCallbackPointer,
+              contextPointer,
+              dataPointer,
+              work.cancelled
+            )
+          }
+        } catch (err) {
+          if (err.is(env.tags.exit)) {
+            env.adapter.exitStatus = err.getArg(env.tags.exit, 0)
+            env.adapter.destroy()
+          } else if (err.is(env.tags.abort)) {
+            env.adapter.exitStatus = 1
+            env.adapter.destroy()
+          } else {
+            throw err
+          }
+        }
+      })
+
+      return workPointer
+    },
+
+    sapi_context_work_cancel (workPointer) {
+      const work = workPointer ? env.adapter.getExternalReferenceValue(workPointer) : null
+
+      if (!work || work.done) {
+        return false
+      }
+
+      work.cancelled = true
+      return true
+    },
+
+    sapi_context_work_cancelled (workPointer) {
+      const work = workPointer ? env.adapter.getExternalReferenceValue(workPointer) : null
+      return Boolean(work?.cancelled)
+    },
+
     sapi_context_alloc (contextPointer, size) {
       if (contextPointer) {
         const context = env.adapter.getExternalReferenceValue(contextPointer)
@@ -3970,6 +4081,16 @@ function createWebAssemblyExtensionImports (env) {
       return NULL
     },
 
+    sapi_bytes_alloc (size) {
+      return size > 0 ? env.adapter.heap.alloc(size) : NULL
+    },
+
+    sapi_bytes_free (bytesPointer) {
+      if (bytesPointer) {
+        env.adapter.heap.free(bytesPointer)
+      }
+    },
+
     sapi_context_get_parent (contextPointer) {
       if (contextPointer) {
         const context = env.adapter.getExternalReferenceValue(contextPointer)
@@ -4566,6 +4687,17 @@ function createWebAssemblyExtensionImports (env) {
       result.bytes.set(bytesPointer, size)
     },
 
+    sapi_ipc_result_set_bytes_owned (resultPointer, size, bytesPointer, freePointer, dataPointer) {
+      try {
+        if (resultPointer) {
+          const result = env.adapter.getExternalReferenceValue(resultPointer)
+          result.bytes.copy(bytesPointer, size)
+        }
+      } finally {
+        releaseOwnedBytes(bytesPointer, freePointer, dataPointer)
+      }
+    },
+
     sapi_ipc_result_get_bytes (resultPointer) {
       if (!resultPointer) {
         return NULL
@@ -4638,6 +4770,11 @@ function createWebAssemblyExtensionImports (env) {
       return false
     },
 
+    sapi_ipc_set_work_cancellation_handler (resultPointer, workPointer) {
+      console.warn('sapi_ipc_set_work_cancellation_handler: Operation is not supported')
+      return false
+    },
+
     sapi_ipc_reply (resultPointer) {
       if (!resultPointer) {
         return NULL
@@ -4795,6 +4932,28 @@ function createWebAssemblyExtensionImports (env) {
       }
     },
 
+    sapi_ipc_send_bytes_owned (contextPointer, messagePointer, size, bytesPointer, freePointer, dataPointer, headersPointer) {
+      try {
+        return imports.env.sapi_ipc_send_bytes(contextPointer, messagePointer, size, bytesPointer, headersPointer)
+      } finally {
+        releaseOwnedBytes(bytesPointer, freePointer, dataPointer)
+      }
+    },
+
+    sapi_ipc_send_bytes_with_result_owned (contextPointer, resultPointer, size, bytesPointer, freePointer, dataPointer, headersPointer) {
+      try {
+        const sent = imports.env.sapi_ipc_send_bytes_with_result(contextPointer, resultPointer, size, bytesPointer, headersPointer)
+        if (contextPointer && resultPointer && bytesPointer) {
+          const result = env.adapter.getExternalReferenceValue(resultPointer)
+          result.bytes.copy(bytesPointer, size)
+        }
+
+        return sent
+      } finally {
+        releaseOwnedBytes(bytesPointer, freePointer, dataPointer)
+      }
+    },
+
     sapi_ipc_emit (contextPointer, namePointer, dataPointer) {
       if (!contextPointer || !namePointer) {
         return NULL
@@ -4885,6 +5044,11 @@ function createWebAssemblyExtensionImports (env) {
       return false
     },
 
+    sapi_ipc_router_stats (contextPointer, routePointer, statsPointer) {
+      console.warn('sapi_ipc_router_stats: Operation is not supported')
+      return false
+    },
+
     sapi_process_exec (contextPointer, commandPointer) {
       console.warn('sapi_process_exec: Operation is not supported')
       return NULL
@@ -0,0 +1,258 @@
+/* global Request, Response */
+import ipc from '../ipc.js'
+
+const CACHE_STATUS_HEADER = 'x-service-worker-cache-status'
+
+function getRequestURL (request) {
+  if (typeof request === 'string' || request instanceof URL) {
+    return new URL(request, globalThis.location.href).href
+  }
+
+  return new URL(request.url, globalThis.location.href).href
+}
+
+// caches are kept per origin in the runtime
+function getOrigin () {
+  return globalThis.location?.origin ?? ''
+}
+
+function serializeHeaders (headers) {
+  if (!headers) {
+    return ''
+  }
+
+  return Array.from(new Headers(headers).entries())
+    .map(([name, value]) => `${name}: ${value}`)
+    .join('\n')
+}
+
+async function match (request, name = '') {
+  const result = await ipc.request('serviceWorker.cache.match', {
+    origin: getOrigin(),
+    url: getRequestURL(request),
+    headers: serializeHeaders(request?.headers),
+    name
+  }, { responseType: 'arraybuffer' })
+
+  if (result.err) {
+    throw result.err
+  }
+
+  const headers = new Headers(result.headers ?? {})
+  const status = parseInt(headers.get(CACHE_STATUS_HEADER))
+
+  if (!status) {
+    return undefined
+  }
+
+  headers.delete(CACHE_STATUS_HEADER)
+
+  const body = status === 204 || status === 304 || request?.method === 'HEAD'
+    ? null
+    : new Uint8Array(result.data?.buffer ?? result.data ?? [])
+
+  return new Response(body, { status, headers })
+}
+
+/**
+ * A named, disk-backed cache of `Request`/`Response` pairs that lives in
+ * the runtime. Responses stored here can be served by the runtime directly
+ * without waking the service worker.
+ */
+export class NativeCache {
+  #name = null
+
+  /**
+   * `NativeCache` class constructor.
+   * @ignore
+   * @param {string} name
+   */
+  constructor (name) {
+    this.#name = name
+  }
+
+  /**
+   * The name of this cache.
+   * @type {string}
+   */
+  get name () {
+    return this.#name
+  }
+
+  /**
+   * Stores a `response` for a `request` in this cache. Only `GET` requests
+   * can be stored and partial (206) responses are rejected.
+   * @param {Request|string|URL} request
+   * @param {Response} response
+   * @return {Promise<undefined>}
+   */
+  async put (request, response) {
+    if (typeof request === 'object' && !(request instanceof URL)) {
+      if (request.method && request.method.toUpperCase() !== 'GET') {
+        throw new TypeError('Only GET requests can be cached')
+      }
+    }
+
+    const body = new Uint8Array(await response.clone().arrayBuffer())
+    const result = await ipc.write('serviceWorker.cache.put', {
+      origin: getOrigin(),
+      name: this.#name,
+      url: getRequestURL(request),
+      statusCode: response.status,
+      headers: serializeHeaders(response.headers),
+      requestHeaders: serializeHeaders(request?.headers)
+    }, body)
+
+    if (result.err) {
+      throw result.err
+    }
+  }
+
+  /**
+   * Fetches `request` and stores the response in this cache.
+   * @param {Request|string|URL} request
+   * @return {Promise<undefined>}
+   */
+  async add (request) {
+    const response = await fetch(request)
+
+    if (!response.ok) {
+      throw new TypeError(`Failed to fetch '${getRequestURL(request)}': ${response.status}`)
+    }
+
+    await this.put(request, response)
+  }
+
+  /**
+   * Fetches all `requests` and stores their responses in this cache.
+   * @param {(Request|string|URL)[]} requests
+   * @return {Promise<undefined>}
+   */
+  async addAll (requests) {
+    await Promise.all(requests.map((request) => this.add(request)))
+  }
+
+  /**
+   * Gets the response stored for `request` in this cache.
+   * @param {Request|string|URL} request
+   * @return {Promise<Response|undefined>}
+   */
+  async match (request) {
+    return await match(request, this.#name)
+  }
+
+  /**
+   * Removes the responses stored for `request` in this cache.
+   * @param {Request|string|URL} request
+   * @return {Promise<boolean>}
+   */
+  async delete (request) {
+    const result = await ipc.request('serviceWorker.cache.remove', {
+      origin: getOrigin(),
+      name: this.#name,
+      url: getRequestURL(request),
+      headers: serializeHeaders(request?.headers)
+    })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return result.data?.deleted === true
+  }
+
+  /**
+   * Gets the requests stored in this cache.
+   * @return {Promise<Request[]>}
+   */
+  async keys () {
+    const result = await ipc.request('serviceWorker.cache.keys', {
+      origin: getOrigin(),
+      name: this.#name
+    })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return (result.data ?? []).map((url) => new Request(url))
+  }
+}
+
+/**
+ * A `CacheStorage` like interface to the runtime's disk-backed service
+ * worker caches.
+ */
+export class NativeCacheStorage {
+  /**
+   * Opens (or creates) a cache by `name`.
+   * @param {string} name
+   * @return {Promise<NativeCache>}
+   */
+  async open (name) {
+    const result = await ipc.request('serviceWorker.cache.open', { name, origin: getOrigin() })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return new NativeCache(String(name))
+  }
+
+  /**
+   * `true` if a cache exists for `name`.
+   * @param {string} name
+   * @return {Promise<boolean>}
+   */
+  async has (name) {
+    const result = await ipc.request('serviceWorker.cache.has', { name, origin: getOrigin() })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return result.data?.has === true
+  }
+
+  /**
+   * Deletes a cache by `name`, and all of its entries.
+   * @param {string} name
+   * @return {Promise<boolean>}
+   */
+  async delete (name) {
+    const result = await ipc.request('serviceWorker.cache.delete', { name, origin: getOrigin() })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return result.data?.deleted === true
+  }
+
+  /**
+   * Gets the names of all caches in creation order.
+   * @return {Promise<string[]>}
+   */
+  async keys () {
+    const result = await ipc.request('serviceWorker.cache.names', { origin: getOrigin() })
+
+    if (result.err) {
+      throw result.err
+    }
+
+    return result.data ?? []
+  }
+
+  /**
+   * Gets the first response stored for `request` in any cache, searched in
+   * creation order, or in the cache named `options.cacheName`.
+   * @param {Request|string|URL} request
+   * @param {{ cacheName?: string }=} [options]
+   * @return {Promise<Response|undefined>}
+   */
+  async match (request, options = null) {
+    return await match(request, options?.cacheName ?? '')
+  }
+}
+
+export default new NativeCacheStorage()
@@ -9,6 +9,8 @@ import ipc from '../ipc.js'
 
 export const textEncoder = new TextEncoderStream()
 
+export const FETCH_EVENT_RESPONSE_CHUNK_SIZE = 16 * 1024
+
 export const FETCH_EVENT_TIMEOUT = (
   // TODO(@jwerle): document this
   parseInt(application.config.webview_service_worker_fetch_event_timeout) ||
@@ -299,7 +301,9 @@ export class FetchEvent extends ExtendableEvent {
               break
             }
           }
-        } else {
+
+          arrayBuffer = arrayBuffer ?? new ArrayBuffer(0)
+        } else if (!response.body) {
           arrayBuffer = await response.arrayBuffer()
         }
 
@@ -322,18 +326,38 @@ export class FetchEvent extends ExtendableEvent {
           'auto'
         )
 
-        const buffers = splitBuffer(new Uint8Array(arrayBuffer), 16 * 1024)
-        for (const buffer of buffers) {
-          const result = await ipc.write(
-            'serviceWorker.fetch.response.write',
-            params,
-            buffer
-          )
+        // the body is written in chunks as it is read, each write resolves
+        // once the runtime consumed the chunk which bounds the bytes in flight
+        const reader = arrayBuffer === null ? response.body.getReader() : null
+
+        while (true) {
+          let chunk = null
+
+          if (reader) {
+            const { done, value } = await reader.read()
+            if (done) break
+            chunk = value
+          } else if (arrayBuffer !== null) {
+            chunk = new Uint8Array(arrayBuffer)
+            arrayBuffer = null
+          } else {
+            break
+          }
 
-          if (result.err) {
-            state.reportError(result.err)
-            handled.resolve()
-            return
+          const buffers = splitBuffer(chunk, FETCH_EVENT_RESPONSE_CHUNK_SIZE)
+          for (const buffer of buffers) {
+            const result = await ipc.write(
+              'serviceWorker.fetch.response.write',
+              params,
+              buffer
+            )
+
+            if (result.err) {
+              state.reportError(result.err)
+              reader?.cancel(result.err).catch(() => {})
+              handled.resolve()
+              return
+            }
           }
         }
 
@@ -38,6 +38,7 @@ Object.defineProperties(
 export default null
 
 export const SERVICE_WORKER_READY_TOKEN = { __service_worker_ready: true }
+export const FETCH_REQUEST_BODY_RANGE_SIZE = 1024 * 1024
 
 export const module = { exports: {} }
 export const events = new Set()
@@ -386,26 +387,46 @@ export async function onMessage (event) {
     await stages.activate
 
     if (/post|put|patch|query/i.test(data.fetch.request.method)) {
-      const result = await ipc.request('serviceWorker.fetch.request.body', {
-        id: data.fetch.request.id
-      }, { responseType: 'arraybuffer' })
-
-      if (result.data) {
-        if (result.data instanceof ArrayBuffer) {
-          data.fetch.request.body = result.data
-        } else if (result.data instanceof Buffer) {
-          data.fetch.request.body = result.data.buffer
-        } else if (result.data.buffer) {
-          data.fetch.request.body = result.data.buffer
-        } else if (typeof result.data === 'object') {
-          data.fetch.request.body = JSON.stringify(result.data)
-        } else {
-          data.fetch.request.body = result.data
+      // the request body is read in bounded ranges so a large upload is
+      // never copied into a single reply
+      const chunks = []
+      let offset = 0
+      let size = Infinity
+
+      while (offset < size) {
+        const result = await ipc.request('serviceWorker.fetch.request.body', {
+          id: data.fetch.request.id,
+          size: FETCH_REQUEST_BODY_RANGE_SIZE,
+          offset
+        }, { responseType: 'arraybuffer' })
+
+        if (result.err) {
+          break
+        }
+
+        size = parseInt(result.headers?.get('runtime-request-body-size')) || 0
+
+        if (!result.data?.byteLength) {
+          break
         }
+
+        chunks.push(
+          result.data instanceof ArrayBuffer
+            ? new Uint8Array(result.data)
+            : result.data
+        )
+
+        offset += result.data.byteLength
+      }
+
+      if (offset > 0) {
+        // the ranges back a `Blob` instead of being concatenated into one
+        // contiguous copy of the upload
+        data.fetch.request.body = new Blob(chunks)
       }
     }
 
-    if (data.fetch.request.body) {
+    if (data.fetch.request.body && !(data.fetch.request.body instanceof Blob)) {
       data.fetch.request.body = new Uint8Array(data.fetch.request.body)
     }
 
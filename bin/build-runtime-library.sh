@@ -124,6 +124,7 @@ declare sources=(
   $(find "$root"/src/runtime/loop/*.cc)
   $(find "$root"/src/runtime/os/*.cc)
   $(find "$root"/src/runtime/platform/*.cc)
+  "$root/src/runtime/process/child.cc"
   $(find "$root"/src/runtime/serviceworker/*.cc)
   $(find "$root"/src/runtime/string/*.cc)
   $(find "$root"/src/runtime/udp/*.cc)
@@ -185,6 +185,74 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const void* data
   );
 
+  /**
+   * An opaque pointer for work queued with `sapi_context_queue_work()`.
+   */
+  typedef struct sapi_context_work sapi_context_work_t;
+
+  /**
+   * A callback given to `sapi_context_queue_work()` that is called on a
+   * worker thread. Long running work should check
+   * `sapi_context_work_cancelled()` and return early.
+   * @param work
+   * @param data
+   */
+  typedef void (*sapi_context_work_callback)(
+    sapi_context_work_t* work,
+    const void* data
+  );
+
+  /**
+   * A callback given to `sapi_context_queue_work()` that is called on the
+   * loop thread once the work is done or was cancelled.
+   * @param context
+   * @param data
+   * @param cancelled
+   */
+  typedef void (*sapi_context_after_work_callback)(
+    sapi_context_t* context,
+    const void* data,
+    bool cancelled
+  );
+
+  /**
+   * Queues `work` to be called on a worker thread for a `context`, so CPU
+   * heavy work does not block the loop. `after_work` is called on the loop
+   * thread when it is done. A retained `context` stays retained until
+   * `after_work` returns. The returned work is valid as long as `context` is.
+   * @param context    - An extension context
+   * @param data       - User data to be given to `work` and `after_work`
+   * @param work       - The callback called on a worker thread
+   * @param after_work - An optional callback called on the loop thread
+   * @return The queued work or `NULL`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  sapi_context_work_t* sapi_context_queue_work (
+    sapi_context_t* context,
+    const void* data,
+    sapi_context_work_callback work,
+    sapi_context_after_work_callback after_work
+  );
+
+  /**
+   * Cancels queued work. Work that has not started yet is not started,
+   * running work can observe it with `sapi_context_work_cancelled()`.
+   * `after_work` is called with `cancelled` set in either case. This
+   * function may be called from any thread.
+   * @param work - Work queued with `sapi_context_queue_work()`
+   * @return `true` if the work was not done yet, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_context_work_cancel (sapi_context_work_t* work);
+
+  /**
+   * Predicate to determine if work was cancelled.
+   * @param work - Work queued with `sapi_context_queue_work()`
+   * @return `true` if the work was cancelled, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_context_work_cancelled (const sapi_context_work_t* work);
+
   /**
    * Creates a new context. The context is retained if a `parent` is not given
    * and therefor emust be disposed with `sapi_context_release()`.
@@ -884,6 +952,35 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const sapi_ipc_router_t* router
   );
 
+  /**
+   * A callback called when the runtime is done with bytes it took
+   * ownership of through one of the `*_owned` IPC functions. It may be
+   * called on any thread.
+   * @param bytes - The bytes handed to the runtime
+   * @param data  - User data given with the bytes
+   */
+  typedef void (*sapi_ipc_bytes_free_callback_t)(
+    unsigned char* bytes,
+    void* data
+  );
+
+  /**
+   * Allocate `size` bytes that can be handed to the runtime with one of the
+   * `*_owned` IPC functions without being copied. Bytes that are not
+   * handed to the runtime must be released with `sapi_bytes_free()`.
+   * @param size - The number of bytes to allocate
+   * @return The allocated bytes or `NULL`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  unsigned char* sapi_bytes_alloc (unsigned int size);
+
+  /**
+   * Free bytes allocated with `sapi_bytes_alloc()`.
+   * @param bytes - The bytes to free
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  void sapi_bytes_free (unsigned char* bytes);
+
   /**
    * Get the window index the IPC message is associated with.
    * @param message The IPC message
@@ -1105,6 +1202,25 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     unsigned char* bytes
   );
 
+  /**
+   * Set the IPC result bytes without copying them. The runtime owns `bytes`
+   * after this call, even if it fails.
+   * @param result - An IPC request result
+   * @param size   - The size of the bytes
+   * @param bytes  - The bytes
+   * @param free   - Called to release `bytes`, `NULL` if they were
+   *                 allocated with `sapi_bytes_alloc()`
+   * @param data   - User data given to `free`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  void sapi_ipc_result_set_bytes_owned (
+    sapi_ipc_result_t* result,
+    unsigned int size,
+    unsigned char* bytes,
+    sapi_ipc_bytes_free_callback_t free,
+    void* data
+  );
+
   /**
    * Get the IPC result bytes.
    * @param result - An IPC request result
@@ -1229,6 +1345,22 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     void* data
   );
 
+  /**
+   * Sets the cancellation handler of an IPC route request to cancel `work`
+   * with `sapi_context_work_cancel()` if the HTTP request is aborted.
+   * The handler is cleared when the work is done, before `after_work` is
+   * called.
+   *
+   * @param result - An IPC request result
+   * @param work   - Work queued with `sapi_context_queue_work()`
+   * @return `true` if successful, `false` if the work is already done
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_set_work_cancellation_handler (
+    sapi_ipc_result_t* result,
+    sapi_context_work_t* work
+  );
+
   /**
    * Creates a "reply" for an IPC route request.
    * @param result - An IPC request result
@@ -1310,6 +1442,55 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     const char* headers
   );
 
+  /**
+   * Send bytes to the bridge to propagate to the WebView without copying
+   * them. The runtime owns `bytes` after this call, even if it fails.
+   * @param context - An extension context
+   * @param message - The IPC message this send request sources from
+   * @param size    - The size of the bytes
+   * @param bytes   - The bytes
+   * @param free    - Called to release `bytes`, `NULL` if they were
+   *                  allocated with `sapi_bytes_alloc()`
+   * @param data    - User data given to `free`
+   * @param headers - The response headers
+   * @return `true` if successful, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_send_bytes_owned (
+    sapi_context_t* context,
+    sapi_ipc_message_t* message,
+    unsigned int size,
+    unsigned char* bytes,
+    sapi_ipc_bytes_free_callback_t free,
+    void* data,
+    const char* headers
+  );
+
+  /**
+   * Send bytes to the bridge to propagate to the WebView with a result
+   * without copying them. The runtime owns `bytes` after this call, even
+   * if it fails.
+   * @param context - An extension context
+   * @param result  - The IPC request result
+   * @param size    - The size of the bytes
+   * @param bytes   - The bytes
+   * @param free    - Called to release `bytes`, `NULL` if they were
+   *                  allocated with `sapi_bytes_alloc()`
+   * @param data    - User data given to `free`
+   * @param headers - The response headers
+   * @return `true` if successful, otherwise `false`
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_send_bytes_with_result_owned (
+    sapi_context_t* context,
+    sapi_ipc_result_t* result,
+    unsigned int size,
+    unsigned char* bytes,
+    sapi_ipc_bytes_free_callback_t free,
+    void* data,
+    const char* headers
+  );
+
   /**
    * Emit IPC `event` with `data`
    * @param context - An extension context
@@ -1405,6 +1586,40 @@ SOCKET_RUNTIME_EXTENSION_EXTERN_BEGIN
     uint64_t token
   );
 
+  /**
+   * Counters for a mapped IPC route. Latencies are in microseconds, measured
+   * from the route being invoked until it replies, and percentiles are
+   * approximated to within 25%.
+   */
+  typedef struct sapi_ipc_router_stats {
+    uint64_t calls;
+    uint64_t replies;
+    uint64_t errors;
+    uint64_t bytes_in;
+    uint64_t bytes_out;
+    uint64_t latency_average;
+    uint64_t latency_p50;
+    uint64_t latency_p99;
+    uint64_t latency_max;
+  } sapi_ipc_router_stats_t;
+
+  /**
+   * Get the counters of a mapped route, built-in or from an extension.
+   * Counters are updated without locking and may be read from any thread.
+   * A route that replies several times, such as a chunked or event stream,
+   * counts one reply.
+   * @param context - An extension context
+   * @param route   - The route name to get counters for
+   * @param stats   - The counters to write to
+   * @return `true` if the route is mapped, otherwise `false`.
+   */
+  SOCKET_RUNTIME_EXTENSION_EXPORT
+  bool sapi_ipc_router_stats (
+    sapi_context_t* context,
+    const char* route,
+    sapi_ipc_router_stats_t* stats
+  );
+
 
   /**
    * Process API
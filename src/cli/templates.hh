@@ -1983,6 +1983,32 @@ service_worker_reload_timeout = 500
 ; default value: true
 ; allow_hotkeys = true
 
+; Run core services on dedicated event loops, each with a thread of its own.
+; Services given the same loop name share a loop. Services not listed here,
+; or given the loop name "main", run on the main runtime loop.
+; Supported services: conduit, dns, fs, process, udp
+[runtime.loops]
+
+; The loop the conduit (WebSocket) service runs on.
+; default value: "main"
+; conduit = "network"
+
+; The loop the DNS lookup service runs on.
+; default value: "main"
+; dns = "network"
+
+; The loop the file system service runs on.
+; default value: "main"
+; fs = "disk"
+
+; The loop the child process service runs on.
+; default value: "main"
+; process = "disk"
+
+; The loop the UDP socket service runs on.
+; default value: "main"
+; udp = "network"
+
 [debug]
 
 ; Advanced Compiler Settings for debug purposes (ie C++ compiler -g, etc).
@@ -4,7 +4,7 @@ sapi_context_t* sapi_context_create (
   sapi_context_t* parent,
   bool retained
 ) {
-  if (parent && !parent->isAllowed("context_create")) {
+  if (parent && !parent->isAllowed(sapi_context_t::Capability::ContextCreate)) {
     sapi_debug(parent, "'context_create' is not allowed.");
     return nullptr;
   }
@@ -38,7 +38,7 @@ bool sapi_context_dispatch (
   if (ctx == nullptr) return false;
   if (ctx->router == nullptr) return false;
 
-  if (!ctx->isAllowed("context_dispatch")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextDispatch)) {
     sapi_debug(ctx, "'context_dispatch' is not allowed.");
     return false;
   }
@@ -48,9 +48,121 @@ bool sapi_context_dispatch (
   });
 }
 
+sapi_context_work_t* sapi_context_queue_work (
+  sapi_context_t* ctx,
+  const void* data,
+  sapi_context_work_callback work,
+  sapi_context_after_work_callback after_work
+) {
+  if (ctx == nullptr || work == nullptr) return nullptr;
+  if (ctx->router == nullptr) return nullptr;
+
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextQueueWork)) {
+    sapi_debug(ctx, "'context_queue_work' is not allowed.");
+    return nullptr;
+  }
+
+  auto request = ctx->memory.alloc<sapi_context_work_t>(ctx);
+  request->data = data;
+  request->work = work;
+  request->after_work = after_work;
+  request->retained = ctx->retain_count > 0;
+
+  // released when `after_work` returned, so the context outlives the work
+  if (request->retained) {
+    ctx->retain();
+  }
+
+  auto& loop = ctx->router->bridge.context.loop;
+  // `uv_queue_work()` must be called on the loop thread
+  const auto queued = loop.handoff([request, &loop]() {
+    const auto err = uv_queue_work(
+      loop.get(),
+      &request->req,
+      [](uv_work_t* req) {
+        auto request = reinterpret_cast<sapi_context_work_t*>(req->data);
+        request->state = sapi_context_work_t::State::Running;
+
+        if (!request->cancelled) {
+          request->work(request, request->data);
+        }
+      },
+      [](uv_work_t* req, int status) {
+        auto request = reinterpret_cast<sapi_context_work_t*>(req->data);
+        auto context = request->context;
+        const auto retained = request->retained;
+
+        request->done();
+
+        if (request->after_work != nullptr) {
+          const auto cancelled = status == UV_ECANCELED || request->cancelled;
+          request->after_work(context, request->data, cancelled);
+        }
+
+        // `request` is owned by `context` and may be gone from here on
+        if (retained && context->release()) {
+          delete context;
+        }
+      }
+    );
+
+    if (err == 0) {
+      // unless the work already started on the threadpool
+      auto pending = sapi_context_work_t::State::Pending;
+      request->state.compare_exchange_strong(pending, sapi_context_work_t::State::Queued);
+    } else {
+      auto context = request->context;
+      request->done();
+      sapi_debug(context, "'context_queue_work' failed to queue work.");
+
+      if (request->after_work != nullptr) {
+        request->after_work(context, request->data, true);
+      }
+
+      if (request->retained && context->release()) {
+        delete context;
+      }
+    }
+  });
+
+  if (!queued) {
+    request->state = sapi_context_work_t::State::Done;
+
+    if (request->retained) {
+      ctx->release();
+    }
+
+    return nullptr;
+  }
+
+  return request;
+}
+
+bool sapi_context_work_cancel (sapi_context_work_t* work) {
+  if (work == nullptr) return false;
+  if (work->state == sapi_context_work_t::State::Done) return false;
+  work->cancelled = true;
+
+  // work that has not started is taken off the threadpool queue. On other
+  // threads the flag is enough, queued work is skipped when it starts and
+  // `work` may be gone before anything dispatched to the loop runs
+  if (
+    work->state == sapi_context_work_t::State::Queued &&
+    work->context->router->bridge.context.loop.isCurrentThread()
+  ) {
+    uv_cancel(reinterpret_cast<uv_req_t*>(&work->req));
+  }
+
+  return true;
+}
+
+bool sapi_context_work_cancelled (const sapi_context_work_t* work) {
+  return work != nullptr && work->cancelled;
+}
+
 void sapi_context_retain (sapi_context_t* ctx) {
   if (ctx == nullptr) return;
-  if (!ctx->isAllowed("context_retain")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextRetain)) {
     sapi_debug(ctx, "'context_retain' is not allowed.");
     return;
   }
@@ -65,7 +177,7 @@ bool sapi_context_retained (const sapi_context_t* ctx) {
 
 void sapi_context_release (sapi_context_t* ctx) {
   if (ctx == nullptr) return;
-  if (!ctx->isAllowed("context_release")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextRelease)) {
     sapi_debug(ctx, "'context_release' is not allowed.");
     return;
   }
@@ -77,7 +189,7 @@ void sapi_context_release (sapi_context_t* ctx) {
 uv_loop_t* sapi_context_get_loop (const sapi_context_t* ctx) {
   if (ctx == nullptr) return nullptr;
   if (ctx->router == nullptr) return nullptr;
-  if (!ctx->isAllowed("context_get_loop")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextGetLoop)) {
     sapi_debug(ctx, "'context_get_loop' is not allowed.");
     return nullptr;
   }
@@ -88,7 +200,7 @@ uv_loop_t* sapi_context_get_loop (const sapi_context_t* ctx) {
 const sapi_ipc_router_t* sapi_context_get_router (const sapi_context_t* ctx) {
   if (ctx == nullptr) return nullptr;
   if (ctx->router == nullptr) return nullptr;
-  if (!ctx->isAllowed("context_get_router")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ContextGetRouter)) {
     sapi_debug(ctx, "'context_get_router' is not allowed.");
     return nullptr;
   }
@@ -190,5 +302,8 @@ void* sapi_context_alloc (sapi_context_t* context, unsigned int size) {
     return nullptr;
   }
 
-  return reinterpret_cast<void*>(context->memory.alloc<unsigned char>(size));
+  // `size_t`, an `unsigned int` would select the constructor overload
+  return reinterpret_cast<void*>(
+    context->memory.alloc<unsigned char>(static_cast<size_t>(size))
+  );
 }
@@ -8,7 +8,7 @@ const char* sapi_env_get (
   const char* name
 ) {
   if (ctx == nullptr || name == nullptr)  return nullptr;
-  if (!ctx->isAllowed("env_get")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::EnvGet)) {
     sapi_debug(ctx, "'env_get' is not allowed.");
     return nullptr;
   }
@@ -30,7 +30,7 @@ const char* sapi_env_get (
     return nullptr;
   }
 
-  auto pointer = ctx->memory.alloc<char>(value.size());
+  auto pointer = ctx->memory.alloc<char>(value.size() + 1);
   return reinterpret_cast<const char*>(
     memcpy(pointer, value.c_str(), value.size())
   );
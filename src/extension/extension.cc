@@ -77,6 +77,7 @@ namespace ssc::extension {
     this->config = extension->context.config;
     this->data = extension->context.data;
     this->policies = extension->context.policies;
+    this->capabilities = extension->context.capabilities;
   }
 
   Extension::Context::Context (const Context& context) {
@@ -85,6 +86,7 @@ namespace ssc::extension {
     this->config = context.config;
     this->data = context.data;
     this->policies = context.policies;
+    this->capabilities = context.capabilities;
     this->internal = context.internal;
   }
 
@@ -95,6 +97,7 @@ namespace ssc::extension {
       this->config = context->config;
       this->data = context->data;
       this->policies = context->policies;
+      this->capabilities = context->capabilities;
       this->internal = context->internal;
     }
   }
@@ -108,6 +111,7 @@ namespace ssc::extension {
       this->config = context.config;
       this->data = context.data;
       this->policies = context.policies;
+      this->capabilities = context.capabilities;
       this->internal = context.internal;
     }
 
@@ -137,13 +141,8 @@ namespace ssc::extension {
 
   void Extension::Context::setPolicy (const String& name, bool allowed) {
     if (name.size() == 0) return;
-    if (this->hasPolicy(name)) {
-      auto policy = this->getPolicy(name);
-      policy.allowed = allowed;
-      policy.name = name;
-    } else {
-      this->policies.insert_or_assign(name, Policy { name, allowed });
-    }
+    this->policies.insert_or_assign(name, Policy { name, allowed });
+    this->compilePolicies();
   }
 
   const Extension::Context::Policy& Extension::Context::getPolicy (
@@ -178,19 +177,104 @@ namespace ssc::extension {
     return false;
   }
 
+  const char* Extension::Context::getCapabilityName (Capability capability) {
+    switch (capability) {
+      case Capability::ContextCreate: return "context_create";
+      case Capability::ContextDispatch: return "context_dispatch";
+      case Capability::ContextRetain: return "context_retain";
+      case Capability::ContextRelease: return "context_release";
+      case Capability::ContextGetLoop: return "context_get_loop";
+      case Capability::ContextGetRouter: return "context_get_router";
+      case Capability::ContextQueueWork: return "context_queue_work";
+      case Capability::EnvGet: return "env_get";
+      case Capability::IPCRouterMap: return "ipc_router_map";
+      case Capability::IPCRouterUnmap: return "ipc_router_unmap";
+      case Capability::IPCRouterListen: return "ipc_router_listen";
+      case Capability::IPCRouterUnlisten: return "ipc_router_unlisten";
+      case Capability::IPCRouterReply: return "ipc_router_reply";
+      case Capability::IPCRouterStats: return "ipc_router_stats";
+      case Capability::JavaScriptEvaluate: return "javascript_evaluate";
+      case Capability::ProcessExec: return "process_exec";
+      case Capability::Count: break;
+    }
+
+    return "";
+  }
+
+  // resolves every capability against the policies once, so checks on the
+  // hot sapi paths are a single bit test instead of string matching
+  void Extension::Context::compilePolicies () {
+    if (this->policies.size() == 0) {
+      this->capabilities.set();
+      return;
+    }
+
+    this->capabilities.reset();
+
+    for (size_t i = 0; i < this->capabilities.size(); ++i) {
+      const auto name = getCapabilityName(static_cast<Capability>(i));
+      this->capabilities.set(i, this->isAllowed(String(name)));
+    }
+  }
+
   Extension::Context::Memory::~Memory () {
     this->release();
   }
 
   void Extension::Context::Memory::release () {
     Lock lock(this->mutex);
-    if (this->pool.size() > 0) {
-      for (const auto& releaseCallback: this->pool) {
-        releaseCallback();
+
+    // in reverse, objects are destroyed before what they were built from
+    for (auto finalizer = this->finalizers.rbegin(); finalizer != this->finalizers.rend(); ++finalizer) {
+      finalizer->callback(finalizer->pointer);
+    }
+
+    for (const auto& chunk : this->chunks) {
+      delete [] chunk.bytes;
+    }
+
+    this->finalizers.clear();
+    this->chunks.clear();
+  }
+
+  void* Extension::Context::Memory::allocate (size_t size, size_t alignment) {
+    Lock lock(this->mutex);
+
+    alignment = std::max(alignment, ALIGNMENT);
+    size = std::max(size, size_t(1));
+
+    // the aligned address for `size` bytes in `chunk`, if they fit
+    const auto bump = [size, alignment](Chunk& chunk) -> void* {
+      const auto start = reinterpret_cast<uintptr_t>(chunk.bytes);
+      const auto address = (start + chunk.offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+
+      if (address + size > start + chunk.size) {
+        return nullptr;
       }
 
-      this->pool.clear();
+      chunk.offset = address + size - start;
+      return reinterpret_cast<void*>(address);
+    };
+
+    if (this->chunks.size() > 0) {
+      if (auto pointer = bump(this->chunks.back())) {
+        return pointer;
+      }
     }
+
+    // chunks grow with the number of allocations, large allocations get
+    // a chunk of their own
+    const auto next = this->chunks.size() > 0
+      ? std::min(this->chunks.back().size * 2, MAX_CHUNK_SIZE)
+      : CHUNK_SIZE;
+
+    this->chunks.push_back(Chunk {
+      new unsigned char[std::max(next, size + alignment)],
+      std::max(next, size + alignment),
+      0
+    });
+
+    return bump(this->chunks.back());
   }
 
   String Extension::getExtensionsDirectory (const String& name) {
@@ -202,9 +286,9 @@ namespace ssc::extension {
   #endif
   }
 
-  void Extension::Context::Memory::push (Function<void()> callback) {
+  void Extension::Context::Memory::finalize (void (*callback)(void*), void* pointer) {
     Lock lock(this->mutex);
-    this->pool.push_back(callback);
+    this->finalizers.push_back(Finalizer { callback, pointer });
   }
 
   Extension::Extension (const String& name, const Initializer initializer)
@@ -1,6 +1,8 @@
 #ifndef SOCKET_RUNTIME_EXTENSION_EXTENSION_H
 #define SOCKET_RUNTIME_EXTENSION_EXTENSION_H
 
+#include <bitset>
+
 #include "../runtime.hh"
 
 #if SOCKET_RUNTIME_PLATFORM_WINDOWS
@@ -40,32 +42,106 @@ namespace ssc::extension {
           {}
         };
 
+        /**
+         * The sapi functions guarded by a policy. A policy allows every
+         * capability its name is a prefix of, so `ipc` allows all of the
+         * `ipc_router_*` capabilities.
+         */
+        enum class Capability : uint8_t {
+          ContextCreate,
+          ContextDispatch,
+          ContextRetain,
+          ContextRelease,
+          ContextGetLoop,
+          ContextGetRouter,
+          ContextQueueWork,
+          EnvGet,
+          IPCRouterMap,
+          IPCRouterUnmap,
+          IPCRouterListen,
+          IPCRouterUnlisten,
+          IPCRouterReply,
+          IPCRouterStats,
+          JavaScriptEvaluate,
+          ProcessExec,
+          Count
+        };
+
+        // compiled from `policies` when they change, all set without any
+        using Capabilities = std::bitset<static_cast<size_t>(Capability::Count)>;
+
+        static const char* getCapabilityName (Capability capability);
+
+        /**
+         * An arena for the memory handed out to an extension through a
+         * context. Allocations are bumped out of chunks and released all
+         * at once, destructors only run for types that need them.
+         */
         struct Memory {
-          std::vector<std::function<void()>> pool;
+          static constexpr size_t CHUNK_SIZE = 4 * 1024;
+          static constexpr size_t MAX_CHUNK_SIZE = 64 * 1024;
+          // `sapi_context_alloc()` memory may hold any type
+          static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+          struct Chunk {
+            unsigned char* bytes = nullptr;
+            size_t size = 0;
+            size_t offset = 0;
+          };
+
+          struct Finalizer {
+            void (*callback)(void*);
+            void* pointer;
+          };
+
+          Vector<Chunk> chunks;
+          Vector<Finalizer> finalizers;
           Mutex mutex;
 
+          Memory () = default;
+          Memory (const Memory&) = delete;
+          Memory& operator = (const Memory&) = delete;
           ~Memory ();
+
           void release ();
-          void push (std::function<void()> callback);
+          void* allocate (size_t size, size_t alignment = ALIGNMENT);
+          void finalize (void (*callback)(void*), void* pointer);
+
+          template <typename T> void finalize (T* memory) {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+              this->finalize([](void* pointer) {
+                reinterpret_cast<T*>(pointer)->~T();
+              }, memory);
+            }
+          }
+
           template <typename T, typename C, typename... Args> T* alloc (
             C* ctx,
             Args... args
           ) {
-            auto memory = new T(args...);
+            auto memory = new (this->allocate(sizeof(T), alignof(T))) T(args...);
             memory->context = ctx;
-            push([memory]() { delete memory; });
+            this->finalize(memory);
             return memory;
           }
 
           template <typename T, typename... Args> T* alloc (Args... args) {
-            auto memory = new T(args...);
-            push([memory]() { delete memory; });
+            auto memory = new (this->allocate(sizeof(T), alignof(T))) T(args...);
+            this->finalize(memory);
             return memory;
           }
 
           template <typename T> T* alloc (size_t size) {
-            auto memory = new T[size]{0};
-            push([memory]() { delete [] memory; });
+            auto memory = reinterpret_cast<T*>(this->allocate(sizeof(T) * size, alignof(T)));
+
+            if constexpr (std::is_trivial_v<T>) {
+              memset(memory, 0, sizeof(T) * size);
+            } else {
+              for (size_t i = 0; i < size; ++i) {
+                this->finalize(new (memory + i) T{});
+              }
+            }
+
             return memory;
           }
         };
@@ -83,6 +159,7 @@ namespace ssc::extension {
         Error error;
         std::atomic<unsigned int> retain_count = 0;
         PolicyMap policies;
+        Capabilities capabilities = Capabilities().set();
         Map<String, String> config;
 
         Context () = default;
@@ -99,6 +176,13 @@ namespace ssc::extension {
         const Policy& getPolicy (const String& name) const;
         bool hasPolicy (const String& name) const;
         bool isAllowed (const String& name) const;
+
+        inline bool isAllowed (Capability capability) const {
+          return this->capabilities.test(static_cast<size_t>(capability));
+        }
+
+      private:
+        void compilePolicies ();
       };
 
       using Map = Map<String, SharedPointer<Extension>>;
@@ -169,6 +253,44 @@ extern "C" {
     {}
   };
 
+  struct sapi_context_work {
+    enum class State {
+      Pending, // not handed to the threadpool yet
+      Queued,
+      Running,
+      Done
+    };
+
+    uv_work_t req;
+    sapi_context_t* context = nullptr;
+    const void* data = nullptr;
+    sapi_context_work_callback work = nullptr;
+    sapi_context_after_work_callback after_work = nullptr;
+    std::atomic<State> state = State::Pending;
+    std::atomic<bool> cancelled = false;
+    // `true` if `context` was retained when the work was queued
+    bool retained = false;
+    // set by `sapi_ipc_set_work_cancellation_handler()`, guarded by `mutex`
+    ssc::runtime::SharedPointer<ssc::runtime::ipc::MessageCancellation> cancellation = nullptr;
+    ssc::runtime::Mutex mutex;
+
+    sapi_context_work () {
+      this->req.data = this;
+    }
+
+    // marks the work done and clears its cancellation handler, so an abort
+    // arriving later does not reach `this`
+    void done () {
+      ssc::runtime::Lock lock(this->mutex);
+      this->state = State::Done;
+
+      if (this->cancellation != nullptr) {
+        this->cancellation->reset(this);
+        this->cancellation = nullptr;
+      }
+    }
+  };
+
   struct sapi_process_exec : public ssc::runtime::process::ExecOutput {
     sapi_context_t* context = nullptr;
     sapi_process_exec () = default;
@@ -14,7 +14,7 @@ bool sapi_ipc_router_map (
     return false;
   }
 
-  if (!ctx->isAllowed("ipc_router_map")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::IPCRouterMap)) {
     sapi_debug(ctx, "'ipc_router_map' is not allowed.");
     return false;
   }
@@ -46,7 +46,7 @@ bool sapi_ipc_router_unmap (sapi_context_t* ctx, const char* name) {
     return false;
   }
 
-  if (!ctx->isAllowed("ipc_router_unmap")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::IPCRouterUnmap)) {
     sapi_debug(ctx, "'ipc_router_unmap' is not allowed.");
     return false;
   }
@@ -66,7 +66,7 @@ uint64_t sapi_ipc_router_listen (
     return 0;
   }
 
-  if (!ctx->isAllowed("ipc_router_listen")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::IPCRouterListen)) {
     sapi_debug(ctx, "'ipc_router_listen' is not allowed.");
     return 0;
   }
@@ -96,7 +96,7 @@ bool sapi_ipc_router_unlisten (
     return false;
   }
 
-  if (!ctx->isAllowed("ipc_router_unlisten")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::IPCRouterUnlisten)) {
     sapi_debug(ctx, "'ipc_router_unlisten' is not allowed.");
     return false;
   }
@@ -104,6 +104,43 @@ bool sapi_ipc_router_unlisten (
   return ctx->router->unlisten(name, token);
 }
 
+bool sapi_ipc_router_stats (
+  sapi_context_t* ctx,
+  const char* name,
+  sapi_ipc_router_stats_t* stats
+) {
+  if (
+    ctx == nullptr ||
+    ctx->router == nullptr ||
+    name == nullptr ||
+    stats == nullptr
+  ) {
+    return false;
+  }
+
+  if (!ctx->isAllowed(sapi_context_t::Capability::IPCRouterStats)) {
+    sapi_debug(ctx, "'ipc_router_stats' is not allowed.");
+    return false;
+  }
+
+  ssc::runtime::ipc::Router::RouteStats::Snapshot snapshot;
+
+  if (!ctx->router->stats(name, snapshot)) {
+    return false;
+  }
+
+  stats->calls = snapshot.calls;
+  stats->replies = snapshot.replies;
+  stats->errors = snapshot.errors;
+  stats->bytes_in = snapshot.bytesIn;
+  stats->bytes_out = snapshot.bytesOut;
+  stats->latency_average = snapshot.averageLatency;
+  stats->latency_p50 = snapshot.p50;
+  stats->latency_p99 = snapshot.p99;
+  stats->latency_max = snapshot.maxLatency;
+  return true;
+}
+
 bool sapi_ipc_reply_with_error (sapi_ipc_result_t* result, const char* error) {
   sapi_context* context = sapi_ipc_result_get_context(result);
   sapi_json_string* errorJson = sapi_json_string_create(context, error);
@@ -117,7 +154,7 @@ bool sapi_ipc_reply (const sapi_ipc_result_t* result) {
   if (result == nullptr) return false;
   if (result->context == nullptr) return false;
 
-  if (!result->context->isAllowed("ipc_router_reply")) {
+  if (!result->context->isAllowed(sapi_context_t::Capability::IPCRouterReply)) {
     sapi_debug(result->context, "'ipc_router_reply' is not allowed.");
     return 0;
   }
@@ -149,11 +186,30 @@ bool sapi_ipc_set_cancellation_handler (
   if (result == nullptr || result->message.cancel == nullptr) {
     return false;
   }
-  auto message = result->message;
-  *message.cancel = {
-    .handler = handler,
-    .data = data
-  };
+  result->message.cancel->set(handler, data);
+  return true;
+}
+
+bool sapi_ipc_set_work_cancellation_handler (
+  sapi_ipc_result_t* result,
+  sapi_context_work_t* work
+) {
+  if (work == nullptr || result == nullptr || result->message.cancel == nullptr) {
+    return false;
+  }
+
+  ssc::runtime::Lock lock(work->mutex);
+  // `work` is done and may be gone by the time an abort arrives
+  if (work->state == sapi_context_work_t::State::Done) {
+    return false;
+  }
+
+  // cleared by the work completion before `work` is released
+  work->cancellation = result->message.cancel;
+  work->cancellation->set([](void* work) {
+    sapi_context_work_cancel(reinterpret_cast<sapi_context_work_t*>(work));
+  }, work);
+
   return true;
 }
 
@@ -219,30 +275,51 @@ bool sapi_ipc_send_event (
   return success;
 }
 
-bool sapi_ipc_send_bytes (
+// wraps `bytes` so they are released by `free` (or `delete []` for
+// `sapi_bytes_alloc()` memory) when the last response referencing them is
+// done with them
+static ssc::runtime::SharedPointer<unsigned char[]> adoptBytes (
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t free,
+  void* data
+) {
+  if (bytes == nullptr) {
+    return nullptr;
+  }
+
+  if (free == nullptr) {
+    return ssc::runtime::SharedPointer<unsigned char[]>(bytes);
+  }
+
+  return ssc::runtime::SharedPointer<unsigned char[]>(bytes, [free, data](auto bytes) {
+    free(bytes, data);
+  });
+}
+
+static ssc::runtime::SharedPointer<unsigned char[]> copyBytes (
+  const unsigned char* bytes,
+  unsigned int size
+) {
+  auto body = std::make_shared<unsigned char[]>(size);
+  memcpy(body.get(), bytes, size);
+  return body;
+}
+
+static bool sendBytes (
   sapi_context_t* ctx,
   sapi_ipc_message_t* message,
   unsigned int size,
-  unsigned char* bytes,
+  ssc::runtime::SharedPointer<unsigned char[]> body,
   const char* headers
 ) {
-  if (!ctx || !ctx->router || !bytes || !size) {
-    return false;
-  }
-
   auto queuedResponse = ssc::runtime::QueuedResponse {
     .id = 0,
     .ttl = 0,
-    .body = nullptr,
+    .body = body,
     .length = size,
     .headers = ssc::runtime::String(headers ? headers : "")
   };
 
-  if (bytes != nullptr && size > 0) {
-    queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(queuedResponse.body.get(), bytes, size);
-  }
-
   if (message) {
     auto result = ssc::runtime::ipc::Result(
       message->seq,
@@ -258,31 +335,99 @@ bool sapi_ipc_send_bytes (
   return ctx->router->bridge.send(result.seq, result.str(), queuedResponse);
 }
 
-bool sapi_ipc_send_bytes_with_result (
+static bool sendBytesWithResult (
   sapi_context_t* ctx,
   sapi_ipc_result_t* result,
   unsigned int size,
-  unsigned char* bytes,
+  ssc::runtime::SharedPointer<unsigned char[]> body,
   const char* headers
 ) {
-  if (!ctx || !ctx->router || !bytes || !size || !result) {
-    return false;
-  }
-
   auto queuedResponse = ssc::runtime::QueuedResponse {
     .id = 0,
     .ttl = 0,
-    .body = nullptr,
+    .body = body,
     .length = size,
     .headers = ssc::runtime::String(headers ? headers : "")
   };
 
-  if (bytes != nullptr && size > 0) {
-    queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(queuedResponse.body.get(), bytes, size);
+  return ctx->router->bridge.send(result->seq, result->str(), queuedResponse);
+}
+
+unsigned char* sapi_bytes_alloc (unsigned int size) {
+  if (size == 0) {
+    return nullptr;
   }
 
-  return ctx->router->bridge.send(result->seq, result->str(), queuedResponse);
+  return new (std::nothrow) unsigned char[size];
+}
+
+void sapi_bytes_free (unsigned char* bytes) {
+  delete [] bytes;
+}
+
+bool sapi_ipc_send_bytes (
+  sapi_context_t* ctx,
+  sapi_ipc_message_t* message,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers
+) {
+  if (!ctx || !ctx->router || !bytes || !size) {
+    return false;
+  }
+
+  return sendBytes(ctx, message, size, copyBytes(bytes, size), headers);
+}
+
+bool sapi_ipc_send_bytes_owned (
+  sapi_context_t* ctx,
+  sapi_ipc_message_t* message,
+  unsigned int size,
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t free,
+  void* data,
+  const char* headers
+) {
+  // owned from here on, released when this returns if not sent
+  auto body = adoptBytes(bytes, free, data);
+
+  if (!ctx || !ctx->router || !bytes || !size) {
+    return false;
+  }
+
+  return sendBytes(ctx, message, size, body, headers);
+}
+
+bool sapi_ipc_send_bytes_with_result (
+  sapi_context_t* ctx,
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  const char* headers
+) {
+  if (!ctx || !ctx->router || !bytes || !size || !result) {
+    return false;
+  }
+
+  return sendBytesWithResult(ctx, result, size, copyBytes(bytes, size), headers);
+}
+
+bool sapi_ipc_send_bytes_with_result_owned (
+  sapi_context_t* ctx,
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t free,
+  void* data,
+  const char* headers
+) {
+  auto body = adoptBytes(bytes, free, data);
+
+  if (!ctx || !ctx->router || !bytes || !size || !result) {
+    return false;
+  }
+
+  return sendBytesWithResult(ctx, result, size, body, headers);
 }
 
 bool sapi_ipc_send_json (
@@ -665,8 +810,22 @@ void sapi_ipc_result_set_bytes (
 ) {
   if (result && size && bytes) {
     result->queuedResponse.length = size;
-    result->queuedResponse.body = std::make_shared<unsigned char[]>(size);
-    memcpy(result->queuedResponse.body.get(), bytes, size);
+    result->queuedResponse.body = copyBytes(bytes, size);
+  }
+}
+
+void sapi_ipc_result_set_bytes_owned (
+  sapi_ipc_result_t* result,
+  unsigned int size,
+  unsigned char* bytes,
+  sapi_ipc_bytes_free_callback_t free,
+  void* data
+) {
+  auto body = adoptBytes(bytes, free, data);
+
+  if (result && size && bytes) {
+    result->queuedResponse.length = size;
+    result->queuedResponse.body = body;
   }
 }
 
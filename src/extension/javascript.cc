@@ -6,7 +6,7 @@ void sapi_javascript_evaluate (
   const char* source
 ) {
   if (ctx == nullptr || name == nullptr || source == nullptr) return;
-  if (!ctx->isAllowed("javascript_evaluate")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::JavaScriptEvaluate)) {
     sapi_debug(ctx, "'javascript_evaluate' is not allowed.");
     return;
   }
@@ -16,7 +16,7 @@ const sapi_process_exec_t* sapi_process_exec (
 #else
 
   if (ctx == nullptr) return nullptr;
-  if (!ctx->isAllowed("process_exec")) {
+  if (!ctx->isAllowed(sapi_context_t::Capability::ProcessExec)) {
     sapi_debug(ctx, "'process_exec' is not allowed.");
     return nullptr;
   }
@@ -100,6 +100,44 @@ export * from '{{url}}'
     "worker_threads"
   };
 
+  // writes service worker response body chunks to a scheme handler response
+  // as the worker produces them, the head is written with the first chunk
+  // and hands the response to the webview so it reads the body as it arrives
+  static serviceworker::Fetch::StreamCallback createServiceWorkerFetchStream (
+    SharedPointer<SchemeHandlers::Request> request,
+    SharedPointer<SchemeHandlers::Response> response,
+    bool streamNotFoundResponses = true
+  ) {
+    return [request, response, streamNotFoundResponses] (const auto& res, const auto& buffer) mutable {
+      if (!request->isActive() || res.statusCode == 0) {
+        return false;
+      }
+
+      if (!response->platformResponse) {
+        if (res.statusCode == 404 && !streamNotFoundResponses) {
+          return false;
+        }
+
+        response->streamed = true;
+        if (!response->writeHead(res.statusCode, res.headers)) {
+          return false;
+        }
+      }
+
+      return response->write(buffer);
+    };
+  }
+
+  // defers the worker's next response body chunk until the webview has
+  // read enough of the streamed response body
+  static serviceworker::Fetch::DrainCallback createServiceWorkerFetchDrain (
+    SharedPointer<SchemeHandlers::Response> response
+  ) {
+    return [response] (const auto callback) {
+      response->drain(callback);
+    };
+  }
+
   Bridge::Bridge (
     const Options& options
   ) : window::IBridge(options.dispatcher, options.context, options.client, options.userConfig),
@@ -310,9 +348,7 @@ export * from '{{url}}'
       message.cancel = std::make_shared<ipc::MessageCancellation>();
 
       callbacks->cancel = [message] () {
-        if (message.cancel->handler != nullptr) {
-          message.cancel->handler(message.cancel->data);
-        }
+        message.cancel->cancel();
       };
 
       const auto size = request->body.size();
@@ -339,9 +375,7 @@ export * from '{{url}}'
             }
 
             if (request->isCancelled()) {
-              if (message.cancel->handler != nullptr) {
-                message.cancel->handler(message.cancel->data);
-              }
+              message.cancel->cancel();
               return false;
             }
 
@@ -377,9 +411,7 @@ export * from '{{url}}'
             }
 
             if (request->isCancelled()) {
-              if (message.cancel->handler != nullptr) {
-                message.cancel->handler(message.cancel->data);
-              }
+              message.cancel->cancel();
               return false;
             }
 
@@ -497,16 +529,26 @@ export * from '{{url}}'
           }
 
           const auto app = App::sharedApplication();
-          const auto options = serviceworker::Fetch::Options { request->client };
+          // a '404' from the worker falls back to the application resources
+          // below, so it is never streamed
+          auto streamedResponse = std::make_shared<SchemeHandlers::Response>(request, 404);
+          const auto options = serviceworker::Fetch::Options {
+            .client = request->client,
+            .stream = createServiceWorkerFetchStream(request, streamedResponse, false),
+            .drain = createServiceWorkerFetchDrain(streamedResponse)
+          };
+
           const auto fetched = serviceWorker->fetch(fetch, options, [=, this] (auto res) mutable {
             if (!request ||  !request->isActive()) {
               return;
             }
 
-            auto response = SchemeHandlers::Response(request, 404);
+            auto& response = *streamedResponse;
 
             if (res.statusCode == 0) {
               response.fail("ServiceWorker request failed");
+            } else if (response.platformResponse) {
+              // the response body was streamed
             } else if (res.statusCode != 404) {
               response.writeHead(res.statusCode, res.headers);
               response.write(res.body.buffer);
@@ -570,6 +612,7 @@ export * from '{{url}}'
                   if (request->method == "HEAD") {
                     const auto contentType = resource.mimeType();
                     const auto contentLength = resource.size();
+                    const auto validators = resource.validators();
 
                     if (contentType.size() > 0) {
                       response.setHeader("content-type", contentType);
@@ -579,6 +622,16 @@ export * from '{{url}}'
                       response.setHeader("content-length", contentLength);
                     }
 
+                    response.setHeader("accept-ranges", "bytes");
+
+                    if (validators.etag.size() > 0) {
+                      response.setHeader("etag", validators.etag);
+                    }
+
+                    if (validators.lastModified > 0) {
+                      response.setHeader("last-modified", http::formatDate(validators.lastModified));
+                    }
+
                     response.writeHead(200);
                   }
 
@@ -593,7 +646,7 @@ export * from '{{url}}'
                     } else {
                       const auto html = request->headers["runtime-preload-injection"] == "disabled"
                         ? resource.str()
-                        : this->client.preload.insertIntoHTML(resource.str(), {
+                        : this->client.preload.insertIntoHTML(resource, {
                             .protocolHandlerSchemes = serviceWorker->container.protocols.getSchemes()
                           });
 
@@ -618,8 +671,11 @@ export * from '{{url}}'
           });
 
           if (fetched) {
-             this->getRuntime()->services.timers.setTimeout(32000, [request] () mutable {
-               if (request->isActive()) {
+            // the fetch holds the request body now
+            request->body = bytes::Buffer();
+             this->getRuntime()->services.timers.setTimeout(32000, [request, streamedResponse] () mutable {
+               // a response that started streaming is not timed out
+               if (request->isActive() && !streamedResponse->platformResponse) {
                  auto response = SchemeHandlers::Response(request, 408);
                  response.fail("ServiceWorker request timed out.");
                }
@@ -691,6 +747,7 @@ export * from '{{url}}'
               if (request->method == "HEAD") {
                 const auto contentType = resource.mimeType();
                 const auto contentLength = resource.size();
+                const auto validators = resource.validators();
 
                 if (contentType.size() > 0) {
                   response.setHeader("content-type", contentType);
@@ -700,6 +757,16 @@ export * from '{{url}}'
                   response.setHeader("content-length", contentLength);
                 }
 
+                response.setHeader("accept-ranges", "bytes");
+
+                if (validators.etag.size() > 0) {
+                  response.setHeader("etag", validators.etag);
+                }
+
+                if (validators.lastModified > 0) {
+                  response.setHeader("last-modified", http::formatDate(validators.lastModified));
+                }
+
                 response.writeHead(200);
               }
 
@@ -714,7 +781,7 @@ export * from '{{url}}'
                 } else {
                   const auto html = request->headers["runtime-preload-injection"] == "disabled"
                     ? resource.str()
-                    : this->client.preload.insertIntoHTML(resource.str(), {
+                    : this->client.preload.insertIntoHTML(resource, {
                         .protocolHandlerSchemes = serviceWorker
                           ? serviceWorker->container.protocols.getSchemes()
                           : Vector<String>()
@@ -754,17 +821,22 @@ export * from '{{url}}'
             fetch.headers.set("origin", this->navigator.location.origin);
           }
 
-          const auto options = serviceworker::Fetch::Options { request->client };
-          const auto fetched = serviceWorker->fetch(fetch, options, [request, callback] (auto res) mutable {
+          auto streamedResponse = std::make_shared<SchemeHandlers::Response>(request, 404);
+          const auto options = serviceworker::Fetch::Options {
+            .client = request->client,
+            .stream = createServiceWorkerFetchStream(request, streamedResponse),
+            .drain = createServiceWorkerFetchDrain(streamedResponse)
+          };
+
+          const auto fetched = serviceWorker->fetch(fetch, options, [request, callback, streamedResponse] (auto res) mutable {
             if (!request->isActive()) {
               return;
             }
 
-            auto response = SchemeHandlers::Response(request, 404);
-
+            auto& response = *streamedResponse;
             if (res.statusCode == 0) {
               response.fail("ServiceWorker request failed");
-            } else {
+            } else if (!response.platformResponse) {
               response.writeHead(res.statusCode, res.headers);
               response.write(res.body.buffer);
             }
@@ -773,8 +845,11 @@ export * from '{{url}}'
           });
 
           if (fetched) {
-            this->getRuntime()->services.timers.setTimeout(32000, [request] () mutable {
-              if (request->isActive()) {
+            // the fetch holds the request body now
+            request->body = bytes::Buffer();
+            this->getRuntime()->services.timers.setTimeout(32000, [request, streamedResponse] () mutable {
+              // a response that started streaming is not timed out
+              if (request->isActive() && !streamedResponse->platformResponse) {
                 auto response = SchemeHandlers::Response(request, 408);
                 response.fail("ServiceWorker request timed out.");
               }
@@ -823,7 +898,7 @@ export * from '{{url}}'
           url.search = request->query;
 
           const auto moduleImportProxy = tmpl(
-            String(reinterpret_cast<const char*>(resource.read())).find("export default") != String::npos
+            resource.str().find("export default") != String::npos
               ? ESM_IMPORT_PROXY_TEMPLATE_WITH_DEFAULT_EXPORT
               : ESM_IMPORT_PROXY_TEMPLATE_WITHOUT_DEFAULT_EXPORT,
             Map<String, String> {
@@ -944,7 +1019,7 @@ export * from '{{url}}'
           url.pathname = "/socket" + pathname;
           url.search = request->query;
           const auto moduleImportProxy = tmpl(
-            String(reinterpret_cast<const char*>(resource.read())).find("export default") != String::npos
+            resource.str().find("export default") != String::npos
               ? ESM_IMPORT_PROXY_TEMPLATE_WITH_DEFAULT_EXPORT
               : ESM_IMPORT_PROXY_TEMPLATE_WITHOUT_DEFAULT_EXPORT,
             Map<String, String> {
@@ -1165,9 +1240,12 @@ export * from '{{url}}'
           fetch.headers.set("origin", this->navigator.location.origin);
         }
 
+        auto streamedResponse = std::make_shared<SchemeHandlers::Response>(request);
         const auto options = serviceworker::Fetch::Options {
           .client = request->client,
-          .waitForRegistrationToFinish = request->scheme != "npm"
+          .waitForRegistrationToFinish = request->scheme != "npm",
+          .stream = createServiceWorkerFetchStream(request, streamedResponse),
+          .drain = createServiceWorkerFetchDrain(streamedResponse)
         };
 
         auto origin = webview::Origin(fetch.url.str());
@@ -1183,15 +1261,15 @@ export * from '{{url}}'
           fetch.url.pathname = scope + fetch.url.pathname;
         }
 
-        const auto fetched = serviceWorkerServer->fetch(fetch, options, [request, callback] (auto res) mutable {
+        const auto fetched = serviceWorkerServer->fetch(fetch, options, [request, callback, streamedResponse] (auto res) mutable {
           if (!request->isActive()) {
             return;
           }
 
-          auto response = SchemeHandlers::Response(request);
+          auto& response = *streamedResponse;
           if (res.statusCode == 0) {
             response.fail("ServiceWorker request failed");
-          } else {
+          } else if (!response.platformResponse) {
             response.writeHead(res.statusCode, res.headers);
             response.write(res.body.buffer);
           }
@@ -1200,6 +1278,8 @@ export * from '{{url}}'
         });
 
         if (fetched) {
+          // the fetch holds the request body now
+          request->body = bytes::Buffer();
           // FIXME(@jwerle): revisit timeout
           //this->core->setTimeout(32000, [request] () mutable {
           //if (request->isActive()) {
@@ -24,8 +24,8 @@ namespace ssc::runtime::bytes {
 
   /**
    * Decodes input as a string of hex characters to a normal string.
-   * @param input The input string to encode
-   * @return An encoded string value
+   * @param input The input string to decode
+   * @return A decoded string value, empty if `input` is not hex
    */
   String decodeHexString (const String& input);
 
@@ -41,6 +41,11 @@ namespace ssc::runtime::bytes {
   size_t base64_encode_length (size_t inputSize);
   size_t base64_decode_length (size_t inputSize);
 
+  /**
+   * Encodes `input` with the standard alphabet and `=` padding into
+   * `output`, which is NUL terminated.
+   * @return The encoded size, or `0` if `outputSize` is too small
+   */
   size_t base64_encode (
     const unsigned char* input,
     size_t inputSize,
@@ -48,17 +53,75 @@ namespace ssc::runtime::bytes {
     size_t outputSize
   );
 
-  size_t base64_decode (
+  /**
+   * Encodes `input` with the URL safe alphabet (`-` and `_`) and without
+   * padding into `output`, which is NUL terminated.
+   * @return The encoded size, or `0` if `outputSize` is too small
+   */
+  size_t base64url_encode (
+    const unsigned char* input,
     size_t inputSize,
+    char *output,
+    size_t outputSize
+  );
+
+  /**
+   * Decodes standard or URL safe `input`, padded or not, into `output`.
+   * @return The decoded size, or `0` for invalid input or if `outputSize`
+   * is too small
+   */
+  size_t base64_decode (
     const char *input,
+    size_t inputSize,
     unsigned char *output,
     size_t outputSize
   );
 
   namespace base64 {
-    String encode (const Vector<uint8_t>&);
-    String encode (const String&);
+    enum class Alphabet {
+      Standard,
+      URLSafe
+    };
+
+    String encode (const unsigned char*, size_t, Alphabet = Alphabet::Standard);
+    String encode (const Vector<uint8_t>&, Alphabet = Alphabet::Standard);
+    String encode (const String&, Alphabet = Alphabet::Standard);
     String decode (const String&);
+
+    /**
+     * Encodes input given in chunks, bytes that do not complete a 3 byte
+     * group are carried over to the next chunk.
+     */
+    class Encoder {
+      public:
+        Encoder (Alphabet = Alphabet::Standard);
+        String update (const unsigned char*, size_t);
+        String update (const String&);
+        String finalize ();
+
+      private:
+        Alphabet alphabet;
+        unsigned char pending[3] = {0};
+        size_t pendingSize = 0;
+    };
+
+    /**
+     * Decodes input given in chunks, characters that do not complete a 4
+     * character group are carried over to the next chunk.
+     */
+    class Decoder {
+      public:
+        String update (const char*, size_t);
+        String update (const String&);
+        String finalize ();
+        bool failed () const;
+
+      private:
+        String pending;
+        bool isFinished = false;
+        bool isFailed = false;
+        String decode (size_t);
+    };
   }
 
   class ArrayBuffer {
@@ -1,131 +1,635 @@
 #include "../bytes.hh"
 
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define BASE64_X86_SIMD 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define BASE64_ARM_NEON 1
+#endif
+
 namespace ssc::runtime::bytes {
   static const char TABLE[] =
     "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
     "abcdefghijklmnopqrstuvwxyz"
     "0123456789+/";
 
-  static unsigned char base64_decode_char (char c) {
-    if (c >= 'A' && c <= 'Z') return c - 'A';
-    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
-    if (c >= '0' && c <= '9') return c - '0' + 52;
-    if (c == '+') return 62;
-    if (c == '/') return 63;
-    return 255; // invalid
+  static const char URL_SAFE_TABLE[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz"
+    "0123456789-_";
+
+  // both alphabets are decoded, every other character is invalid (`0xFF`)
+  static const unsigned char DECODE_TABLE[256] = { /*       0    1    2    3     4    5    6    7     8    9    A    B     C    D    E    F */
+    /* 0 */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* 1 */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* 2 */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255,  62,  255,  62, 255,  63,
+    /* 3 */  52,  53,  54,  55,   56,  57,  58,  59,   60,  61, 255, 255,  255, 255, 255, 255,
+
+    /* 4 */ 255,   0,   1,   2,    3,   4,   5,   6,    7,   8,   9,  10,   11,  12,  13,  14,
+    /* 5 */  15,  16,  17,  18,   19,  20,  21,  22,   23,  24,  25, 255,  255, 255, 255,  63,
+    /* 6 */ 255,  26,  27,  28,   29,  30,  31,  32,   33,  34,  35,  36,   37,  38,  39,  40,
+    /* 7 */  41,  42,  43,  44,   45,  46,  47,  48,   49,  50,  51, 255,  255, 255, 255, 255,
+
+    /* 8 */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* 9 */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* A */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* B */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+
+    /* C */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* D */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* E */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,
+    /* F */ 255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255,  255, 255, 255, 255
+  };
+
+  // Vectorized codecs consume a prefix of the input in whole blocks and
+  // return how much of it they consumed, the rest goes through the
+  // table-driven scalar code. The x86_64 codecs are picked at runtime
+  // with the CPU features, NEON is always there on arm64.
+#if BASE64_X86_SIMD
+  // the offsets that map 6-bit values to the characters of an alphabet,
+  // alphabets only differ in the characters for 62 and 63
+  __attribute__((target("ssse3")))
+  static inline __m128i base64_encode_offsets_ssse3 (const char* table) {
+    return _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, table[62] - 62,
+      table[63] - 63, 'A', 0, 0
+    );
   }
 
-  size_t base64_encode_length (size_t inputSize) {
-    return 4 * ((inputSize + 2) / 3);
+  __attribute__((target("ssse3")))
+  static inline __m128i base64_encode_lookup_ssse3 (__m128i indices, __m128i offsets) {
+    auto result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const auto less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, result), indices);
   }
 
-  size_t base64_decode_length (size_t inputSize) {
-    return (inputSize / 4) * 3;
+  // spreads 12 bytes into 16 lanes of 6 bits
+  __attribute__((target("ssse3")))
+  static inline __m128i base64_encode_unpack_ssse3 (__m128i input) {
+    input = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const auto t0 = _mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00));
+    const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const auto t2 = _mm_and_si128(input, _mm_set1_epi32(0x003f03f0));
+    const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t1, t3);
   }
 
-  size_t base64_encode (
-    const unsigned char *input,
+  __attribute__((target("ssse3")))
+  static size_t base64_encode_ssse3 (
+    const unsigned char* input,
     size_t inputSize,
-    char *output,
+    char* output,
+    const char* table
+  ) {
+    const auto offsets = base64_encode_offsets_ssse3(table);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    // 16 bytes are loaded for the 12 that are encoded
+    for (; i + 16 <= inputSize; i += 12, j += 16) {
+      const auto indices = base64_encode_unpack_ssse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))
+      );
+
+      _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + j),
+        base64_encode_lookup_ssse3(indices, offsets)
+      );
+    }
+
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  static size_t base64_encode_avx2 (
+    const unsigned char* input,
+    size_t inputSize,
+    char* output,
+    const char* table
+  ) {
+    const auto offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, table[62] - 62,
+      table[63] - 63, 'A', 0, 0,
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, table[62] - 62,
+      table[63] - 63, 'A', 0, 0
+    );
+
+    const auto shuffle = _mm256_set_epi8(
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+      10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1
+    );
+
+    size_t i = 0;
+    size_t j = 0;
+
+    // each lane encodes 12 of 16 loaded bytes, 28 bytes are read
+    for (; i + 28 <= inputSize; i += 24, j += 32) {
+      auto in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 12)),
+        1
+      );
+
+      in = _mm256_shuffle_epi8(in, shuffle);
+
+      const auto t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+      const auto t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+      const auto t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+      const auto t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+      const auto indices = _mm256_or_si256(t1, t3);
+
+      auto result = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+      const auto less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+      result = _mm256_or_si256(result, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+      result = _mm256_add_epi8(_mm256_shuffle_epi8(offsets, result), indices);
+
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + j), result);
+    }
+
+    return i;
+  }
+
+  // maps the URL safe `-` and `_` to `+` and `/`, as both alphabets decode
+  __attribute__((target("ssse3")))
+  static inline __m128i base64_decode_normalize_ssse3 (__m128i input) {
+    const auto dash = _mm_cmpeq_epi8(input, _mm_set1_epi8('-'));
+    const auto underscore = _mm_cmpeq_epi8(input, _mm_set1_epi8('_'));
+    input = _mm_add_epi8(input, _mm_and_si128(dash, _mm_set1_epi8('+' - '-')));
+    return _mm_add_epi8(input, _mm_and_si128(underscore, _mm_set1_epi8('/' - '_')));
+  }
+
+  __attribute__((target("ssse3")))
+  static size_t base64_decode_ssse3 (
+    const char* input,
+    size_t inputSize,
+    unsigned char* output,
+    size_t outputSize
+  ) {
+    const auto lutLow = _mm_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+    );
+
+    const auto lutHigh = _mm_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+    );
+
+    const auto lutRoll = _mm_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71,
+      0, 0, 0, 0, 0, 0, 0, 0
+    );
+
+    const auto pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    const auto mask = _mm_set1_epi8(0x0F);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    // 16 bytes are stored for the 12 that are decoded
+    for (; i + 16 <= inputSize && j + 16 <= outputSize; i += 16, j += 12) {
+      const auto in = base64_decode_normalize_ssse3(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i))
+      );
+
+      const auto high = _mm_and_si128(_mm_srli_epi32(in, 4), mask);
+      const auto low = _mm_and_si128(in, mask);
+      const auto invalid = _mm_and_si128(
+        _mm_shuffle_epi8(lutLow, low),
+        _mm_shuffle_epi8(lutHigh, high)
+      );
+
+      // the scalar code decodes (and rejects) a block with invalid input
+      if (_mm_movemask_epi8(_mm_cmpgt_epi8(invalid, _mm_setzero_si128())) != 0) {
+        break;
+      }
+
+      const auto slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+      const auto roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(slash, high));
+      const auto values = _mm_add_epi8(in, roll);
+
+      const auto merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+      const auto packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+
+      _mm_storeu_si128(
+        reinterpret_cast<__m128i*>(output + j),
+        _mm_shuffle_epi8(packed, pack)
+      );
+    }
+
+    return i;
+  }
+
+  __attribute__((target("avx2")))
+  static size_t base64_decode_avx2 (
+    const char* input,
+    size_t inputSize,
+    unsigned char* output,
     size_t outputSize
   ) {
-    size_t encodedSize = 4 * ((inputSize + 2) / 3);
+    const auto lutLow = _mm256_setr_epi8(
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+    );
+
+    const auto lutHigh = _mm256_setr_epi8(
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+    );
+
+    const auto lutRoll = _mm256_setr_epi8(
+      0, 16, 19, 4, -65, -65, -71, -71,
+      0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71,
+      0, 0, 0, 0, 0, 0, 0, 0
+    );
+
+    const auto pack = _mm256_setr_epi8(
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+      2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+    );
+
+    const auto mask = _mm256_set1_epi8(0x0F);
+
     size_t i = 0;
     size_t j = 0;
 
+    // 32 bytes are stored for the 24 that are decoded
+    for (; i + 32 <= inputSize && j + 32 <= outputSize; i += 32, j += 24) {
+      auto in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+
+      const auto dash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('-'));
+      const auto underscore = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_'));
+      in = _mm256_add_epi8(in, _mm256_and_si256(dash, _mm256_set1_epi8('+' - '-')));
+      in = _mm256_add_epi8(in, _mm256_and_si256(underscore, _mm256_set1_epi8('/' - '_')));
+
+      const auto high = _mm256_and_si256(_mm256_srli_epi32(in, 4), mask);
+      const auto low = _mm256_and_si256(in, mask);
+      const auto invalid = _mm256_and_si256(
+        _mm256_shuffle_epi8(lutLow, low),
+        _mm256_shuffle_epi8(lutHigh, high)
+      );
+
+      if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(invalid, _mm256_setzero_si256())) != 0) {
+        break;
+      }
+
+      const auto slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+      const auto roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(slash, high));
+      const auto values = _mm256_add_epi8(in, roll);
+
+      const auto merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+      const auto packed = _mm256_shuffle_epi8(
+        _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000)),
+        pack
+      );
+
+      // the 12 bytes of each lane are moved next to each other
+      _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(output + j),
+        _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7))
+      );
+    }
+
+    return i;
+  }
+
+  using Base64EncodeBlocks = size_t (*)(const unsigned char*, size_t, char*, const char*);
+  using Base64DecodeBlocks = size_t (*)(const char*, size_t, unsigned char*, size_t);
+
+  static bool hasSSSE3 () {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3);
+  }
+
+  static bool hasAVX2 () {
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+    // the OS must save the upper halves of the YMM registers
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+      return false;
+    }
+
+    unsigned int xcr0 = 0;
+    unsigned int xcr0High = 0;
+    __asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0High) : "c" (0));
+
+    if ((xcr0 & 0x6) != 0x6) {
+      return false;
+    }
+
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_AVX2);
+  }
+
+  static Base64EncodeBlocks getBase64EncodeBlocks () {
+    // selected once, the CPU does not change while running
+    static const auto encode = []() -> Base64EncodeBlocks {
+      if (hasAVX2()) return base64_encode_avx2;
+      if (hasSSSE3()) return base64_encode_ssse3;
+      return nullptr;
+    }();
+
+    return encode;
+  }
+
+  static Base64DecodeBlocks getBase64DecodeBlocks () {
+    static const auto decode = []() -> Base64DecodeBlocks {
+      if (hasAVX2()) return base64_decode_avx2;
+      if (hasSSSE3()) return base64_decode_ssse3;
+      return nullptr;
+    }();
+
+    return decode;
+  }
+
+  static size_t base64_encode_blocks (
+    const unsigned char* input,
+    size_t inputSize,
+    char* output,
+    const char* table
+  ) {
+    const auto encode = getBase64EncodeBlocks();
+    return encode != nullptr ? encode(input, inputSize, output, table) : 0;
+  }
+
+  static size_t base64_decode_blocks (
+    const char* input,
+    size_t inputSize,
+    unsigned char* output,
+    size_t outputSize
+  ) {
+    const auto decode = getBase64DecodeBlocks();
+    return decode != nullptr ? decode(input, inputSize, output, outputSize) : 0;
+  }
+#elif BASE64_ARM_NEON
+  static size_t base64_encode_blocks (
+    const unsigned char* input,
+    size_t inputSize,
+    char* output,
+    const char* table
+  ) {
+    const auto lookup = vld1q_u8_x4(reinterpret_cast<const uint8_t*>(table));
+    const auto mask = vdupq_n_u8(0x3F);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    // 48 bytes are deinterleaved into 3 vectors and encoded as 64
+    for (; i + 48 <= inputSize; i += 48, j += 64) {
+      const auto in = vld3q_u8(input + i);
+      uint8x16x4_t out;
+
+      out.val[0] = vshrq_n_u8(in.val[0], 2);
+      out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+      out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+      out.val[3] = vandq_u8(in.val[2], mask);
+
+      for (int k = 0; k < 4; ++k) {
+        out.val[k] = vqtbl4q_u8(lookup, out.val[k]);
+      }
+
+      vst4q_u8(reinterpret_cast<uint8_t*>(output + j), out);
+    }
+
+    return i;
+  }
+
+  static size_t base64_decode_blocks (
+    const char* input,
+    size_t inputSize,
+    unsigned char* output,
+    size_t outputSize
+  ) {
+    const auto low = vld1q_u8_x4(DECODE_TABLE);
+    const auto high = vld1q_u8_x4(DECODE_TABLE + 64);
+
+    size_t i = 0;
+    size_t j = 0;
+
+    // 64 characters are deinterleaved into 4 vectors and decoded as 48
+    for (; i + 64 <= inputSize && j + 48 <= outputSize; i += 64, j += 48) {
+      const auto in = vld4q_u8(reinterpret_cast<const uint8_t*>(input + i));
+      uint8x16_t values[4];
+      uint8x16_t invalid = vdupq_n_u8(0);
+
+      for (int k = 0; k < 4; ++k) {
+        // characters past 127 are out of range of both tables
+        values[k] = vqtbx4q_u8(vqtbl4q_u8(low, in.val[k]), high, vsubq_u8(in.val[k], vdupq_n_u8(64)));
+        invalid = vorrq_u8(invalid, vorrq_u8(values[k], vcgtq_u8(in.val[k], vdupq_n_u8(127))));
+      }
+
+      // the scalar code decodes (and rejects) a block with invalid input
+      if (vmaxvq_u8(invalid) & 0x80) {
+        break;
+      }
+
+      uint8x16x3_t out;
+      out.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+      out.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+      out.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+
+      vst3q_u8(output + j, out);
+    }
+
+    return i;
+  }
+#else
+  static size_t base64_encode_blocks (const unsigned char*, size_t, char*, const char*) {
+    return 0;
+  }
+
+  static size_t base64_decode_blocks (const char*, size_t, unsigned char*, size_t) {
+    return 0;
+  }
+#endif
+
+  static size_t base64_encode_with_table (
+    const unsigned char *input,
+    size_t inputSize,
+    char *output,
+    size_t outputSize,
+    const char* table,
+    bool padding
+  ) {
+    const auto remainder = inputSize % 3;
+    const auto encodedSize = padding || remainder == 0
+      ? 4 * ((inputSize + 2) / 3)
+      : 4 * (inputSize / 3) + remainder + 1;
+
     if (outputSize < encodedSize + 1) {
       return 0;
     }
 
-    while (i < inputSize) {
-      const uint32_t a = i < inputSize ? input[i++] : 0;
-      const uint32_t b = i < inputSize ? input[i++] : 0;
-      const uint32_t c = i < inputSize ? input[i++] : 0;
-
-      const uint32_t triple = (a << 16) | (b << 8) | c;
+    // whole 3 byte groups
+    const auto size = inputSize - remainder;
+    size_t i = base64_encode_blocks(input, size, output, table);
+    size_t j = (i / 3) * 4;
 
-      output[j++] = TABLE[(triple >> 18) & 0x3F];
-      output[j++] = TABLE[(triple >> 12) & 0x3F];
-      output[j++] = (i > inputSize + 1) ? '=' : TABLE[(triple >> 6) & 0x3F];
-      output[j++] = (i > inputSize) ? '=' : TABLE[triple & 0x3F];
+    for (; i < size; i += 3, j += 4) {
+      const uint32_t triple = (input[i] << 16) | (input[i + 1] << 8) | input[i + 2];
+      output[j] = table[triple >> 18];
+      output[j + 1] = table[(triple >> 12) & 0x3F];
+      output[j + 2] = table[(triple >> 6) & 0x3F];
+      output[j + 3] = table[triple & 0x3F];
     }
 
-    size_t paddingSize = (3 - (inputSize % 3)) % 3;
-    for (size_t p = 0; p < paddingSize; ++p) {
-      output[encodedSize - 1 - p] = '=';
+    if (remainder > 0) {
+      const uint32_t a = input[i];
+      const uint32_t b = remainder == 2 ? input[i + 1] : 0;
+      const uint32_t triple = (a << 16) | (b << 8);
+
+      output[j++] = table[triple >> 18];
+      output[j++] = table[(triple >> 12) & 0x3F];
+
+      if (remainder == 2) {
+        output[j++] = table[(triple >> 6) & 0x3F];
+      } else if (padding) {
+        output[j++] = '=';
+      }
+
+      if (padding) {
+        output[j++] = '=';
+      }
     }
 
     output[j] = 0;
     return encodedSize;
   }
 
+  size_t base64_encode_length (size_t inputSize) {
+    return 4 * ((inputSize + 2) / 3);
+  }
+
+  size_t base64_decode_length (size_t inputSize) {
+    // an upper bound, input may be unpadded
+    return ((inputSize + 3) / 4) * 3;
+  }
+
+  size_t base64_encode (
+    const unsigned char *input,
+    size_t inputSize,
+    char *output,
+    size_t outputSize
+  ) {
+    return base64_encode_with_table(input, inputSize, output, outputSize, TABLE, true);
+  }
+
+  size_t base64url_encode (
+    const unsigned char *input,
+    size_t inputSize,
+    char *output,
+    size_t outputSize
+  ) {
+    return base64_encode_with_table(input, inputSize, output, outputSize, URL_SAFE_TABLE, false);
+  }
+
   size_t base64_decode (
     const char *input,
     size_t inputSize,
     unsigned char *output,
     size_t outputSize
   ) {
-    if (inputSize % 4 != 0) {
-      return 0;
+    size_t paddingSize = 0;
+
+    while (
+      paddingSize < 2 &&
+      inputSize > paddingSize &&
+      input[inputSize - paddingSize - 1] == '='
+    ) {
+      paddingSize++;
     }
 
-    size_t decodedSize = (inputSize / 4) * 3;
-    size_t i = 0;
-    size_t j = 0;
+    const auto size = inputSize - paddingSize;
+    const auto remainder = size % 4;
 
-    if (input[inputSize - 1] == '=') decodedSize--;
-    if (input[inputSize - 2] == '=') decodedSize--;
+    // padding only completes a 4 character group, a lone character in a
+    // group carries less than a byte
+    if ((paddingSize > 0 && inputSize % 4 != 0) || remainder == 1) {
+      return 0;
+    }
+
+    const auto decodedSize = (size / 4) * 3 + (remainder > 0 ? remainder - 1 : 0);
 
     if (outputSize < decodedSize) {
       return 0;
     }
 
-    while (i < inputSize) {
-      const auto a = base64_decode_char(input[i++]);
-      const auto b = base64_decode_char(input[i++]);
-      const auto c = base64_decode_char(input[i++]);
-      const auto d = base64_decode_char(input[i++]);
+    // whole 4 character groups
+    const auto whole = size - remainder;
+    size_t i = base64_decode_blocks(input, whole, output, outputSize);
+    size_t j = (i / 4) * 3;
+    unsigned char invalid = 0;
 
+    for (; i < whole; i += 4, j += 3) {
+      const uint32_t a = DECODE_TABLE[(unsigned char) input[i]];
+      const uint32_t b = DECODE_TABLE[(unsigned char) input[i + 1]];
+      const uint32_t c = DECODE_TABLE[(unsigned char) input[i + 2]];
+      const uint32_t d = DECODE_TABLE[(unsigned char) input[i + 3]];
       const uint32_t triple = (a << 18) | (b << 12) | (c << 6) | d;
 
-      if (j < decodedSize) output[j++] = (triple >> 16) & 0xFF;
-      if (j < decodedSize) output[j++] = (triple >> 8) & 0xFF;
-      if (j < decodedSize) output[j++] = triple & 0xFF;
+      invalid |= a | b | c | d;
+      output[j] = (triple >> 16) & 0xFF;
+      output[j + 1] = (triple >> 8) & 0xFF;
+      output[j + 2] = triple & 0xFF;
+    }
+
+    if (remainder > 0) {
+      const uint32_t a = DECODE_TABLE[(unsigned char) input[i]];
+      const uint32_t b = DECODE_TABLE[(unsigned char) input[i + 1]];
+      const uint32_t c = remainder == 3 ? DECODE_TABLE[(unsigned char) input[i + 2]] : 0;
+      const uint32_t triple = (a << 18) | (b << 12) | (c << 6);
+
+      invalid |= a | b | c;
+      output[j++] = (triple >> 16) & 0xFF;
+
+      if (remainder == 3) {
+        output[j++] = (triple >> 8) & 0xFF;
+      }
+    }
+
+    // valid values are 6 bits, invalid characters are `0xFF`
+    if (invalid & 0x80) {
+      return 0;
     }
 
     return decodedSize;
   }
 
   namespace base64 {
-    String encode (const Vector<uint8_t>& input) {
-      const size_t size = 4 * ((input.size() + 2) / 3) + 1;
-      String output(size, 0);
-      const auto encodedSize = base64_encode(
-        input.data(),
-        input.size(),
-        &output[0],
-        output.size()
-      );
+    String encode (const unsigned char* input, size_t size, Alphabet alphabet) {
+      String output(base64_encode_length(size) + 1, 0);
+      const auto encodedSize = alphabet == Alphabet::URLSafe
+        ? base64url_encode(input, size, &output[0], output.size())
+        : base64_encode(input, size, &output[0], output.size());
       output.resize(encodedSize);
       return output;
     }
 
-    String encode (const String& input) {
-      const size_t size = 4 * ((input.size() + 2) / 3) + 1;
-      String output(size, 0);
-      const auto encodedSize = base64_encode(
+    String encode (const Vector<uint8_t>& input, Alphabet alphabet) {
+      return encode(input.data(), input.size(), alphabet);
+    }
+
+    String encode (const String& input, Alphabet alphabet) {
+      return encode(
         reinterpret_cast<const unsigned char *>(input.data()),
         input.size(),
-        &output[0],
-        output.size()
+        alphabet
       );
-      output.resize(encodedSize);
-      return output;
     }
 
     String decode (const String& input) {
-      const auto size = (input.size() / 4) * 3;
-      String output(size, 0);
+      String output(base64_decode_length(input.size()), 0);
       const auto decodedSize = base64_decode(
         input.data(),
         input.size(),
@@ -135,5 +639,106 @@ namespace ssc::runtime::bytes {
       output.resize(decodedSize);
       return output;
     }
+
+    Encoder::Encoder (Alphabet alphabet)
+      : alphabet(alphabet)
+    {}
+
+    String Encoder::update (const unsigned char* input, size_t size) {
+      String output;
+
+      // complete a group carried over from the last chunk first
+      while (this->pendingSize > 0 && this->pendingSize < 3 && size > 0) {
+        this->pending[this->pendingSize++] = *input++;
+        size--;
+      }
+
+      if (this->pendingSize == 3) {
+        output += encode(this->pending, 3, this->alphabet);
+        this->pendingSize = 0;
+      }
+
+      const auto remainder = size % 3;
+
+      if (size - remainder > 0) {
+        output += encode(input, size - remainder, this->alphabet);
+      }
+
+      for (size_t i = size - remainder; i < size; ++i) {
+        this->pending[this->pendingSize++] = input[i];
+      }
+
+      return output;
+    }
+
+    String Encoder::update (const String& input) {
+      return this->update(
+        reinterpret_cast<const unsigned char *>(input.data()),
+        input.size()
+      );
+    }
+
+    String Encoder::finalize () {
+      const auto output = encode(this->pending, this->pendingSize, this->alphabet);
+      this->pendingSize = 0;
+      return output;
+    }
+
+    String Decoder::update (const char* input, size_t size) {
+      String output;
+
+      if (this->isFinished || this->isFailed) {
+        this->isFailed = this->isFailed || size > 0;
+        return output;
+      }
+
+      this->pending.append(input, size);
+
+      // a group with padding is only decoded when the stream is finalized
+      const auto padding = this->pending.find('=');
+      const auto available = padding == String::npos ? this->pending.size() : padding;
+      return this->decode(available - (available % 4));
+    }
+
+    String Decoder::update (const String& input) {
+      return this->update(input.data(), input.size());
+    }
+
+    String Decoder::finalize () {
+      if (this->isFinished || this->isFailed) {
+        return "";
+      }
+
+      this->isFinished = true;
+      return this->decode(this->pending.size());
+    }
+
+    bool Decoder::failed () const {
+      return this->isFailed;
+    }
+
+    String Decoder::decode (size_t size) {
+      if (size == 0) {
+        return "";
+      }
+
+      String output(base64_decode_length(size), 0);
+      const auto decodedSize = base64_decode(
+        this->pending.data(),
+        size,
+        reinterpret_cast<unsigned char *>(&output[0]),
+        output.size()
+      );
+
+      if (decodedSize == 0) {
+        this->isFailed = true;
+        this->pending.clear();
+        return "";
+      }
+
+      this->pending.erase(0, size);
+      output.resize(decodedSize);
+      return output;
+    }
   }
 }
@@ -3,12 +3,22 @@
 #include "../platform.hh"
 #include "../bytes.hh"
 
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define HEX_X86_SIMD 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HEX_ARM_NEON 1
+#endif
+
 #define UNSIGNED_IN_RANGE(value, min, max) (                                   \
   (unsigned char) (value) >= (unsigned char) (min) &&                          \
   (unsigned char) (value) <= (unsigned char) (max)                             \
 )
 
 static const char HEX_CHARS_TABLE[16 + 1] = "0123456789ABCDEF";
+static const char HEX_LOWER_CHARS_TABLE[16 + 1] = "0123456789abcdef";
 static const signed char DEC_CHARS_INDEX[256] = { /*       0  1  2  3   4  5  6  7   8  9  A  B   C  D  E  F */
   /* 0 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
   /* 1 */ -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1, -1,-1,-1,-1,
@@ -64,41 +74,116 @@ namespace ssc::runtime::bytes {
     return bytes;
   }
 
-  String encodeHexString (const String& input) {
-    String output;
-    const auto length = 2 * input.size();
+  // encodes whole 16 byte blocks of `input` and returns how many bytes
+  // were consumed, the rest is encoded with the table
+#if HEX_X86_SIMD
+  __attribute__((target("ssse3")))
+  static size_t encodeHexBlocksSSSE3 (
+    const unsigned char* input,
+    size_t size,
+    char* output,
+    const char* table
+  ) {
+    const auto lookup = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    const auto mask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+      const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const auto hi = _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+      const auto lo = _mm_shuffle_epi8(lookup, _mm_and_si128(in, mask));
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2), _mm_unpacklo_epi8(hi, lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+
+    return i;
+  }
 
-    output.reserve(length);
+  static size_t encodeHexBlocks (
+    const unsigned char* input,
+    size_t size,
+    char* output,
+    const char* table
+  ) {
+    // selected once, the CPU does not change while running
+    static const auto supported = []() {
+      unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+      return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3);
+    }();
+
+    return supported ? encodeHexBlocksSSSE3(input, size, output, table) : 0;
+  }
+#elif HEX_ARM_NEON
+  static size_t encodeHexBlocks (
+    const unsigned char* input,
+    size_t size,
+    char* output,
+    const char* table
+  ) {
+    const auto lookup = vld1q_u8(reinterpret_cast<const uint8_t*>(table));
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16) {
+      const auto in = vld1q_u8(input + i);
+      uint8x16x2_t out;
+      out.val[0] = vqtbl1q_u8(lookup, vshrq_n_u8(in, 4));
+      out.val[1] = vqtbl1q_u8(lookup, vandq_u8(in, vdupq_n_u8(0x0F)));
+      vst2q_u8(reinterpret_cast<uint8_t*>(output + i * 2), out);
+    }
 
-    for (unsigned char character : input) {
-      output.push_back(HEX_CHARS_TABLE[character >> 4]);
-      output.push_back(HEX_CHARS_TABLE[character & 15]);
+    return i;
+  }
+#else
+  static size_t encodeHexBlocks (const unsigned char*, size_t, char*, const char*) {
+    return 0;
+  }
+#endif
+
+  static String encodeHexString (
+    const unsigned char* input,
+    size_t size,
+    const char* table
+  ) {
+    String output(2 * size, 0);
+    auto i = encodeHexBlocks(input, size, &output[0], table);
+
+    for (; i < size; ++i) {
+      output[i * 2] = table[input[i] >> 4];
+      output[i * 2 + 1] = table[input[i] & 15];
     }
 
     return output;
   }
 
+  String encodeHexString (const String& input) {
+    return encodeHexString(
+      reinterpret_cast<const unsigned char*>(input.data()),
+      input.size(),
+      HEX_CHARS_TABLE
+    );
+  }
+
   String encodeHexString (const Vector<uint8_t>& input) {
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0');
-    for (const auto c : input) {
-      oss << std::setw(2) << static_cast<int>(c);
-    }
-    return oss.str();
+    // lower case, like the `std::hex` stream this used to be
+    return encodeHexString(input.data(), input.size(), HEX_LOWER_CHARS_TABLE);
   }
 
   String decodeHexString (const String& input) {
-    const auto length = input.length() / 2;
-    String output;
-
-    output.reserve(length);
-
-    for (auto character = input.begin(); character != input.end();) {
-      const int hi = DEC_CHARS_INDEX[(unsigned char) *character++];
-      const int lo = DEC_CHARS_INDEX[(unsigned char) *character++];
-      output.push_back(hi << 4 | lo);
+    // a trailing odd character is ignored
+    const auto length = input.size() / 2;
+    const auto bytes = reinterpret_cast<const unsigned char*>(input.data());
+    String output(length, 0);
+    // negative once any character was not a hex digit
+    int valid = 0;
+
+    for (size_t i = 0; i < length; ++i) {
+      const int hi = DEC_CHARS_INDEX[bytes[i * 2]];
+      const int lo = DEC_CHARS_INDEX[bytes[i * 2 + 1]];
+      valid |= hi | lo;
+      output[i] = (char) ((unsigned) hi << 4 | (unsigned) lo);
     }
 
-    return output;
+    return valid < 0 ? String() : output;
   }
 }
@@ -125,8 +125,7 @@ namespace ssc::runtime::context {
       ");                                                                    \n"
     );
 
-    Lock lock(this->mutex);
-    this->queuedResponses[queuedResponse.id] = std::move(queuedResponse);
+    this->queuedResponses.put(std::move(queuedResponse));
     return script;
   }
 
@@ -0,0 +1,158 @@
+#include "../queued_response.hh"
+
+namespace ssc::runtime {
+  QueuedResponses::QueuedResponses (const Options& options)
+    : options(options)
+  {}
+
+  uint64_t QueuedResponses::now () {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+  }
+
+  void QueuedResponses::put (QueuedResponse response) {
+    Lock lock(this->mutex);
+    const auto queued = now();
+    const auto ttl = response.ttl > 0 ? response.ttl : this->options.ttl;
+    const auto id = response.id;
+
+    if (this->entries.contains(id)) {
+      this->erase(this->entries.find(id));
+    }
+
+    // make room for the new body, oldest entries first, stopping at the
+    // first entry still in its grace period as every later one is younger
+    while (
+      this->order.size() > 0 &&
+      this->options.maxBytes > 0 &&
+      this->counters.bytes + response.length > this->options.maxBytes
+    ) {
+      const auto oldest = this->entries.find(this->order.begin()->second);
+      if (queued - oldest->second.queued < this->options.evictionGracePeriod) {
+        break;
+      }
+
+      this->erase(oldest);
+      this->counters.evictions++;
+    }
+
+    auto entry = Entry {
+      std::move(response),
+      queued,
+      ttl > 0 ? queued + ttl : 0,
+      ++this->sequence
+    };
+
+    this->counters.bytes += entry.response.length;
+    this->order.emplace(entry.sequence, id);
+    this->entries.emplace(id, std::move(entry));
+  }
+
+  bool QueuedResponses::take (const ID id, QueuedResponse& response) {
+    Lock lock(this->mutex);
+    const auto iterator = this->entries.find(id);
+
+    if (iterator == this->entries.end()) {
+      this->counters.misses++;
+      return false;
+    }
+
+    const auto latency = now() - iterator->second.queued;
+
+    // an expired entry that was not collected yet is a miss
+    if (iterator->second.expires > 0 && iterator->second.expires <= now()) {
+      this->erase(iterator);
+      this->counters.expirations++;
+      this->counters.misses++;
+      return false;
+    }
+
+    response = std::move(iterator->second.response);
+    this->erase(iterator);
+
+    this->counters.hits++;
+    this->counters.hitLatency += latency;
+
+    if (latency > this->counters.maxHitLatency) {
+      this->counters.maxHitLatency = latency;
+    }
+
+    return true;
+  }
+
+  bool QueuedResponses::contains (const ID id) const {
+    Lock lock(this->mutex);
+    return this->entries.contains(id);
+  }
+
+  bool QueuedResponses::remove (const ID id) {
+    Lock lock(this->mutex);
+    const auto iterator = this->entries.find(id);
+
+    if (iterator == this->entries.end()) {
+      return false;
+    }
+
+    this->erase(iterator);
+    return true;
+  }
+
+  size_t QueuedResponses::size () const {
+    Lock lock(this->mutex);
+    return this->entries.size();
+  }
+
+  size_t QueuedResponses::bytes () const {
+    return this->counters.bytes.load();
+  }
+
+  const Vector<QueuedResponses::ID> QueuedResponses::ids () const {
+    Lock lock(this->mutex);
+    Vector<ID> ids;
+
+    for (const auto& entry : this->entries) {
+      ids.push_back(entry.first);
+    }
+
+    return ids;
+  }
+
+  size_t QueuedResponses::expire () {
+    Lock lock(this->mutex);
+    const auto timestamp = now();
+    size_t expired = 0;
+
+    for (auto iterator = this->entries.begin(); iterator != this->entries.end();) {
+      const auto expires = iterator->second.expires;
+      if (expires > 0 && expires <= timestamp) {
+        const auto next = std::next(iterator);
+        this->erase(iterator);
+        iterator = next;
+        expired++;
+      } else {
+        ++iterator;
+      }
+    }
+
+    this->counters.expirations += expired;
+    return expired;
+  }
+
+  void QueuedResponses::clear () {
+    Lock lock(this->mutex);
+    this->entries.clear();
+    this->order.clear();
+    this->counters.bytes = 0;
+  }
+
+  void QueuedResponses::erase (Map<ID, Entry>::iterator iterator) {
+    if (iterator == this->entries.end()) {
+      return;
+    }
+
+    this->counters.bytes -= iterator->second.response.length;
+    this->order.erase(iterator->second.sequence);
+    this->entries.erase(iterator);
+  }
+}
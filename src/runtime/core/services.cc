@@ -1,33 +1,126 @@
+#include "../string.hh"
+
 #include "services.hh"
 
+using ssc::runtime::string::toLowerCase;
+using ssc::runtime::string::trim;
+
 namespace ssc::runtime::core {
+  static constexpr auto LOOP_AFFINITY_CONFIG_PREFIX = "runtime_loops_";
+
+  static Map<String, SharedPointer<loop::Loop>> createDedicatedLoops (
+    const Services::LoopAffinity& affinity
+  ) {
+    Map<String, SharedPointer<loop::Loop>> loops;
+    auto options = loop::Loop::Options {};
+
+    // a dedicated loop is never driven by the platform main loop, so it
+    // always gets a thread of its own (a dispatch queue on Apple platforms)
+    options.dedicatedThread = true;
+
+    for (const auto& entry : affinity) {
+      if (!loops.contains(entry.second)) {
+        loops.emplace(entry.second, std::make_shared<loop::Loop>(options));
+      }
+    }
+
+    return loops;
+  }
+
+  const Services::LoopAffinity Services::getLoopAffinity (
+    const Map<String, String>& userConfig
+  ) {
+    LoopAffinity affinity;
+
+    for (const auto& name : DEDICATED_LOOP_SERVICES) {
+      const auto key = LOOP_AFFINITY_CONFIG_PREFIX + name;
+      if (!userConfig.contains(key)) {
+        continue;
+      }
+
+      const auto value = toLowerCase(trim(userConfig.at(key)));
+      // `main` (or an empty value) keeps a service on the runtime loop
+      if (value.size() > 0 && value != "main") {
+        affinity[name] = value;
+      }
+    }
+
+    return affinity;
+  }
+
   Services::Services (
     context::RuntimeContext& context,
     const Options& options
   )
-    : ai({ context, options.features.useAI, options.dispatcher, context.loop, *this }),
-      conduit({ context, options.features.useConduit, options.dispatcher, context.loop, *this }),
+    : context(context),
+      affinity(options.loops),
+      loops(createDedicatedLoops(options.loops)),
+      ai({ context, options.features.useAI, options.dispatcher, context.loop, *this }),
+      conduit({ context, options.features.useConduit, options.dispatcher, this->getLoop("conduit"), *this }),
+      crypto({ context, options.features.useCrypto, options.dispatcher, context.loop, *this }),
       broadcastChannel({ context, options.features.useBroadcashChannel, options.dispatcher, context.loop, *this }),
-      dns({ context, options.features.useDNS, options.dispatcher, context.loop, *this }),
+      dns({ context, options.features.useDNS, options.dispatcher, this->getLoop("dns"), *this }),
       diagnostics({ context, options.features.useDiagnostics, options.dispatcher, context.loop, *this }),
-      fs({ context, options.features.useFS, options.dispatcher, context.loop, *this }),
+      fs({ context, options.features.useFS, options.dispatcher, this->getLoop("fs"), *this }),
       geolocation({ context, options.features.useGeolocation, options.dispatcher, context.loop, *this }),
       mediaDevices({ context, options.features.useMediaDevices, options.dispatcher, context.loop, *this }),
       networkStatus({ context, options.features.useNetworkStatus, options.dispatcher, context.loop, *this }),
       notifications({ context, options.features.useNotifications, options.dispatcher, context.loop, *this }),
       os({ context, options.features.useOS, options.dispatcher, context.loop, *this }),
       permissions({ context, options.features.usePermissions, options.dispatcher, context.loop, *this }),
-      process({ context, options.features.useProcess, options.dispatcher, context.loop, *this }),
+      process({ context, options.features.useProcess, options.dispatcher, this->getLoop("process"), *this }),
       platform({ context, options.features.usePlatform, options.dispatcher, context.loop, *this }),
       timers({ context, options.features.useTimers, options.dispatcher, context.loop, *this }),
-      udp({ context, options.features.useUDP, options.dispatcher, context.loop, *this })
+      udp({ context, options.features.useUDP, options.dispatcher, this->getLoop("udp"), *this })
   {}
 
+  Services::~Services () {
+    for (const auto& entry : this->loops) {
+      entry.second->shutdown();
+    }
+  }
+
+  loop::Loop& Services::getLoop (const String& name) {
+    if (this->affinity.contains(name)) {
+      const auto& loopName = this->affinity.at(name);
+      if (this->loops.contains(loopName)) {
+        return *this->loops.at(loopName);
+      }
+    }
+
+    return this->context.loop;
+  }
+
+  bool Services::handoff (
+    const String& name,
+    const loop::Loop::DispatchCallback& callback
+  ) {
+    return this->getLoop(name).handoff(callback);
+  }
+
+  bool Services::isDedicatedLoopThread () const {
+    for (const auto& entry : this->loops) {
+      if (entry.second->isCurrentThread()) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   bool Services::start () {
     Lock lock(this->mutex);
+
+    for (const auto& entry : this->loops) {
+      if (!entry.second->resume()) {
+        return false;
+      }
+    }
+
     const auto services = Vector<Service*> {
       &this->ai,
       &this->conduit,
+      &this->crypto,
       &this->broadcastChannel,
       &this->dns,
       &this->diagnostics,
@@ -57,6 +150,7 @@ namespace ssc::runtime::core {
     const auto services = Vector<Service*> {
       &this->ai,
       &this->conduit,
+      &this->crypto,
       &this->broadcastChannel,
       &this->dns,
       &this->diagnostics,
@@ -78,6 +172,15 @@ namespace ssc::runtime::core {
         return false;
       }
     }
+
+  #if !SOCKET_RUNTIME_PLATFORM_ANDROID
+    for (const auto& entry : this->loops) {
+      if (!entry.second->pause()) {
+        return false;
+      }
+    }
+  #endif
+
     return true;
   }
 }
@@ -7,6 +7,7 @@
 #include "services/ai.hh"
 #include "services/broadcast_channel.hh"
 #include "services/conduit.hh"
+#include "services/crypto.hh"
 #include "services/diagnostics.hh"
 #include "services/dns.hh"
 #include "services/fs.hh"
@@ -30,6 +31,7 @@ namespace ssc::runtime::core {
       bool useChildProcess = true;
     #endif
       bool useConduit = true;
+      bool useCrypto = true;
       bool useDiagnostics = true;
       bool useDNS = true;
       bool useFS = true;
@@ -45,16 +47,49 @@ namespace ssc::runtime::core {
       bool useUDP = true;
     };
 
+    /**
+     * Maps the name of a core service (`fs`, `udp`, ...) to the name of the
+     * dedicated loop it runs on. Services sharing a loop name share a loop,
+     * services without an entry run on the runtime loop.
+     */
+    using LoopAffinity = Map<String, String>;
+
     struct Options {
       context::Dispatcher& dispatcher;
       Features features;
+      LoopAffinity loops = {};
+    };
+
+    // core services that may run on a dedicated loop, every other service
+    // expects to run on the runtime loop. `timers` is not one of them as
+    // internal timeouts fail scheme handler responses, finish service worker
+    // fetches and destroy windows from their callbacks
+    static inline const Vector<String> DEDICATED_LOOP_SERVICES = {
+      "conduit",
+      "dns",
+      "fs",
+      "process",
+      "udp"
     };
 
+    /**
+     * Gets the loop affinity of the core services from the `[runtime.loops]`
+     * section of the user config.
+     */
+    static const LoopAffinity getLoopAffinity (const Map<String, String>& userConfig);
+
     Mutex mutex;
+    context::RuntimeContext& context;
+    LoopAffinity affinity;
+
+    // dedicated loops by name, declared before the services so they outlive
+    // the services that run on them
+    Map<String, SharedPointer<loop::Loop>> loops;
 
     core::services::BroadcastChannel broadcastChannel;
     core::services::AI ai;
     core::services::Conduit conduit;
+    core::services::Crypto crypto;
     core::services::Diagnostics diagnostics;
     core::services::DNS dns;
     core::services::FS fs;
@@ -75,8 +110,27 @@ namespace ssc::runtime::core {
     Services (Services&&) = delete;
     Services& operator = (const Services&) = delete;
     Services& operator = (Services&&) = delete;
+    ~Services ();
     bool start ();
     bool stop ();
+
+    /**
+     * Gets the loop the service named `name` runs on, which is either a
+     * dedicated loop or the runtime loop.
+     */
+    loop::Loop& getLoop (const String& name);
+
+    /**
+     * Hands a callback off to the loop the service named `name` runs on.
+     * @see `loop::Loop::handoff()`
+     */
+    bool handoff (const String& name, const loop::Loop::DispatchCallback&);
+
+    /**
+     * Returns `true` if the calling thread is running one of the dedicated
+     * service loops, rather than the runtime loop.
+     */
+    bool isDedicatedLoopThread () const;
   };
 }
 #endif
@@ -626,7 +626,7 @@ namespace ssc::runtime::core::services {
             context->client->conduit->loop.dispatch([=]() mutable {
               context->callback();
               delete context;
-            });
+            }, loop::Loop::Priority::High);
           }
         }
       );
@@ -663,7 +663,7 @@ namespace ssc::runtime::core::services {
         context->client->conduit->loop.dispatch([=]() mutable {
           context->callback();
           delete context;
-        });
+        }, loop::Loop::Priority::High);
       }
     });
 
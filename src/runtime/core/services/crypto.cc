@@ -0,0 +1,312 @@
+#include "crypto.hh"
+#include "../services.hh"
+
+namespace ssc::runtime::core::services {
+  struct DigestRequest {
+    uv_work_t req;
+    Crypto* service = nullptr;
+    String seq;
+    Crypto::DigestOptions options;
+    Crypto::Callback callback = nullptr;
+    crypto::Digest digest;
+    // retained while the descriptor is read on the threadpool
+    SharedPointer<FS::Descriptor> descriptor = nullptr;
+    uint64_t size = 0;
+    int err = 0;
+
+    DigestRequest (
+      Crypto* service,
+      const String& seq,
+      const Crypto::DigestOptions& options,
+      const Crypto::Callback callback
+    ) : service(service),
+        seq(seq),
+        options(options),
+        callback(callback),
+        digest(options.algorithm)
+    {
+      this->req.data = this;
+    }
+
+    // posts the progress of a large digest to the client, on the loop
+    void progress (uint64_t bytes) {
+      const auto callback = this->callback;
+      const auto id = this->options.progress;
+      const auto size = this->size;
+
+      this->service->loop.dispatch([callback, id, bytes, size]() {
+        const auto json = JSON::Object::Entries {
+          {"source", "crypto.digest"},
+          {"data", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"bytes", bytes},
+            {"size", size}
+          }}
+        };
+
+        callback("-1", json, QueuedResponse{});
+      });
+    }
+
+    // reads `fd` from the start with positional reads, so the position of
+    // a descriptor shared with the client is left as it is
+    int read (uv_loop_t* loop, uv_file fd) {
+      auto buffer = std::make_unique<char[]>(Crypto::DIGEST_READ_BUFFER_SIZE);
+      uint64_t reported = 0;
+      int64_t offset = 0;
+      uv_fs_t req;
+
+      if (uv_fs_fstat(loop, &req, fd, nullptr) == 0) {
+        this->size = req.statbuf.st_size;
+      }
+
+      uv_fs_req_cleanup(&req);
+
+      while (true) {
+        auto buf = uv_buf_init(buffer.get(), Crypto::DIGEST_READ_BUFFER_SIZE);
+        const auto result = uv_fs_read(loop, &req, fd, &buf, 1, offset, nullptr);
+        uv_fs_req_cleanup(&req);
+
+        if (result < 0) {
+          return result;
+        }
+
+        if (result == 0) {
+          break;
+        }
+
+        this->digest.update(reinterpret_cast<const unsigned char*>(buffer.get()), result);
+        offset += result;
+
+        if (
+          this->options.progress > 0 &&
+          offset - reported >= Crypto::DIGEST_PROGRESS_INTERVAL
+        ) {
+          reported = offset;
+          this->progress(offset);
+        }
+      }
+
+      return 0;
+    }
+  };
+
+  void Crypto::digest (
+    const String& seq,
+    const DigestOptions& options,
+    const Callback callback
+  ) {
+    this->loop.dispatch([=, this]() {
+      auto request = new DigestRequest(this, seq, options, callback);
+      auto loop = this->loop.get();
+
+      if (options.descriptor > 0) {
+        request->descriptor = this->services.fs.getDescriptor(options.descriptor);
+
+        if (request->descriptor == nullptr || !request->descriptor->isFile()) {
+          const auto json = JSON::Object::Entries {
+            {"source", "crypto.digest"},
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(options.descriptor)},
+              {"type", "NotFoundError"},
+              {"message", "No file descriptor found with that id"}
+            }}
+          };
+
+          delete request;
+          return callback(seq, json, QueuedResponse{});
+        }
+      }
+
+      const auto err = uv_queue_work(
+        loop,
+        &request->req,
+        [](uv_work_t* req) {
+          auto request = reinterpret_cast<DigestRequest*>(req->data);
+          const auto& options = request->options;
+
+          if (request->descriptor != nullptr) {
+          #if SOCKET_RUNTIME_PLATFORM_ANDROID
+            // assets are not backed by a file descriptor
+            if (request->descriptor->androidAsset != nullptr) {
+              request->err = UV_ENOTSUP;
+              return;
+            }
+          #endif
+            request->err = request->read(req->loop, request->descriptor->fd);
+          } else if (options.path.size() > 0) {
+            uv_fs_t fs;
+            const auto fd = uv_fs_open(req->loop, &fs, options.path.c_str(), UV_FS_O_RDONLY, 0, nullptr);
+            uv_fs_req_cleanup(&fs);
+
+            if (fd < 0) {
+              request->err = fd;
+              return;
+            }
+
+            request->err = request->read(req->loop, fd);
+            uv_fs_close(req->loop, &fs, fd, nullptr);
+            uv_fs_req_cleanup(&fs);
+          } else if (options.bytes != nullptr) {
+            request->size = options.size;
+            request->digest.update(options.bytes.get(), options.size);
+          }
+        },
+        [](uv_work_t* req, int status) {
+          auto request = reinterpret_cast<DigestRequest*>(req->data);
+          const auto err = status < 0 ? status : request->err;
+          const auto algorithm = crypto::Digest::getAlgorithmName(request->options.algorithm);
+
+          if (err < 0) {
+            const auto json = JSON::Object::Entries {
+              {"source", "crypto.digest"},
+              {"err", JSON::Object::Entries {
+                {"algorithm", algorithm},
+                {"type", "ErrnoError"},
+                {"code", uv_err_name(err)},
+                {"message", uv_strerror(err)}
+              }}
+            };
+
+            request->callback(request->seq, json, QueuedResponse{});
+            delete request;
+            return;
+          }
+
+          const auto json = JSON::Object::Entries {
+            {"source", "crypto.digest"},
+            {"data", JSON::Object::Entries {
+              {"algorithm", algorithm},
+              {"digest", request->digest.str()},
+              {"size", request->digest.length}
+            }}
+          };
+
+          request->callback(request->seq, json, QueuedResponse{});
+          delete request;
+        }
+      );
+
+      if (err < 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "crypto.digest"},
+          {"err", JSON::Object::Entries {
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(err)},
+            {"message", uv_strerror(err)}
+          }}
+        };
+
+        delete request;
+        callback(seq, json, QueuedResponse{});
+      }
+    });
+  }
+
+  struct RandomValuesRequest {
+    uv_work_t req;
+    String seq;
+    Crypto::Callback callback = nullptr;
+    SharedPointer<unsigned char[]> bytes = nullptr;
+    size_t size = 0;
+
+    RandomValuesRequest (
+      const String& seq,
+      size_t size,
+      const Crypto::Callback callback
+    ) : seq(seq),
+        callback(callback),
+        bytes(std::make_shared<unsigned char[]>(size)),
+        size(size)
+    {
+      this->req.data = this;
+    }
+
+    void reply () {
+      auto headers = http::Headers {{
+        {"content-type" ,"application/octet-stream"},
+        {"content-length", this->size}
+      }};
+
+      QueuedResponse queuedResponse;
+      queuedResponse.body = this->bytes;
+      queuedResponse.length = this->size;
+      queuedResponse.headers = headers;
+
+      this->callback(this->seq, JSON::Object{}, queuedResponse);
+    }
+  };
+
+  void Crypto::getRandomValues (
+    const String& seq,
+    size_t size,
+    const Callback callback
+  ) {
+    if (size > RANDOM_VALUES_MAX_SIZE) {
+      const auto json = JSON::Object::Entries {
+        {"source", "crypto.getRandomValues"},
+        {"err", JSON::Object::Entries {
+          {"type", "QuotaExceededError"},
+          {"message", "Requested size exceeds " + std::to_string(RANDOM_VALUES_MAX_SIZE) + " bytes"}
+        }}
+      };
+
+      return callback(seq, json, QueuedResponse{});
+    }
+
+    this->loop.dispatch([=, this]() {
+      auto request = new RandomValuesRequest(seq, size, callback);
+
+      // small requests are cheaper than a trip through the threadpool
+      if (size <= RANDOM_VALUES_INLINE_SIZE) {
+        crypto::getRandomValues(request->bytes.get(), request->size);
+        request->reply();
+        delete request;
+        return;
+      }
+
+      const auto err = uv_queue_work(
+        this->loop.get(),
+        &request->req,
+        [](uv_work_t* req) {
+          auto request = reinterpret_cast<RandomValuesRequest*>(req->data);
+          crypto::getRandomValues(request->bytes.get(), request->size);
+        },
+        [](uv_work_t* req, int status) {
+          auto request = reinterpret_cast<RandomValuesRequest*>(req->data);
+
+          if (status < 0) {
+            const auto json = JSON::Object::Entries {
+              {"source", "crypto.getRandomValues"},
+              {"err", JSON::Object::Entries {
+                {"type", "ErrnoError"},
+                {"code", uv_err_name(status)},
+                {"message", uv_strerror(status)}
+              }}
+            };
+
+            request->callback(request->seq, json, QueuedResponse{});
+          } else {
+            request->reply();
+          }
+
+          delete request;
+        }
+      );
+
+      if (err < 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "crypto.getRandomValues"},
+          {"err", JSON::Object::Entries {
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(err)},
+            {"message", uv_strerror(err)}
+          }}
+        };
+
+        delete request;
+        callback(seq, json, QueuedResponse{});
+      }
+    });
+  }
+}
@@ -0,0 +1,40 @@
+#ifndef SOCKET_RUNTIME_CORE_SERVICES_CRYPTO_H
+#define SOCKET_RUNTIME_CORE_SERVICES_CRYPTO_H
+
+#include "../../core.hh"
+#include "../../crypto.hh"
+#include "../../ipc.hh"
+
+namespace ssc::runtime::core::services {
+  class Crypto : public core::Service {
+    public:
+      using ID = uint64_t;
+
+      // files are read in blocks of this size on the libuv threadpool
+      static constexpr size_t DIGEST_READ_BUFFER_SIZE = 1024 * 1024;
+      // progress is reported after at least this many bytes were hashed
+      static constexpr size_t DIGEST_PROGRESS_INTERVAL = 16 * 1024 * 1024;
+      // random values up to this size are generated on the loop thread
+      static constexpr size_t RANDOM_VALUES_INLINE_SIZE = 64 * 1024;
+      static constexpr size_t RANDOM_VALUES_MAX_SIZE = 64 * 1024 * 1024;
+
+      struct DigestOptions {
+        crypto::Digest::Algorithm algorithm = crypto::Digest::Algorithm::SHA256;
+        // an open `FS` descriptor, a path, or bytes are hashed in that order
+        ID descriptor = 0;
+        String path;
+        SharedPointer<unsigned char[]> bytes = nullptr;
+        size_t size = 0;
+        // when not zero, progress is posted with this id
+        ID progress = 0;
+      };
+
+      Crypto (const Options& options)
+        : core::Service(options)
+      {}
+
+      void digest (const ipc::Message::Seq&, const DigestOptions&, const Callback);
+      void getRandomValues (const ipc::Message::Seq&, size_t, const Callback);
+  };
+}
+#endif
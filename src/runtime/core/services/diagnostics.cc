@@ -1,3 +1,5 @@
+#include "../../runtime.hh"
+
 #include "diagnostics.hh"
 #include "../services.hh"
 
@@ -19,10 +21,18 @@ namespace ssc::runtime::core::services {
 
       // queued responses diagnostics
       do {
-        Lock lock(this->services.mutex);
-        query.queuedResponses.handles.count = this->context.queuedResponses.size();
-        for (const auto& entry : this->context.queuedResponses) {
-          query.queuedResponses.handles.ids.push_back(entry.first);
+        const auto& queuedResponses = this->context.queuedResponses;
+        const auto& counters = queuedResponses.counters;
+        query.queuedResponses.handles.ids = queuedResponses.ids();
+        query.queuedResponses.handles.count = query.queuedResponses.handles.ids.size();
+        query.queuedResponses.bytes = queuedResponses.bytes();
+        query.queuedResponses.expirations = counters.expirations;
+        query.queuedResponses.evictions = counters.evictions;
+        query.queuedResponses.hits = counters.hits;
+        query.queuedResponses.misses = counters.misses;
+        query.queuedResponses.maxHitLatency = counters.maxHitLatency;
+        if (query.queuedResponses.hits > 0) {
+          query.queuedResponses.averageHitLatency = counters.hitLatency / query.queuedResponses.hits;
         }
       } while (0);
 
@@ -101,6 +111,28 @@ namespace ssc::runtime::core::services {
         }
       } while (0);
 
+      // service worker
+      do {
+        auto& manager = this->context.getRuntime()->serviceWorkerManager;
+        Lock lock(manager.mutex);
+        for (const auto& entry : manager.servers) {
+          auto& container = entry.second->container;
+          Lock lock(container.mutex);
+
+          query.serviceWorker.fetches.handles.count += container.fetches.size();
+          for (const auto& fetch : container.fetches) {
+            query.serviceWorker.fetches.handles.ids.push_back(fetch.first);
+          }
+
+          for (const auto& pending : container.pendingFetches) {
+            query.serviceWorker.pendingFetches.handles.count += pending.second.size();
+            for (const auto id : pending.second) {
+              query.serviceWorker.pendingFetches.handles.ids.push_back(id);
+            }
+          }
+        }
+      } while (0);
+
       // uv
       do {
         Lock lock(this->loop.mutex);
@@ -117,9 +149,18 @@ namespace ssc::runtime::core::services {
   void Diagnostics::query (
     const String& seq,
     const Callback callback
+  ) const {
+    this->query(seq, ipc::Router::Stats {}, callback);
+  }
+
+  void Diagnostics::query (
+    const String& seq,
+    const ipc::Router::Stats& routes,
+    const Callback callback
   ) const {
     this->loop.dispatch([=, this] () {
-      this->query([=] (const auto query) {
+      this->query([=] (auto query) {
+        query.ipc.routes = routes;
         auto json = JSON::Object::Entries {
           {"source", "diagnostics.query"},
           {"data", query.json()}
@@ -144,7 +185,16 @@ namespace ssc::runtime::core::services {
 
   JSON::Object Diagnostics::QueuedResponsesDiagnostic::json () const {
     return JSON::Object::Entries {
-      {"handles", this->handles.json()}
+      {"handles", this->handles.json()},
+      {"bytes", this->bytes},
+      {"expirations", this->expirations},
+      {"evictions", this->evictions},
+      {"hits", this->hits},
+      {"misses", this->misses},
+      {"hitLatency", JSON::Object::Entries {
+        {"average", this->averageHitLatency},
+        {"max", this->maxHitLatency}
+      }}
     };
   }
 
@@ -224,6 +274,35 @@ namespace ssc::runtime::core::services {
     };
   }
 
+  JSON::Object Diagnostics::ServiceWorkerDiagnostic::json () const {
+    return JSON::Object::Entries {
+      {"fetches", this->fetches.json()},
+      {"pendingFetches", this->pendingFetches.json()}
+    };
+  }
+
+  JSON::Object Diagnostics::ServiceWorkerDiagnostic::FetchesDiagnostic::json () const {
+    return JSON::Object::Entries {
+      {"handles", this->handles.json()}
+    };
+  }
+
+  JSON::Object Diagnostics::ServiceWorkerDiagnostic::PendingFetchesDiagnostic::json () const {
+    return JSON::Object::Entries {
+      {"handles", this->handles.json()}
+    };
+  }
+
+  JSON::Object Diagnostics::IPCDiagnostic::json () const {
+    auto routes = JSON::Object {};
+    for (const auto& entry : this->routes) {
+      routes[entry.first] = entry.second.json();
+    }
+    return JSON::Object::Entries {
+      {"routes", routes}
+    };
+  }
+
   JSON::Object Diagnostics::QueryDiagnostic::json () const {
     return JSON::Object::Entries {
       {"queuedResponses", this->queuedResponses.json()},
@@ -233,7 +312,9 @@ namespace ssc::runtime::core::services {
       {"timers", this->timers.json()},
       {"udp", this->udp.json()},
       {"uv", this->uv.json()},
-      {"conduit", this->conduit.json()}
+      {"conduit", this->conduit.json()},
+      {"serviceWorker", this->serviceWorker.json()},
+      {"ipc", this->ipc.json()}
     };
   }
 }
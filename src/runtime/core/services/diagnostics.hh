@@ -28,6 +28,14 @@ namespace ssc::runtime::core::services {
 
       struct QueuedResponsesDiagnostic : public Diagnostic {
         Handles handles;
+        size_t bytes = 0; // live bytes of queued response bodies
+        uint64_t expirations = 0;
+        uint64_t evictions = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        // average and maximum time (in milliseconds) until a response is taken
+        uint64_t averageHitLatency = 0;
+        uint64_t maxHitLatency = 0;
         JSON::Object json () const override;
       };
 
@@ -97,6 +105,29 @@ namespace ssc::runtime::core::services {
         JSON::Object json () const override;
       };
 
+      struct ServiceWorkerDiagnostic : public Diagnostic {
+        struct FetchesDiagnostic : public Diagnostic {
+          Handles handles;
+          JSON::Object json () const override;
+        };
+
+        struct PendingFetchesDiagnostic : public Diagnostic {
+          Handles handles;
+          JSON::Object json () const override;
+        };
+
+        FetchesDiagnostic fetches;
+        // fetches waiting for their registration to activate
+        PendingFetchesDiagnostic pendingFetches;
+        JSON::Object json () const override;
+      };
+
+      struct IPCDiagnostic : public Diagnostic {
+        // counters of the routes called on the querying router
+        ipc::Router::Stats routes;
+        JSON::Object json () const override;
+      };
+
       struct QueryDiagnostic : public Diagnostic {
         QueuedResponsesDiagnostic queuedResponses;
         ChildProcessDiagnostic childProcess;
@@ -106,6 +137,8 @@ namespace ssc::runtime::core::services {
         UDPDiagnostic udp;
         UVDiagnostic uv;
         ConduitDiagnostic conduit;
+        ServiceWorkerDiagnostic serviceWorker;
+        IPCDiagnostic ipc;
 
         JSON::Object json () const override;
       };
@@ -118,6 +151,7 @@ namespace ssc::runtime::core::services {
 
       void query (const QueryCallback) const;
       void query (const ipc::Message::Seq&, const Callback) const;
+      void query (const ipc::Message::Seq&, const ipc::Router::Stats&, const Callback) const;
   };
 }
 #endif
@@ -15,15 +15,158 @@ namespace ssc::runtime::core::services {
   #if !SOCKET_RUNTIME_PLATFORM_IOS
     Lock lock(this->mutex);
     for (const auto& entry : this->handles) {
-      auto process = entry.second;
-      process->kill();
-      process->wait();
+      // children keep themselves alive until their handles are closed
+      entry.second->kill(SIGTERM);
     }
+
+    for (const auto& entry : this->streams) {
+      for (const auto stream : { &entry.second->stdoutStream, &entry.second->stderrStream }) {
+        if (stream->timer > 0) {
+          this->timers.clearTimeout(stream->timer);
+        }
+      }
+
+      if (entry.second->expiry > 0) {
+        this->timers.clearTimeout(entry.second->expiry);
+      }
+    }
+
+    this->streams.clear();
   #endif
 
     this->handles.clear();
   }
 
+  void Process::enqueue (
+    SharedPointer<Streams> streams,
+    Stream* stream,
+    const unsigned char* bytes,
+    size_t size
+  ) {
+    // output of a cancelled stream is discarded
+    if (stream->finished || size == 0) {
+      return;
+    }
+
+    stream->buffer.append(reinterpret_cast<const char*>(bytes), size);
+
+    // small reads are coalesced until a chunk is full or the delay passed
+    if (stream->buffer.size() >= STREAM_CHUNK_SIZE) {
+      this->flush(streams, stream);
+    } else if (stream->timer == 0) {
+      stream->timer = this->timers.setTimeout(STREAM_FLUSH_DELAY, [=, this] () {
+        // the timers service may run on another loop, the streams belong to
+        // this one, `flush()` forgets the timer
+        this->loop.dispatch([=, this] () {
+          this->flush(streams, stream);
+        });
+      });
+    }
+
+    this->throttle(streams);
+  }
+
+  void Process::flush (SharedPointer<Streams> streams, Stream* stream) {
+    if (stream->timer > 0) {
+      this->timers.clearTimeout(stream->timer);
+      stream->timer = 0;
+    }
+
+    // output is buffered until a stream is attached
+    if (stream->callback == nullptr || stream->finished) {
+      return;
+    }
+
+    const auto finished = stream->ended;
+
+    if (stream->buffer.size() == 0 && !finished) {
+      return;
+    }
+
+    const auto chunk = std::make_shared<String>(std::move(stream->buffer));
+    const auto callback = stream->callback;
+
+    stream->buffer.clear();
+    stream->inflight += chunk->size();
+    stream->finished = finished;
+
+    // chunks are written on the main thread, the bytes they hold count
+    // towards the pending output until they were written
+    this->dispatch([=, this] () {
+      const auto written = (*callback)(
+        reinterpret_cast<const unsigned char*>(chunk->data()),
+        chunk->size(),
+        finished
+      );
+
+      this->loop.dispatch([=, this] () {
+        stream->inflight -= chunk->size();
+
+        // the request was cancelled, nobody reads the output anymore
+        if (!written && !stream->finished) {
+          stream->finished = true;
+          stream->buffer.clear();
+        }
+
+        if (streams->stdoutStream.finished && streams->stderrStream.finished) {
+          this->release(streams);
+        } else {
+          this->throttle(streams);
+        }
+      }, loop::Loop::Priority::High);
+    });
+  }
+
+  void Process::throttle (SharedPointer<Streams> streams) {
+    SharedPointer<process::Child> child = nullptr;
+    size_t pending = 0;
+
+    for (const auto stream : { &streams->stdoutStream, &streams->stderrStream }) {
+      pending += stream->buffer.size() + stream->inflight;
+    }
+
+    do {
+      Lock lock(this->mutex);
+      if (this->handles.contains(streams->id)) {
+        child = this->handles.at(streams->id);
+      }
+    } while (0);
+
+    if (child == nullptr) {
+      return;
+    }
+
+    // the child blocks on its pipes while reading is paused
+    if (!streams->throttled && pending >= STREAM_HIGH_WATER_MARK) {
+      streams->throttled = true;
+      child->pause();
+    } else if (streams->throttled && pending <= STREAM_LOW_WATER_MARK) {
+      streams->throttled = false;
+      if (!streams->paused) {
+        child->resume();
+      }
+    }
+  }
+
+  void Process::release (SharedPointer<Streams> streams) {
+    for (const auto stream : { &streams->stdoutStream, &streams->stderrStream }) {
+      if (stream->timer > 0) {
+        this->timers.clearTimeout(stream->timer);
+        stream->timer = 0;
+      }
+    }
+
+    if (streams->expiry > 0) {
+      this->timers.clearTimeout(streams->expiry);
+      streams->expiry = 0;
+    }
+
+    Lock lock(this->mutex);
+    if (this->streams.contains(streams->id) && this->streams.at(streams->id) == streams) {
+      this->streams.erase(streams->id);
+    }
+  }
+
   void Process::kill (
     const String& seq,
     ID id,
@@ -41,9 +184,16 @@ namespace ssc::runtime::core::services {
     return callback(seq, json, QueuedResponse{});
   #else
     this->loop.dispatch([=, this] {
-      Lock lock(this->mutex);
+      SharedPointer<process::Child> child = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        if (this->handles.contains(id)) {
+          child = this->handles.at(id);
+        }
+      } while (0);
 
-      if (!this->handles.contains(id)) {
+      if (child == nullptr) {
         const auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
@@ -52,22 +202,11 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        return this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
+        return callback(seq, json, QueuedResponse{});
       }
 
-      auto process = this->handles.at(id);
-
-      #if SOCKET_RUNTIME_PLATFORM_WINDOWS
-        process->kill();
-      #else
-        ::kill(-process->id, signal);
-      #endif
-
-      return this->loop.dispatch([=, this] () {
-        callback(seq, JSON::Object{}, QueuedResponse{});
-      });
+      child->kill(signal);
+      callback(seq, JSON::Object{}, QueuedResponse{});
     });
   #endif
   }
@@ -100,129 +239,107 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
-        return;
+        return callback(seq, json, QueuedResponse{});
       }
 
-      SharedPointer<runtime::Process> process = nullptr;
-      Timers::ID timer;
+      // output is kept byte exact, it is only encoded for the reply
+      const auto stdoutBuffer = std::make_shared<String>();
+      const auto stderrBuffer = std::make_shared<String>();
+      const auto timer = std::make_shared<Timers::ID>(0);
+
+      const auto child = std::make_shared<process::Child>(this->loop, process::Child::Options {
+        .command = trim(join(args, " ")),
+        .cwd = options.cwd,
+        .env = options.env,
+        .allowStdin = false,
+        .allowStdout = options.allowStdout,
+        .allowStderr = options.allowStderr,
+        .readMode = process::Child::ReadMode::Raw,
+        .onStdout = [stdoutBuffer](const unsigned char* bytes, size_t size) {
+          stdoutBuffer->append(reinterpret_cast<const char*>(bytes), size);
+        },
+        .onStderr = [stderrBuffer](const unsigned char* bytes, size_t size) {
+          stderrBuffer->append(reinterpret_cast<const char*>(bytes), size);
+        },
+        .onClose = [=, this](int64_t code, int signal) {
+          process::Child::PID pid = 0;
 
-      const auto command = args.size() > 0 ? args.at(0) : String("");
-      const auto argv = join(
-        args.size() > 1
-          ? Vector<String>{ args.begin() + 1, args.end() }
-          : Vector<String>{},
-        " "
-      );
+          do {
+            Lock lock(this->mutex);
+            // timed out (and already replied to)
+            if (!this->handles.contains(id)) {
+              return;
+            }
 
-      auto stdoutBuffer = new StringStream;
-      auto stderrBuffer = new StringStream;
+            pid = this->handles.at(id)->id;
+            this->handles.erase(id);
+          } while (0);
 
-      const auto onStdout = [=](const String& output) mutable {
-        if (!options.allowStdout || output.size() == 0) {
-          return;
-        }
+          if (*timer > 0) {
+            this->timers.clearTimeout(*timer);
+          }
 
-        if (stdoutBuffer != nullptr) {
-          *stdoutBuffer << String(output);
-        }
-      };
+          const auto json = JSON::Object::Entries {
+            {"source", "child_process.exec"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(id)},
+              {"pid", std::to_string(pid)},
+              {"stdout", encodeURIComponent(*stdoutBuffer)},
+              {"stderr", encodeURIComponent(*stderrBuffer)},
+              {"code", code}
+            }}
+          };
 
-      const auto onStderr = [=](const String& output) mutable {
-        if (!options.allowStderr || output.size() == 0) {
-          return;
+          callback(seq, json, QueuedResponse{});
         }
+      });
 
-        if (stderrBuffer != nullptr) {
-          *stderrBuffer << String(output);
-        }
-      };
+      const auto err = child->spawn();
 
-      const auto onExit = [=, this](const String& output) mutable {
-        if (timer > 0) {
-          this->timers.clearTimeout(timer);
-        }
+      if (err != 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.exec"},
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(err)},
+            {"message", uv_strerror(err)}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      this->handles.insert_or_assign(id, child);
+
+      if (options.timeout > 0) {
+        *timer = this->timers.setTimeout(options.timeout, [=, this] () {
+          // the timers service may run on another loop, the child and its
+          // handle belong to this one
+          this->loop.dispatch([=, this] () {
+            do {
+              Lock lock(this->mutex);
+              if (!this->handles.contains(id)) {
+                return;
+              }
+
+              this->handles.erase(id);
+            } while (0);
 
-        this->loop.dispatch([=, this] () mutable {
-          Lock lock(this->mutex);
-          if (this->handles.contains(id)) {
-            auto process = this->handles.at(id);
-            const auto pid = process->id;
-            const auto code = process->wait();
             const auto json = JSON::Object::Entries {
               {"source", "child_process.exec"},
-              {"data", JSON::Object::Entries {
+              {"err", JSON::Object::Entries {
                 {"id", std::to_string(id)},
-                {"pid", std::to_string(pid)},
-                {"stdout", encodeURIComponent(stdoutBuffer->str())},
-                {"stderr", encodeURIComponent(stderrBuffer->str())},
-                {"code", code}
+                {"pid", std::to_string(child->id)},
+                {"stdout", encodeURIComponent(*stdoutBuffer)},
+                {"stderr", encodeURIComponent(*stderrBuffer)},
+                {"code", "ETIMEDOUT"}
               }}
             };
 
-            delete stdoutBuffer;
-            delete stderrBuffer;
-
-            stdoutBuffer = nullptr;
-            stderrBuffer = nullptr;
-
-            this->loop.dispatch([=, this] () {
-              callback(seq, json, QueuedResponse{});
-            });
-
-            this->handles.erase(id);
-          }
-        });
-      };
-
-      process.reset(new runtime::Process(
-        command,
-        argv,
-        options.env,
-        options.cwd,
-        onStdout,
-        onStderr,
-        onExit,
-        false
-      ));
-
-      this->handles.insert_or_assign(id, process);
-
-      const auto pid = process->open();
-
-      if (options.timeout > 0) {
-        timer = this->timers.setTimeout(options.timeout, [=, this] () mutable {
-          Lock lock(this->mutex);
-          const auto json = JSON::Object::Entries {
-            {"source", "child_process.exec"},
-            {"err", JSON::Object::Entries {
-              {"id", std::to_string(id)},
-              {"pid", std::to_string(pid)},
-              {"stdout", encodeURIComponent(stdoutBuffer->str())},
-              {"stderr", encodeURIComponent(stderrBuffer->str())},
-              {"code", "ETIMEDOUT"}
-            }}
-          };
-
-          this->loop.dispatch([=, this] {
+            child->kill(options.killSignal > 0 ? options.killSignal : SIGTERM);
             callback(seq, json, QueuedResponse{});
           });
-
-        #if SOCKET_RUNTIME_PLATFORM_WINDOWS
-          process->kill();
-        #else
-          ::kill(-process->id, options.killSignal);
-        #endif
-
-          delete stdoutBuffer;
-          delete stderrBuffer;
-
-          stdoutBuffer = nullptr;
-          stderrBuffer = nullptr;
-
-          this->handles.erase(id);
         });
       }
     });
@@ -257,150 +374,155 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        return this->loop.dispatch([=, this] () {
-          callback(seq, json, QueuedResponse{});
-        });
+        return callback(seq, json, QueuedResponse{});
       }
 
-      SharedPointer<runtime::Process> process = nullptr;
-
-      const auto command = args.size() > 0 ? args.at(0) : String("");
-      const auto argv = join(
-        args.size() > 1
-          ? Vector<String>{ args.begin() + 1, args.end() }
-          : Vector<String>{},
-        " "
-        );
-
-      const auto onStdout = [=](const String& output) {
-        if (!options.allowStdout || output.size() == 0) {
+      const auto onOutput = [=](const String& source, const unsigned char* bytes, size_t size) {
+        if (size == 0) {
           return;
         }
 
-        const auto bytes = new unsigned char[output.size()]{0};
         const auto headers = Headers {{
           {"content-type" ,"application/octet-stream"},
-          {"content-length", (int) output.size()}
+          {"content-length", (int) size}
         }};
 
-        memcpy(bytes, output.c_str(), output.size());
-
         QueuedResponse post;
         post.id = rand64();
-        post.body.reset(bytes);
-        post.length = (int) output.size();
+        post.body = SharedPointer<unsigned char[]>(new unsigned char[size]);
+        post.length = size;
         post.headers = headers.str();
 
+        memcpy(post.body.get(), bytes, size);
+
         const auto json = JSON::Object::Entries {
           {"source", "child_process.spawn"},
           {"data", JSON::Object::Entries {
             {"id", std::to_string(id)},
-            {"source", "stdout"}
+            {"source", source}
           }}
         };
 
         callback("-1", json, post);
       };
 
-      const auto onStderr = [=](const String& output) {
-        if (!options.allowStderr || output.size() == 0) {
-          return;
-        }
-
-        const auto bytes = new unsigned char[output.size()]{0};
-        const auto headers = Headers {{
-          {"content-type" ,"application/octet-stream"},
-          {"content-length", (int) output.size()}
-        }};
+      const auto streams = options.stream ? std::make_shared<Streams>() : nullptr;
 
-        memcpy(bytes, output.c_str(), output.size());
+      if (streams != nullptr) {
+        streams->id = id;
+        // pipes that are not opened never have output
+        streams->stdoutStream.finished = !options.allowStdout;
+        streams->stderrStream.finished = !options.allowStderr;
+      }
 
-        QueuedResponse post;
-        post.id = rand64();
-        post.body.reset(bytes);
-        post.length = (int) output.size();
-        post.headers = headers.str();
+      const auto child = std::make_shared<process::Child>(this->loop, process::Child::Options {
+        .command = trim(join(args, " ")),
+        .cwd = options.cwd,
+        .env = options.env,
+        .allowStdin = options.allowStdin,
+        .allowStdout = options.allowStdout,
+        .allowStderr = options.allowStderr,
+        // `child_process.spawn()` consumers expect output in lines, unless
+        // it is streamed as is
+        .readMode = streams != nullptr || options.raw
+          ? process::Child::ReadMode::Raw
+          : process::Child::ReadMode::Lines,
+        .onStdout = [=, this](const unsigned char* bytes, size_t size) {
+          if (streams != nullptr) {
+            return this->enqueue(streams, &streams->stdoutStream, bytes, size);
+          }
 
-        const auto json = JSON::Object::Entries {
-          {"source", "child_process.spawn"},
-          {"data", JSON::Object::Entries {
-            {"id", std::to_string(id)},
-            {"source", "stderr"}
-          }}
-        };
+          onOutput("stdout", bytes, size);
+        },
+        .onStderr = [=, this](const unsigned char* bytes, size_t size) {
+          if (streams != nullptr) {
+            return this->enqueue(streams, &streams->stderrStream, bytes, size);
+          }
 
-        callback("-1", json, post);
-      };
+          onOutput("stderr", bytes, size);
+        },
+        .onExit = [=](int64_t code, int signal) {
+          const auto json = JSON::Object::Entries {
+            {"source", "child_process.spawn"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(id)},
+              {"status", "exit"},
+              {"code", code}
+            }}
+          };
 
-      const auto onExit = [=, this](const String& output) {
-        const auto code = output.size() > 0 ? std::stoi(output) : 0;
-        const auto json = JSON::Object::Entries {
-          {"source", "child_process.spawn"},
-          {"data", JSON::Object::Entries {
-            {"id", std::to_string(id)},
-            {"status", "exit"},
-            {"code", code}
-          }}
-        };
+          callback("-1", json, QueuedResponse{});
+        },
+        .onClose = [=, this](int64_t code, int signal) {
+          const auto json = JSON::Object::Entries {
+            {"source", "child_process.spawn"},
+            {"data", JSON::Object::Entries {
+              {"id", std::to_string(id)},
+              {"status", "close"},
+              {"code", code}
+            }}
+          };
 
-        callback("-1", json, QueuedResponse{});
+          callback("-1", json, QueuedResponse{});
 
-        this->loop.dispatch([=, this] {
-          SharedPointer<runtime::Process> process = nullptr;
           do {
             Lock lock(this->mutex);
-            if (!this->handles.contains(id)) {
-              return;
-            }
-
-            process = this->handles.at(id);
+            this->handles.erase(id);
           } while (0);
 
-          const auto code = process->wait();
+          if (streams == nullptr) {
+            return;
+          }
 
-          this->loop.dispatch([=, this] {
-            const auto json = JSON::Object::Entries {
-              {"source", "child_process.spawn"},
-              {"data", JSON::Object::Entries {
-                {"id", std::to_string(id)},
-                {"status", "close"},
-                {"code", code}
-              }}
-            };
+          for (const auto stream : { &streams->stdoutStream, &streams->stderrStream }) {
+            stream->ended = true;
+            this->flush(streams, stream);
+          }
 
-            callback("-1", json, QueuedResponse{});
+          if (streams->stdoutStream.finished && streams->stderrStream.finished) {
+            return this->release(streams);
+          }
 
-            Lock lock(this->mutex);
-            this->handles.erase(id);
+          // output that is never streamed expires like a queued response
+          streams->expiry = this->timers.setTimeout(QueuedResponses::DEFAULT_TTL, [=, this] () {
+            streams->expiry = 0;
+            this->release(streams);
           });
-        });
-      };
+        }
+      });
+
+      const auto err = child->spawn();
+
+      if (err != 0) {
+        const auto json = JSON::Object::Entries {
+          {"source", "child_process.spawn"},
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "ErrnoError"},
+            {"code", uv_err_name(err)},
+            {"message", uv_strerror(err)}
+          }}
+        };
 
-      process.reset(new runtime::Process(
-        command,
-        argv,
-        options.env,
-        options.cwd,
-        onStdout,
-        onStderr,
-        onExit,
-        options.allowStdin
-      ));
+        return callback(seq, json, QueuedResponse{});
+      }
 
-      this->handles.insert_or_assign(id, process);
+      this->handles.insert_or_assign(id, child);
+
+      if (streams != nullptr) {
+        this->streams.insert_or_assign(id, streams);
+      }
 
-      const auto pid = process->open();
       const auto json = JSON::Object::Entries {
         {"source", "child_process.spawn"},
         {"data", JSON::Object::Entries {
           {"id", std::to_string(id)},
-          {"pid", std::to_string(pid)}
+          {"pid", std::to_string(child->id)},
+          {"stream", streams != nullptr}
         }}
       };
 
-      return this->loop.dispatch([=, this] () {
-        callback(seq, json, QueuedResponse{});
-      });
+      callback(seq, json, QueuedResponse{});
     });
   #endif
   }
@@ -423,9 +545,16 @@ namespace ssc::runtime::core::services {
     return callback(seq, json, QueuedResponse{});
   #else
     this->loop.dispatch([=, this] {
-      Lock lock(this->mutex);
+      SharedPointer<process::Child> child = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        if (this->handles.contains(id)) {
+          child = this->handles.at(id);
+        }
+      } while (0);
 
-      if (!this->handles.contains(id)) {
+      if (child == nullptr) {
         auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
@@ -437,11 +566,7 @@ namespace ssc::runtime::core::services {
         return callback(seq, json, QueuedResponse{});
       }
 
-      bool didWrite = false;
-
-      auto process = this->handles.at(id);
-
-      if (!process->openStdin) {
+      if (!child->options.allowStdin) {
         auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
@@ -450,46 +575,235 @@ namespace ssc::runtime::core::services {
           }}
         };
 
-        callback(seq, json, QueuedResponse{});
-        return;
+        return callback(seq, json, QueuedResponse{});
       }
 
-      try {
-        didWrite = process->write(buffer, size);
-      } catch (std::exception& e) {
+      // writes are terminated by a newline, like they always were
+      auto bytes = SharedPointer<unsigned char[]>(new unsigned char[size + 1]);
+      if (size > 0 && buffer != nullptr) {
+        memcpy(bytes.get(), buffer.get(), size);
+      }
+
+      bytes[size] = '\n';
+
+      const auto didWrite = child->write(bytes, size + 1, [=](int status) {
+        if (status < 0) {
+          const auto json = JSON::Object::Entries {
+            {"err", JSON::Object::Entries {
+              {"id", std::to_string(id)},
+              {"type", "ErrnoError"},
+              {"code", uv_err_name(status)},
+              {"message", uv_strerror(status)}
+            }}
+          };
+
+          return callback(seq, json, QueuedResponse{});
+        }
+
+        callback(seq, JSON::Object{}, QueuedResponse{});
+      });
+
+      if (!didWrite) {
         const auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
             {"type", "InternalError"},
-            {"message", e.what()}
+            {"message", "Failed to write to child process"}
           }}
         };
 
         callback(seq, json, QueuedResponse{});
-        return;
       }
+    });
+  #endif
+  }
 
-      if (!didWrite) {
+  void Process::stream (
+    const String& seq,
+    ID id,
+    const String& source,
+    const Callback callback
+  ) {
+  #if SOCKET_RUNTIME_PLATFORM_IOS
+    const auto json = JSON::Object::Entries {
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotSupportedError"},
+        {"message", "stream() is not supported"}
+      }}
+    };
+    return callback(seq, json, QueuedResponse{});
+  #else
+    this->loop.dispatch([=, this] {
+      SharedPointer<Streams> streams = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        if (this->streams.contains(id)) {
+          streams = this->streams.at(id);
+        }
+      } while (0);
+
+      if (streams == nullptr) {
         const auto json = JSON::Object::Entries {
           {"err", JSON::Object::Entries {
             {"id", std::to_string(id)},
-            {"type", process->lastWriteStatus != 0
-              ? "ErrnoError"
-              : "InternalError"
-            },
-            {"message", process->lastWriteStatus != 0
-              ? strerror(process->lastWriteStatus)
-              : "Failed to write to child process"
-            }
+            {"type", "NotFoundError"},
+            {"message", "A streamed process with that id does not exist"}
           }}
         };
 
-        callback(seq, json, QueuedResponse{});
-        return;
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      const auto stream = source == "stderr"
+        ? &streams->stderrStream
+        : &streams->stdoutStream;
+
+      if (stream->callback != nullptr || stream->finished) {
+        const auto json = JSON::Object::Entries {
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "InvalidStateError"},
+            {"message", "Child process " + source + " is already streamed"}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      QueuedResponse queuedResponse;
+      queuedResponse.headers.set("content-type", "application/octet-stream");
+      queuedResponse.chunkStreamCallback = std::make_shared<QueuedResponse::ChunkStreamCallback>();
+
+      // the reply is handled on the main thread, where the stream callback
+      // is set, before the stream is attached back on this loop
+      this->dispatch([=, this] () {
+        callback(seq, JSON::Object{}, queuedResponse);
+
+        this->loop.dispatch([=, this] () {
+          // the stream callback stays empty if the request went away
+          if (
+            *queuedResponse.chunkStreamCallback == nullptr ||
+            stream->callback != nullptr ||
+            stream->finished
+          ) {
+            return;
+          }
+
+          stream->callback = queuedResponse.chunkStreamCallback;
+          this->flush(streams, stream);
+          this->throttle(streams);
+        });
+      });
+    });
+  #endif
+  }
+
+  void Process::pause (
+    const String& seq,
+    ID id,
+    const Callback callback
+  ) {
+  #if SOCKET_RUNTIME_PLATFORM_IOS
+    const auto json = JSON::Object::Entries {
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotSupportedError"},
+        {"message", "pause() is not supported"}
+      }}
+    };
+    return callback(seq, json, QueuedResponse{});
+  #else
+    this->loop.dispatch([=, this] {
+      SharedPointer<process::Child> child = nullptr;
+      SharedPointer<Streams> streams = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        if (this->handles.contains(id)) {
+          child = this->handles.at(id);
+        }
+
+        if (this->streams.contains(id)) {
+          streams = this->streams.at(id);
+        }
+      } while (0);
+
+      if (child == nullptr) {
+        const auto json = JSON::Object::Entries {
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "NotFoundError"},
+            {"message", "A process with that id does not exist"}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      if (streams != nullptr) {
+        streams->paused = true;
+      }
+
+      child->pause();
+      callback(seq, JSON::Object{}, QueuedResponse{});
+    });
+  #endif
+  }
+
+  void Process::resume (
+    const String& seq,
+    ID id,
+    const Callback callback
+  ) {
+  #if SOCKET_RUNTIME_PLATFORM_IOS
+    const auto json = JSON::Object::Entries {
+      {"err", JSON::Object::Entries {
+        {"id", std::to_string(id)},
+        {"type", "NotSupportedError"},
+        {"message", "resume() is not supported"}
+      }}
+    };
+    return callback(seq, json, QueuedResponse{});
+  #else
+    this->loop.dispatch([=, this] {
+      SharedPointer<process::Child> child = nullptr;
+      SharedPointer<Streams> streams = nullptr;
+
+      do {
+        Lock lock(this->mutex);
+        if (this->handles.contains(id)) {
+          child = this->handles.at(id);
+        }
+
+        if (this->streams.contains(id)) {
+          streams = this->streams.at(id);
+        }
+      } while (0);
+
+      if (child == nullptr) {
+        const auto json = JSON::Object::Entries {
+          {"err", JSON::Object::Entries {
+            {"id", std::to_string(id)},
+            {"type", "NotFoundError"},
+            {"message", "A process with that id does not exist"}
+          }}
+        };
+
+        return callback(seq, json, QueuedResponse{});
+      }
+
+      if (streams != nullptr) {
+        streams->paused = false;
+      }
+
+      // reading stays paused while too much output is pending
+      if (streams == nullptr || !streams->throttled) {
+        child->resume();
       }
 
       callback(seq, JSON::Object{}, QueuedResponse{});
-      return;
     });
   #endif
   }
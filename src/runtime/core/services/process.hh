@@ -12,7 +12,16 @@ namespace ssc::runtime::core::services {
   class Process : public core::Service {
     public:
       using ID = uint64_t;
-      using Handles = Map<ID, SharedPointer<runtime::Process>>;
+      using Handles = Map<ID, SharedPointer<process::Child>>;
+
+      // streamed output is coalesced into chunks of at most this many bytes
+      static constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+      // coalesced output is flushed after this many milliseconds at most
+      static constexpr uint64_t STREAM_FLUSH_DELAY = 4;
+      // reading from a child is paused when this many bytes are pending
+      static constexpr size_t STREAM_HIGH_WATER_MARK = 1024 * 1024;
+      // and resumed when the pending bytes drain below this many
+      static constexpr size_t STREAM_LOW_WATER_MARK = 256 * 1024;
 
       struct SpawnOptions {
         String cwd;
@@ -20,6 +29,40 @@ namespace ssc::runtime::core::services {
         bool allowStdin = true;
         bool allowStdout = true;
         bool allowStderr = true;
+        // output is posted as raw chunks instead of line by line
+        bool raw = false;
+        // raw output is streamed with `child_process.stream` instead of
+        // being posted
+        bool stream = false;
+      };
+
+      /**
+       * The output of a child from one of its pipes, written in chunks to a
+       * `ChunkStreamCallback` on the main thread. Output is buffered until
+       * a stream is attached. All fields are owned by the service loop.
+       */
+      struct Stream {
+        using Callback = SharedPointer<QueuedResponse::ChunkStreamCallback>;
+        Callback callback = nullptr;
+        String buffer;
+        // bytes dispatched to the main thread and not written yet
+        size_t inflight = 0;
+        Timers::ID timer = 0;
+        // the pipe was closed, nothing more is buffered
+        bool ended = false;
+        // the last chunk was written, or the stream was cancelled
+        bool finished = false;
+      };
+
+      struct Streams {
+        ID id = 0;
+        Stream stdoutStream;
+        Stream stderrStream;
+        // reading was paused by the client
+        bool paused = false;
+        // reading was paused because too much output is pending
+        bool throttled = false;
+        Timers::ID expiry = 0;
       };
 
       struct ExecOptions {
@@ -36,6 +79,7 @@ namespace ssc::runtime::core::services {
       };
 
       Handles handles;
+      Map<ID, SharedPointer<Streams>> streams;
       Timers timers;
       Mutex mutex;
 
@@ -49,6 +93,15 @@ namespace ssc::runtime::core::services {
       void spawn (const ipc::Message::Seq&, ID, const Vector<String>, const SpawnOptions, const Callback);
       void kill (const ipc::Message::Seq&, ID, int, const Callback);
       void write (const ipc::Message::Seq&, ID, SharedPointer<unsigned char[]>, size_t, const Callback);
+      void stream (const ipc::Message::Seq&, ID, const String&, const Callback);
+      void pause (const ipc::Message::Seq&, ID, const Callback);
+      void resume (const ipc::Message::Seq&, ID, const Callback);
+
+    private:
+      void enqueue (SharedPointer<Streams>, Stream*, const unsigned char*, size_t);
+      void flush (SharedPointer<Streams>, Stream*);
+      void throttle (SharedPointer<Streams>);
+      void release (SharedPointer<Streams>);
   };
 }
 #endif
@@ -3,10 +3,15 @@
 using ssc::runtime::crypto::rand64;
 
 namespace ssc::runtime::core::services {
-  struct TimerToken {
-    Timers* timers = nullptr;
-    Timers::ID id = 0;
-  };
+  using Wheel = Timers::Wheel;
+
+  // the number of ticks spanned by a wheel level
+  static constexpr uint64_t getWheelLevelSpan (size_t level) {
+    return uint64_t(1) << (Wheel::SLOT_BITS * level);
+  }
+
+  // timers further out than the wheel spans are parked in its last level
+  static constexpr uint64_t WHEEL_MAX_DELTA = getWheelLevelSpan(Wheel::LEVELS) - 1;
 
   Timers::Timer::Timer (Timers* timers, ID id, Callback callback)
     : timers(timers),
@@ -14,6 +19,126 @@ namespace ssc::runtime::core::services {
       callback(callback)
   {}
 
+  Timers::Timer* Timers::Wheel::acquire () {
+    if (this->free == nullptr) {
+      auto chunk = std::make_unique<Timer[]>(POOL_CHUNK_SIZE);
+      for (size_t i = 0; i < POOL_CHUNK_SIZE; ++i) {
+        chunk[i].next = this->free;
+        this->free = &chunk[i];
+      }
+
+      this->pool.push_back(std::move(chunk));
+    }
+
+    auto timer = this->free;
+    this->free = timer->next;
+    *timer = Timer {};
+    return timer;
+  }
+
+  void Timers::Wheel::release (Timer* timer) {
+    this->remove(timer);
+    *timer = Timer {};
+    timer->next = this->free;
+    this->free = timer;
+  }
+
+  void Timers::Wheel::insert (Timer* timer) {
+    auto expires = timer->expires;
+    auto delta = expires > this->tick ? expires - this->tick : 0;
+    size_t level = 0;
+
+    if (delta > WHEEL_MAX_DELTA) {
+      delta = WHEEL_MAX_DELTA;
+      expires = this->tick + delta;
+    }
+
+    while (level < LEVELS - 1 && delta >= getWheelLevelSpan(level + 1)) {
+      level++;
+    }
+
+    // an expired timer lands in the slot of the current tick, which is
+    // only drained after a cascade in `Timers::advance()`
+    const auto index = delta == 0
+      ? this->tick & SLOT_MASK
+      : (expires >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    auto slot = &this->slots[level][index];
+
+    timer->level = level;
+    timer->slot = slot;
+    timer->prev = nullptr;
+    timer->next = *slot;
+
+    if (*slot != nullptr) {
+      (*slot)->prev = timer;
+    }
+
+    *slot = timer;
+    this->counts[level]++;
+  }
+
+  void Timers::Wheel::remove (Timer* timer) {
+    if (timer->slot == nullptr) {
+      return;
+    }
+
+    if (timer->prev != nullptr) {
+      timer->prev->next = timer->next;
+    } else {
+      *timer->slot = timer->next;
+    }
+
+    if (timer->next != nullptr) {
+      timer->next->prev = timer->prev;
+    }
+
+    if (timer->slot != &this->pending) {
+      this->counts[timer->level]--;
+    }
+
+    timer->slot = nullptr;
+    timer->next = nullptr;
+    timer->prev = nullptr;
+  }
+
+  void Timers::Wheel::cascade (size_t level) {
+    const auto index = (this->tick >> (SLOT_BITS * level)) & SLOT_MASK;
+    auto& slot = this->slots[level][index];
+
+    while (slot != nullptr) {
+      auto timer = slot;
+      this->remove(timer);
+      this->insert(timer);
+    }
+  }
+
+  uint64_t Timers::Wheel::next () const {
+    uint64_t next = UINT64_MAX;
+
+    if (this->counts[0] > 0) {
+      for (uint64_t i = 1; i <= SLOTS; ++i) {
+        if (this->slots[0][(this->tick + i) & SLOT_MASK] != nullptr) {
+          next = this->tick + i;
+          break;
+        }
+      }
+    }
+
+    // a timer on a higher level is due no earlier than the next cascade of
+    // its level, which may come before the next occupied level 0 slot, the
+    // spans nest so the lowest occupied level cascades first
+    for (size_t level = 1; level < LEVELS; ++level) {
+      if (this->counts[level] > 0) {
+        const auto span = getWheelLevelSpan(level);
+        next = std::min(next, ((this->tick / span) + 1) * span);
+        break;
+      }
+    }
+
+    return next;
+  }
+
   const Timers::ID Timers::createTimer (
     uint64_t timeout,
     uint64_t interval,
@@ -22,12 +147,13 @@ namespace ssc::runtime::core::services {
     Lock lock(this->mutex);
 
     auto id = rand64();
-    auto loop = this->loop.get();
-    auto handle = std::make_shared<Timer>(
-      this,
-      id,
-      callback
-    );
+    auto handle = this->wheel.acquire();
+
+    handle->timers = this;
+    handle->id = id;
+    handle->callback = callback;
+    handle->timeout = timeout;
+    handle->interval = interval;
 
     if (interval > 0) {
       handle->repeat = true;
@@ -37,63 +163,172 @@ namespace ssc::runtime::core::services {
 
     this->loop.dispatch([=, this]() {
       Lock lock(this->mutex);
-      if (this->handles.contains(id)) {
-        auto handle = this->handles.at(id);
-        const auto token = new TimerToken{ this, id };
-        uv_handle_set_data((uv_handle_t*) &handle->timer, (void*) token);
-        uv_timer_init(loop, &handle->timer);
-        uv_timer_start(
-          &handle->timer,
-          [](uv_timer_t* timer) {
-            const auto token = reinterpret_cast<TimerToken*>(uv_handle_get_data(reinterpret_cast<uv_handle_t*>(timer)));
-
-            // bad state
-            if (token == nullptr) {
-              uv_timer_stop(timer);
-              return;
-            }
-
-            Lock lock(token->timers->mutex);
-            const auto id = token->id;
-
-            // cancelled (removed from 'handles')
-            if (!token->timers->handles.contains(id)) {
-              delete token;
-              uv_timer_stop(timer);
-              return;
-            }
-
-            auto handle = token->timers->handles.at(id);
-
-            // bad ref
-            if (handle == nullptr) {
-              delete token;
-              uv_timer_stop(timer);
-              return;
-            }
-
-            // `callback` to timer callback is a "cancel" function
-            handle->callback([=] () {
-              token->timers->cancelTimer(id);
-              delete token;
-            });
-
-            if (!handle->repeat) {
-              if (token->timers->handles.contains(id)) {
-                token->timers->handles.erase(id);
-                delete token;
-              }
-            }
-          },
-          timeout,
-          interval
-        );
+      auto loop = this->loop.get();
+
+      if (!this->wheel.isInitialized) {
+        uv_timer_init(loop, &this->wheel.timer);
+        uv_handle_set_data(reinterpret_cast<uv_handle_t*>(&this->wheel.timer), this);
+        this->wheel.tick = uv_now(loop);
+        this->wheel.isInitialized = true;
+      }
+
+      // cancelled before it was scheduled
+      if (!this->handles.contains(id)) {
+        return;
       }
+
+      auto handle = this->handles.at(id);
+
+      // expire what is due before the new timer is placed relative to now
+      this->advance();
+
+      if (handle->timeout == 0) {
+        handle->slot = &this->wheel.pending;
+        handle->next = this->wheel.pending;
+        if (this->wheel.pending != nullptr) {
+          this->wheel.pending->prev = handle;
+        }
+        this->wheel.pending = handle;
+      } else {
+        handle->expires = this->wheel.tick + handle->timeout;
+        this->wheel.insert(handle);
+      }
+
+      this->schedule();
     });
 
     return id;
   }
 
+  void Timers::advance () {
+    Lock lock(this->mutex);
+
+    if (!this->wheel.isInitialized) {
+      return;
+    }
+
+    const auto fire = [this](Timer* timer) {
+      const auto id = timer->id;
+      // the callback may cancel (and release) its own timer
+      const auto callback = timer->callback;
+
+      if (callback != nullptr) {
+        // `callback` to timer callback is a "cancel" function
+        callback([this, id] () {
+          this->cancelTimer(id);
+        });
+      }
+
+      if (!this->handles.contains(id) || this->handles.at(id) != timer) {
+        return;
+      }
+
+      if (timer->repeat) {
+        timer->expires = this->wheel.tick + std::max(timer->interval, uint64_t(1));
+        this->wheel.insert(timer);
+      } else {
+        this->handles.erase(id);
+        this->wheel.release(timer);
+      }
+    };
+
+    // zero delay timers run before anything due on the wheel, like
+    // zero delay libuv timers run on the next loop iteration
+    while (this->wheel.pending != nullptr) {
+      auto timer = this->wheel.pending;
+      this->wheel.remove(timer);
+      fire(timer);
+    }
+
+    const auto now = uv_now(this->loop.get());
+
+    while (this->wheel.tick < now) {
+      size_t level = 0;
+      while (level < Wheel::LEVELS && this->wheel.counts[level] == 0) {
+        level++;
+      }
+
+      // nothing is due until `now`, or until the next cascade of the lowest
+      // occupied level, so the ticks in between are skipped
+      if (level == Wheel::LEVELS) {
+        this->wheel.tick = now;
+        break;
+      }
+
+      const auto span = getWheelLevelSpan(level);
+      const auto target = level == 0
+        ? this->wheel.tick + 1
+        : ((this->wheel.tick / span) + 1) * span;
+
+      if (target > now) {
+        this->wheel.tick = now;
+        break;
+      }
+
+      this->wheel.tick = target;
+
+      const auto index = this->wheel.tick & Wheel::SLOT_MASK;
+
+      if (index == 0) {
+        for (size_t cascaded = 1; cascaded < Wheel::LEVELS; ++cascaded) {
+          this->wheel.cascade(cascaded);
+          if (((this->wheel.tick >> (Wheel::SLOT_BITS * cascaded)) & Wheel::SLOT_MASK) != 0) {
+            break;
+          }
+        }
+      }
+
+      auto& slot = this->wheel.slots[0][index];
+      while (slot != nullptr) {
+        auto timer = slot;
+        this->wheel.remove(timer);
+
+        // parked beyond the span of the wheel
+        if (timer->expires > this->wheel.tick) {
+          this->wheel.insert(timer);
+        } else {
+          fire(timer);
+        }
+      }
+    }
+  }
+
+  void Timers::schedule () {
+    Lock lock(this->mutex);
+
+    if (!this->wheel.isInitialized) {
+      return;
+    }
+
+    uint64_t delay = 0;
+
+    if (this->wheel.pending == nullptr) {
+      const auto next = this->wheel.next();
+      const auto now = uv_now(this->loop.get());
+
+      if (next == UINT64_MAX) {
+        uv_timer_stop(&this->wheel.timer);
+        return;
+      }
+
+      delay = next > now ? next - now : 0;
+    }
+
+    uv_timer_start(
+      &this->wheel.timer,
+      [](uv_timer_t* handle) {
+        auto timers = reinterpret_cast<Timers*>(uv_handle_get_data(reinterpret_cast<uv_handle_t*>(handle)));
+        if (timers != nullptr) {
+          Lock lock(timers->mutex);
+          timers->advance();
+          timers->schedule();
+        }
+      },
+      delay,
+      0
+    );
+  }
+
   bool Timers::cancelTimer (const ID id) {
     Lock lock(this->mutex);
 
@@ -103,8 +338,9 @@ namespace ssc::runtime::core::services {
 
     auto handle = this->handles.at(id);
     handle->cancelled = true;
-    uv_timer_stop(&handle->timer);
     this->handles.erase(id);
+    // the wheel timer is left running, waking up early is harmless
+    this->wheel.release(handle);
     return true;
   }
 
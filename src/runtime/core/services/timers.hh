@@ -21,14 +21,58 @@ namespace ssc::runtime::core::services {
         Callback callback = nullptr;
         bool repeat = false;
         bool cancelled = false;
-        uv_timer_t timer;
-        Type type;
+        uint64_t timeout = 0;
+        uint64_t interval = 0;
+        Type type = Type::Timeout;
+
+        // intrusive links into a wheel slot, or into the free list
+        uint64_t expires = 0;
+        size_t level = 0;
+        Timer* next = nullptr;
+        Timer* prev = nullptr;
+        Timer** slot = nullptr;
+
+        Timer () = default;
         Timer (Timers* timers, ID id, Callback callback);
       };
 
-      using Handles = Map<ID, SharedPointer<Timer>>;
+      /**
+       * A hierarchical timer wheel with millisecond ticks driven by a single
+       * libuv timer. Each level has `SLOTS` slots that span `SLOTS` times the
+       * ticks of the level below it. Timers are inserted into and removed
+       * from a slot in constant time, and cascade to a lower level when the
+       * wheel reaches their slot.
+       */
+      struct Wheel {
+        static constexpr size_t LEVELS = 4;
+        static constexpr size_t SLOT_BITS = 6;
+        static constexpr size_t SLOTS = 1 << SLOT_BITS;
+        static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+
+        // timer nodes are allocated in chunks and reused
+        static constexpr size_t POOL_CHUNK_SIZE = 64;
+
+        Timer* slots[LEVELS][SLOTS] = {};
+        size_t counts[LEVELS] = {};
+        Timer* pending = nullptr;
+        Timer* free = nullptr;
+        Vector<UniquePointer<Timer[]>> pool;
+        uint64_t tick = 0;
+        uv_timer_t timer;
+        bool isInitialized = false;
+
+        Timer* acquire ();
+        void release (Timer*);
+        void insert (Timer*);
+        void remove (Timer*);
+        void cascade (size_t level);
+        uint64_t next () const;
+      };
+
+      using Handles = UnorderedMap<ID, Timer*>;
 
       Handles handles;
+      Wheel wheel;
       Mutex mutex;
 
       Timers (const Options& options)
@@ -44,6 +88,8 @@ namespace ssc::runtime::core::services {
       bool clearInterval (const ID id);
       bool clearImmediate (const ID id);
       const ID createTimer (uint64_t, uint64_t, const Callback);
+      void advance ();
+      void schedule ();
   };
 }
 #endif
@@ -4,8 +4,17 @@
 #include "platform.hh"
 
 #define SHA1_DIGEST_SIZE 20
+#define SHA256_DIGEST_SIZE 32
+#define BLAKE3_DIGEST_SIZE 32
+#define BLAKE3_MAX_DEPTH 54
 
 namespace ssc::runtime::crypto {
+  /**
+   * Fills `bytes` with cryptographically secure random bytes from a
+   * ChaCha20 generator that is local to the calling thread and seeded
+   * with OS entropy.
+   */
+  void getRandomValues (unsigned char* bytes, size_t size);
   uint64_t rand64 ();
 	int randint (int a, int b);
 	int randint (int a);
@@ -59,5 +68,126 @@ namespace ssc::runtime::crypto {
   const String sha1 (const String&);
   const String sha1 (const SharedPointer<unsigned char[]>&, size_t);
   const String sha1 (const unsigned char *, size_t);
+
+  struct SHA256Context {
+    uint32_t state[8];
+    uint64_t bitCount;
+    unsigned char buffer[64];
+  };
+
+  void sha256_init (SHA256Context *ctx);
+  void sha256_update (
+    SHA256Context *ctx,
+    const unsigned char *data,
+    size_t size
+  );
+
+  void sha256_final (
+    SHA256Context *ctx,
+    unsigned char out[SHA256_DIGEST_SIZE]
+  );
+
+  void sha256 (
+    const unsigned char *data,
+    size_t size,
+    unsigned char out[SHA256_DIGEST_SIZE]
+  );
+
+  // `true` if SHA-256 blocks are compressed with CPU instructions
+  // (SHA-NI on x86_64, the SHA2 extension on arm64)
+  bool sha256_accelerated ();
+
+  class SHA256 {
+    public:
+      SHA256Context context;
+      bool isFinalized = false;
+      unsigned char output[SHA256_DIGEST_SIZE] = {0};
+
+      SHA256 ();
+      SHA256 (const String&);
+      SHA256 (const SharedPointer<unsigned char[]>&, size_t);
+      SHA256 (const unsigned char *, size_t);
+
+      SHA256& update (const unsigned char *, size_t);
+      SHA256& update (const String&);
+      bool finalized () const;
+      Vector<uint8_t> finalize ();
+      String str ();
+      inline size_t size () const {
+        return SHA256_DIGEST_SIZE;
+      }
+  };
+
+  const String sha256 (const String&);
+  const String sha256 (const SharedPointer<unsigned char[]>&, size_t);
+  const String sha256 (const unsigned char *, size_t);
+
+  struct BLAKE3ChunkState {
+    uint32_t cv[8];
+    uint64_t counter;
+    unsigned char block[64];
+    uint8_t blockSize;
+    uint8_t blocksCompressed;
+  };
+
+  struct BLAKE3Context {
+    BLAKE3ChunkState chunk;
+    // chaining values of completed subtrees, one per level at most
+    uint32_t stack[BLAKE3_MAX_DEPTH][8];
+    uint8_t stackSize;
+  };
+
+  void blake3_init (BLAKE3Context *ctx);
+  void blake3_update (
+    BLAKE3Context *ctx,
+    const unsigned char *data,
+    size_t size
+  );
+
+  void blake3_final (
+    BLAKE3Context *ctx,
+    unsigned char out[BLAKE3_DIGEST_SIZE]
+  );
+
+  void blake3 (
+    const unsigned char *data,
+    size_t size,
+    unsigned char out[BLAKE3_DIGEST_SIZE]
+  );
+
+  /**
+   * An incremental hash of one of the supported algorithms.
+   */
+  class Digest {
+    public:
+      enum class Algorithm {
+        SHA1,
+        SHA256,
+        BLAKE3
+      };
+
+      // gets an algorithm by name (`sha1`, `sha-256`, `blake3`, ...),
+      // returns `false` for an unsupported algorithm
+      static bool getAlgorithm (const String&, Algorithm&);
+      static const String getAlgorithmName (Algorithm);
+
+      Algorithm algorithm;
+      bool isFinalized = false;
+      size_t length = 0;
+
+      Digest (Algorithm);
+      Digest& update (const unsigned char *, size_t);
+      Digest& update (const String&);
+      bool finalized () const;
+      Vector<uint8_t> finalize ();
+      String str ();
+      size_t size () const;
+
+    private:
+      SHA1Context sha1;
+      SHA256Context sha256;
+      BLAKE3Context blake3;
+      Vector<uint8_t> output;
+  };
 }
 #endif
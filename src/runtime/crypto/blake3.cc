@@ -0,0 +1,260 @@
+#include <string.h>
+
+#include "../crypto.hh"
+
+#define BLAKE3_ROTR(x,n) (((x) >> (n)) | ((x) << (32-(n))))
+
+namespace ssc::runtime::crypto {
+  static constexpr size_t BLAKE3_BLOCK_SIZE = 64;
+  static constexpr size_t BLAKE3_CHUNK_SIZE = 1024;
+
+  static constexpr uint32_t BLAKE3_CHUNK_START = 1 << 0;
+  static constexpr uint32_t BLAKE3_CHUNK_END = 1 << 1;
+  static constexpr uint32_t BLAKE3_PARENT = 1 << 2;
+  static constexpr uint32_t BLAKE3_ROOT = 1 << 3;
+
+  static const uint32_t BLAKE3_IV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+  };
+
+  // the message words used by each of the 7 rounds
+  static const uint8_t BLAKE3_SCHEDULE[7][16] = {
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+    { 2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8 },
+    { 3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1 },
+    { 10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6 },
+    { 12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4 },
+    { 9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7 },
+    { 11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13 }
+  };
+
+  // the output of a node that is either a chaining value or, for the root
+  // node, the digest
+  struct BLAKE3Output {
+    uint32_t cv[8];
+    uint32_t block[16];
+    uint64_t counter;
+    uint32_t blockSize;
+    uint32_t flags;
+  };
+
+  static inline uint32_t load32 (const unsigned char* bytes) {
+    return (
+      ((uint32_t) bytes[0]) |
+      ((uint32_t) bytes[1] << 8) |
+      ((uint32_t) bytes[2] << 16) |
+      ((uint32_t) bytes[3] << 24)
+    );
+  }
+
+  static inline void blake3_g (
+    uint32_t state[16],
+    size_t a,
+    size_t b,
+    size_t c,
+    size_t d,
+    uint32_t x,
+    uint32_t y
+  ) {
+    state[a] = state[a] + state[b] + x;
+    state[d] = BLAKE3_ROTR(state[d] ^ state[a], 16);
+    state[c] = state[c] + state[d];
+    state[b] = BLAKE3_ROTR(state[b] ^ state[c], 12);
+    state[a] = state[a] + state[b] + y;
+    state[d] = BLAKE3_ROTR(state[d] ^ state[a], 8);
+    state[c] = state[c] + state[d];
+    state[b] = BLAKE3_ROTR(state[b] ^ state[c], 7);
+  }
+
+  static void blake3_compress (
+    const uint32_t cv[8],
+    const uint32_t block[16],
+    uint64_t counter,
+    uint32_t blockSize,
+    uint32_t flags,
+    uint32_t out[16]
+  ) {
+    uint32_t state[16] = {
+      cv[0], cv[1], cv[2], cv[3],
+      cv[4], cv[5], cv[6], cv[7],
+      BLAKE3_IV[0], BLAKE3_IV[1], BLAKE3_IV[2], BLAKE3_IV[3],
+      (uint32_t) counter, (uint32_t) (counter >> 32), blockSize, flags
+    };
+
+    for (size_t r = 0; r < 7; ++r) {
+      const auto m = BLAKE3_SCHEDULE[r];
+      // columns
+      blake3_g(state, 0, 4, 8, 12, block[m[0]], block[m[1]]);
+      blake3_g(state, 1, 5, 9, 13, block[m[2]], block[m[3]]);
+      blake3_g(state, 2, 6, 10, 14, block[m[4]], block[m[5]]);
+      blake3_g(state, 3, 7, 11, 15, block[m[6]], block[m[7]]);
+      // diagonals
+      blake3_g(state, 0, 5, 10, 15, block[m[8]], block[m[9]]);
+      blake3_g(state, 1, 6, 11, 12, block[m[10]], block[m[11]]);
+      blake3_g(state, 2, 7, 8, 13, block[m[12]], block[m[13]]);
+      blake3_g(state, 3, 4, 9, 14, block[m[14]], block[m[15]]);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+      out[i] = state[i] ^ state[i + 8];
+      out[i + 8] = state[i + 8] ^ cv[i];
+    }
+  }
+
+  static void blake3_load_block (const unsigned char bytes[64], uint32_t block[16]) {
+    for (size_t i = 0; i < 16; ++i) {
+      block[i] = load32(bytes + i * 4);
+    }
+  }
+
+  static void blake3_output_cv (const BLAKE3Output& output, uint32_t cv[8]) {
+    uint32_t out[16];
+    blake3_compress(output.cv, output.block, output.counter, output.blockSize, output.flags, out);
+    memcpy(cv, out, 8 * sizeof(uint32_t));
+  }
+
+  static void blake3_chunk_init (BLAKE3ChunkState* chunk, uint64_t counter) {
+    memcpy(chunk->cv, BLAKE3_IV, sizeof(chunk->cv));
+    memset(chunk->block, 0, sizeof(chunk->block));
+    chunk->counter = counter;
+    chunk->blockSize = 0;
+    chunk->blocksCompressed = 0;
+  }
+
+  static inline size_t blake3_chunk_size (const BLAKE3ChunkState* chunk) {
+    return BLAKE3_BLOCK_SIZE * chunk->blocksCompressed + chunk->blockSize;
+  }
+
+  static inline uint32_t blake3_chunk_start_flag (const BLAKE3ChunkState* chunk) {
+    return chunk->blocksCompressed == 0 ? BLAKE3_CHUNK_START : 0;
+  }
+
+  static void blake3_chunk_update (
+    BLAKE3ChunkState* chunk,
+    const unsigned char* data,
+    size_t size
+  ) {
+    while (size > 0) {
+      // the last block of a chunk is only compressed with `CHUNK_END`, so
+      // a full block is kept until more input arrives
+      if (chunk->blockSize == BLAKE3_BLOCK_SIZE) {
+        uint32_t block[16];
+        uint32_t out[16];
+
+        blake3_load_block(chunk->block, block);
+        blake3_compress(
+          chunk->cv,
+          block,
+          chunk->counter,
+          BLAKE3_BLOCK_SIZE,
+          blake3_chunk_start_flag(chunk),
+          out
+        );
+
+        memcpy(chunk->cv, out, sizeof(chunk->cv));
+        memset(chunk->block, 0, sizeof(chunk->block));
+        chunk->blocksCompressed++;
+        chunk->blockSize = 0;
+      }
+
+      const auto take = std::min(BLAKE3_BLOCK_SIZE - chunk->blockSize, size);
+      memcpy(chunk->block + chunk->blockSize, data, take);
+      chunk->blockSize += take;
+      data += take;
+      size -= take;
+    }
+  }
+
+  static BLAKE3Output blake3_chunk_output (const BLAKE3ChunkState* chunk) {
+    BLAKE3Output output;
+    memcpy(output.cv, chunk->cv, sizeof(output.cv));
+    blake3_load_block(chunk->block, output.block);
+    output.counter = chunk->counter;
+    output.blockSize = chunk->blockSize;
+    output.flags = blake3_chunk_start_flag(chunk) | BLAKE3_CHUNK_END;
+    return output;
+  }
+
+  static BLAKE3Output blake3_parent_output (const uint32_t left[8], const uint32_t right[8]) {
+    BLAKE3Output output;
+    memcpy(output.cv, BLAKE3_IV, sizeof(output.cv));
+    memcpy(output.block, left, 8 * sizeof(uint32_t));
+    memcpy(output.block + 8, right, 8 * sizeof(uint32_t));
+    output.counter = 0;
+    output.blockSize = BLAKE3_BLOCK_SIZE;
+    output.flags = BLAKE3_PARENT;
+    return output;
+  }
+
+  // merges completed subtrees, one merge per trailing zero bit of the
+  // number of chunks, before the chaining value of a chunk is pushed
+  static void blake3_push_cv (BLAKE3Context* ctx, uint32_t cv[8], uint64_t chunks) {
+    while ((chunks & 1) == 0) {
+      uint32_t parent[8];
+      blake3_output_cv(blake3_parent_output(ctx->stack[--ctx->stackSize], cv), parent);
+      memcpy(cv, parent, sizeof(parent));
+      chunks >>= 1;
+    }
+
+    memcpy(ctx->stack[ctx->stackSize++], cv, 8 * sizeof(uint32_t));
+  }
+
+  void blake3_init (BLAKE3Context *ctx) {
+    blake3_chunk_init(&ctx->chunk, 0);
+    ctx->stackSize = 0;
+  }
+
+  void blake3_update (BLAKE3Context *ctx, const unsigned char *data, size_t size) {
+    while (size > 0) {
+      // a full chunk is only finished once more input arrives, the last
+      // chunk is the root when it is the only one
+      if (blake3_chunk_size(&ctx->chunk) == BLAKE3_CHUNK_SIZE) {
+        uint32_t cv[8];
+        const auto chunks = ctx->chunk.counter + 1;
+        blake3_output_cv(blake3_chunk_output(&ctx->chunk), cv);
+        blake3_push_cv(ctx, cv, chunks);
+        blake3_chunk_init(&ctx->chunk, chunks);
+      }
+
+      const auto take = std::min(BLAKE3_CHUNK_SIZE - blake3_chunk_size(&ctx->chunk), size);
+      blake3_chunk_update(&ctx->chunk, data, take);
+      data += take;
+      size -= take;
+    }
+  }
+
+  void blake3_final (BLAKE3Context *ctx, unsigned char out[BLAKE3_DIGEST_SIZE]) {
+    auto output = blake3_chunk_output(&ctx->chunk);
+
+    for (size_t i = ctx->stackSize; i > 0; --i) {
+      uint32_t cv[8];
+      blake3_output_cv(output, cv);
+      output = blake3_parent_output(ctx->stack[i - 1], cv);
+    }
+
+    uint32_t words[16];
+    blake3_compress(output.cv, output.block, 0, output.blockSize, output.flags | BLAKE3_ROOT, words);
+
+    for (size_t i = 0; i < 8; ++i) {
+      out[i * 4] = (unsigned char) (words[i] & 0xFF);
+      out[i * 4 + 1] = (unsigned char) ((words[i] >> 8) & 0xFF);
+      out[i * 4 + 2] = (unsigned char) ((words[i] >> 16) & 0xFF);
+      out[i * 4 + 3] = (unsigned char) ((words[i] >> 24) & 0xFF);
+    }
+
+    /* wipe context */
+    memset(ctx, 0, sizeof(*ctx));
+  }
+
+  void blake3 (
+    const unsigned char *data,
+    size_t size,
+    unsigned char out[BLAKE3_DIGEST_SIZE]
+  ) {
+    BLAKE3Context ctx;
+    blake3_init(&ctx);
+    blake3_update(&ctx, data, size);
+    blake3_final(&ctx, out);
+  }
+}
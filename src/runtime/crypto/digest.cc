@@ -0,0 +1,101 @@
+#include "../crypto.hh"
+#include "../string.hh"
+#include "../bytes.hh"
+
+using namespace ssc::runtime::string;
+using namespace ssc::runtime::bytes;
+
+namespace ssc::runtime::crypto {
+  bool Digest::getAlgorithm (const String& name, Algorithm& algorithm) {
+    // `SHA-256` (WebCrypto) and `sha256` (node) name the same algorithm
+    const auto value = replace(toLowerCase(trim(name)), "-", "");
+
+    if (value == "sha1") {
+      algorithm = Algorithm::SHA1;
+    } else if (value == "sha256") {
+      algorithm = Algorithm::SHA256;
+    } else if (value == "blake3") {
+      algorithm = Algorithm::BLAKE3;
+    } else {
+      return false;
+    }
+
+    return true;
+  }
+
+  const String Digest::getAlgorithmName (Algorithm algorithm) {
+    switch (algorithm) {
+      case Algorithm::SHA1: return "sha1";
+      case Algorithm::SHA256: return "sha256";
+      case Algorithm::BLAKE3: return "blake3";
+    }
+
+    return "";
+  }
+
+  Digest::Digest (Algorithm algorithm)
+    : algorithm(algorithm)
+  {
+    switch (algorithm) {
+      case Algorithm::SHA1: sha1_init(&this->sha1); break;
+      case Algorithm::SHA256: sha256_init(&this->sha256); break;
+      case Algorithm::BLAKE3: blake3_init(&this->blake3); break;
+    }
+  }
+
+  Digest& Digest::update (const unsigned char* data, size_t size) {
+    if (this->isFinalized || size == 0) {
+      return *this;
+    }
+
+    switch (this->algorithm) {
+      case Algorithm::SHA1: sha1_update(&this->sha1, data, size); break;
+      case Algorithm::SHA256: sha256_update(&this->sha256, data, size); break;
+      case Algorithm::BLAKE3: blake3_update(&this->blake3, data, size); break;
+    }
+
+    this->length += size;
+    return *this;
+  }
+
+  Digest& Digest::update (const String& string) {
+    return this->update(
+      reinterpret_cast<const unsigned char*>(string.data()),
+      string.size()
+    );
+  }
+
+  bool Digest::finalized () const {
+    return this->isFinalized;
+  }
+
+  Vector<uint8_t> Digest::finalize () {
+    if (this->isFinalized == false) {
+      this->output.resize(this->size());
+
+      switch (this->algorithm) {
+        case Algorithm::SHA1: sha1_final(&this->sha1, this->output.data()); break;
+        case Algorithm::SHA256: sha256_final(&this->sha256, this->output.data()); break;
+        case Algorithm::BLAKE3: blake3_final(&this->blake3, this->output.data()); break;
+      }
+
+      this->isFinalized = true;
+    }
+
+    return this->output;
+  }
+
+  String Digest::str () {
+    return encodeHexString(this->finalize());
+  }
+
+  size_t Digest::size () const {
+    switch (this->algorithm) {
+      case Algorithm::SHA1: return SHA1_DIGEST_SIZE;
+      case Algorithm::SHA256: return SHA256_DIGEST_SIZE;
+      case Algorithm::BLAKE3: return BLAKE3_DIGEST_SIZE;
+    }
+
+    return 0;
+  }
+}
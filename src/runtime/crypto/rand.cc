@@ -1,41 +1,162 @@
 #include <random>
+#include <string.h>
 
 #include "../crypto.hh"
 
-#define IMAX_BITS(m) ((m)/((m) % 255+1) / 255 % 255 * 8 + 7-86 / ((m) % 255+12))
-#define RAND_MAX_WIDTH IMAX_BITS(RAND_MAX)
+#define CHACHA20_ROTL(x,n) (((x) << (n)) | ((x) >> (32-(n))))
+
+#define CHACHA20_QUARTER_ROUND(x, a, b, c, d) {                              \
+  x[a] += x[b]; x[d] = CHACHA20_ROTL(x[d] ^ x[a], 16);                         \
+  x[c] += x[d]; x[b] = CHACHA20_ROTL(x[b] ^ x[c], 12);                         \
+  x[a] += x[b]; x[d] = CHACHA20_ROTL(x[d] ^ x[a], 8);                          \
+  x[c] += x[d]; x[b] = CHACHA20_ROTL(x[b] ^ x[c], 7);                          \
+}
 
 namespace ssc::runtime::crypto {
-  uint64_t rand64 () {
-    static const auto width = RAND_MAX_WIDTH;
-    static bool init = false;
+  // ChaCha20 blocks generated per refill of the per-thread buffer
+  static constexpr size_t RAND_BLOCKS = 16;
+  static constexpr size_t RAND_BUFFER_SIZE = RAND_BLOCKS * 64;
+  static constexpr size_t RAND_KEY_SIZE = 32;
+  // the key is mixed with fresh OS entropy after this many refills
+  static constexpr size_t RAND_RESEED_INTERVAL = 1024;
+
+  // `"expand 32-byte k"`
+  static const uint32_t CHACHA20_CONSTANTS[4] = {
+    0x61707865, 0x3320646e, 0x79622d32, 0x6b206574
+  };
+
+  // a ChaCha20 keystream per thread. Every refill replaces the key with
+  // the first bytes of its own output and bytes are wiped once they are
+  // handed out, so earlier output can not be recovered from the state
+  struct RandomState {
+    uint32_t key[8];
+    unsigned char buffer[RAND_BUFFER_SIZE];
+    size_t available = 0;
+    size_t refills = 0;
+    bool seeded = false;
+  };
+
+  static thread_local RandomState state;
+
+  static void chacha20_block (
+    const uint32_t key[8],
+    uint64_t counter,
+    unsigned char out[64]
+  ) {
+    const uint32_t input[16] = {
+      CHACHA20_CONSTANTS[0], CHACHA20_CONSTANTS[1],
+      CHACHA20_CONSTANTS[2], CHACHA20_CONSTANTS[3],
+      key[0], key[1], key[2], key[3],
+      key[4], key[5], key[6], key[7],
+      (uint32_t) counter, (uint32_t) (counter >> 32), 0, 0
+    };
+
+    uint32_t x[16];
+    memcpy(x, input, sizeof(x));
+
+    for (int i = 0; i < 10; ++i) {
+      // columns
+      CHACHA20_QUARTER_ROUND(x, 0, 4, 8, 12);
+      CHACHA20_QUARTER_ROUND(x, 1, 5, 9, 13);
+      CHACHA20_QUARTER_ROUND(x, 2, 6, 10, 14);
+      CHACHA20_QUARTER_ROUND(x, 3, 7, 11, 15);
+      // diagonals
+      CHACHA20_QUARTER_ROUND(x, 0, 5, 10, 15);
+      CHACHA20_QUARTER_ROUND(x, 1, 6, 11, 12);
+      CHACHA20_QUARTER_ROUND(x, 2, 7, 8, 13);
+      CHACHA20_QUARTER_ROUND(x, 3, 4, 9, 14);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+      x[i] += input[i];
+    }
+
+    // the keystream is little endian, like every supported target
+    memcpy(out, x, sizeof(x));
+  }
+
+  // reads `size` bytes of OS entropy (`getrandom(2)`, `getentropy(2)`,
+  // `BCryptGenRandom()`, ...) through libuv
+  static void entropy (unsigned char* bytes, size_t size) {
+    if (uv_random(nullptr, nullptr, bytes, size, 0, nullptr) == 0) {
+      return;
+    }
 
-    if (!init) {
-      init = true;
-      srand(time(0));
+    std::random_device device;
+
+    for (size_t i = 0; i < size; i += sizeof(uint32_t)) {
+      const uint32_t value = device();
+      memcpy(bytes + i, &value, std::min(sizeof(value), size - i));
+    }
+  }
+
+  static void refill (RandomState& state) {
+    if (!state.seeded || state.refills >= RAND_RESEED_INTERVAL) {
+      uint32_t seed[8];
+      entropy(reinterpret_cast<unsigned char*>(seed), sizeof(seed));
+
+      for (int i = 0; i < 8; ++i) {
+        state.key[i] = state.seeded ? state.key[i] ^ seed[i] : seed[i];
+      }
+
+      memset(seed, 0, sizeof(seed));
+      state.seeded = true;
+      state.refills = 0;
+    }
+
+    for (size_t i = 0; i < RAND_BLOCKS; ++i) {
+      chacha20_block(state.key, i, state.buffer + i * 64);
     }
 
-    uint64_t r = 0;
-    for (int i = 0; i < 64; i += width) {
-      r <<= width;
-      r ^= (unsigned) rand();
+    memcpy(state.key, state.buffer, RAND_KEY_SIZE);
+    memset(state.buffer, 0, RAND_KEY_SIZE);
+    state.available = RAND_BUFFER_SIZE - RAND_KEY_SIZE;
+    state.refills++;
+  }
+
+  void getRandomValues (unsigned char* bytes, size_t size) {
+    while (size > 0) {
+      if (state.available == 0) {
+        refill(state);
+      }
+
+      const auto offset = RAND_BUFFER_SIZE - state.available;
+      const auto take = std::min(state.available, size);
+
+      memcpy(bytes, state.buffer + offset, take);
+      memset(state.buffer + offset, 0, take);
+      state.available -= take;
+      bytes += take;
+      size -= take;
     }
-    return r;
   }
 
+  uint64_t rand64 () {
+    uint64_t value = 0;
+    getRandomValues(reinterpret_cast<unsigned char*>(&value), sizeof(value));
+    return value;
+  }
+
+  // adapts `rand64()` to the standard random engine interface
+  struct RandomEngine {
+    using result_type = uint64_t;
+    static constexpr result_type min () { return 0; }
+    static constexpr result_type max () { return UINT64_MAX; }
+    result_type operator () () { return rand64(); }
+  };
+
 	int randint (int a, int b) {
     if (a == 0 && b == 0) {
       return 0;
     }
 
-    static std::random_device rd;  // non-deterministic random seed
-    static std::mt19937 gen(rd()); // mersenne twister rng
+    RandomEngine engine;
 
     // Create a uniform distribution in the range of valid indices
     std::uniform_int_distribution<size_t> dist(a, b);
 
     // Generate and return a random index
-    return dist(gen);
+    return dist(engine);
   }
 
 	int randint (int a) {
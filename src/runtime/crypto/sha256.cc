@@ -0,0 +1,359 @@
+#include <string.h>
+
+#include "../crypto.hh"
+#include "../string.hh"
+#include "../bytes.hh"
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA256_X86_SHANI 1
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_SHA2)
+#include <arm_neon.h>
+#define SHA256_ARM_SHA2 1
+#endif
+
+using namespace ssc::runtime::string;
+using namespace ssc::runtime::bytes;
+
+#define SHA256_ROTR(x,n) (((x) >> (n)) | ((x) << (32-(n))))
+#define SHA256_CH(x,y,z) (((x) & (y)) ^ ((~(x)) & (z)))
+#define SHA256_MAJ(x,y,z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA256_EP0(x) (SHA256_ROTR(x,2) ^ SHA256_ROTR(x,13) ^ SHA256_ROTR(x,22))
+#define SHA256_EP1(x) (SHA256_ROTR(x,6) ^ SHA256_ROTR(x,11) ^ SHA256_ROTR(x,25))
+#define SHA256_SIG0(x) (SHA256_ROTR(x,7) ^ SHA256_ROTR(x,18) ^ ((x) >> 3))
+#define SHA256_SIG1(x) (SHA256_ROTR(x,17) ^ SHA256_ROTR(x,19) ^ ((x) >> 10))
+
+namespace ssc::runtime::crypto {
+  using SHA256Transform = void (*)(uint32_t[8], const unsigned char*, size_t);
+
+  alignas(16) static const uint32_t SHA256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  static void sha256_transform (
+    uint32_t state[8],
+    const unsigned char* data,
+    size_t blocks
+  ) {
+    uint32_t a, b, c, d, e, f, g, h;
+    uint32_t w[64];
+    size_t t;
+
+    for (; blocks > 0; --blocks, data += 64) {
+      for (t = 0; t < 16; t++) {
+        w[t] = (uint32_t)data[t * 4] << 24;
+        w[t] |= (uint32_t)data[t * 4 + 1] << 16;
+        w[t] |= (uint32_t)data[t * 4 + 2] << 8;
+        w[t] |= (uint32_t)data[t * 4 + 3];
+      }
+
+      for (t = 16; t < 64; t++) {
+        w[t] = SHA256_SIG1(w[t-2]) + w[t-7] + SHA256_SIG0(w[t-15]) + w[t-16];
+      }
+
+      a = state[0];
+      b = state[1];
+      c = state[2];
+      d = state[3];
+      e = state[4];
+      f = state[5];
+      g = state[6];
+      h = state[7];
+
+      for (t = 0; t < 64; t++) {
+        uint32_t temp1 = h + SHA256_EP1(e) + SHA256_CH(e,f,g) + SHA256_K[t] + w[t];
+        uint32_t temp2 = SHA256_EP0(a) + SHA256_MAJ(a,b,c);
+        h = g; g = f; f = e; e = d + temp1;
+        d = c; c = b; b = a; a = temp1 + temp2;
+      }
+
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+      state[5] += f;
+      state[6] += g;
+      state[7] += h;
+    }
+  }
+
+#if SHA256_X86_SHANI
+  // four rounds per step, the message schedule is kept in four registers
+  __attribute__((target("sha,sse4.1")))
+  static void sha256_transform_shani (
+    uint32_t state[8],
+    const unsigned char* data,
+    size_t blocks
+  ) {
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i messages[4];
+    __m128i message;
+
+    // `state` is reordered into the `ABEF` and `CDGH` lanes the
+    // instructions operate on
+    auto temp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0])), 0xB1);
+    auto state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4])), 0x1B);
+    auto state0 = _mm_alignr_epi8(temp, state1, 8);
+    state1 = _mm_blend_epi16(state1, temp, 0xF0);
+
+    for (; blocks > 0; --blocks, data += 64) {
+      const auto abef = state0;
+      const auto cdgh = state1;
+
+      for (int i = 0; i < 16; ++i) {
+        auto& current = messages[i & 3];
+
+        if (i < 4) {
+          current = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)),
+            mask
+          );
+        } else {
+          // `current` holds the words of 4 steps ago
+          current = _mm_sha256msg1_epu32(current, messages[(i + 1) & 3]);
+          current = _mm_add_epi32(current, _mm_alignr_epi8(messages[(i + 3) & 3], messages[(i + 2) & 3], 4));
+          current = _mm_sha256msg2_epu32(current, messages[(i + 3) & 3]);
+        }
+
+        message = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(&SHA256_K[i * 4])));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, message);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(message, 0x0E));
+      }
+
+      state0 = _mm_add_epi32(state0, abef);
+      state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    temp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(temp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, temp, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+  }
+#elif SHA256_ARM_SHA2
+  static void sha256_transform_arm (
+    uint32_t state[8],
+    const unsigned char* data,
+    size_t blocks
+  ) {
+    auto state0 = vld1q_u32(&state[0]);
+    auto state1 = vld1q_u32(&state[4]);
+    uint32x4_t messages[4];
+
+    for (; blocks > 0; --blocks, data += 64) {
+      const auto abcd = state0;
+      const auto efgh = state1;
+
+      for (int i = 0; i < 16; ++i) {
+        auto& current = messages[i & 3];
+
+        if (i < 4) {
+          current = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+        } else {
+          current = vsha256su1q_u32(
+            vsha256su0q_u32(current, messages[(i + 1) & 3]),
+            messages[(i + 2) & 3],
+            messages[(i + 3) & 3]
+          );
+        }
+
+        const auto message = vaddq_u32(current, vld1q_u32(&SHA256_K[i * 4]));
+        const auto previous = state0;
+        state0 = vsha256hq_u32(state0, state1, message);
+        state1 = vsha256h2q_u32(state1, previous, message);
+      }
+
+      state0 = vaddq_u32(state0, abcd);
+      state1 = vaddq_u32(state1, efgh);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+  }
+#endif
+
+  static SHA256Transform selectSHA256Transform () {
+  #if SHA256_X86_SHANI
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    const auto hasSSE41 = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_1);
+    // `CPUID.(EAX=07H, ECX=0):EBX.SHA[bit 29]`
+    const auto hasSHA = __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29));
+
+    if (hasSSE41 && hasSHA) {
+      return sha256_transform_shani;
+    }
+  #elif SHA256_ARM_SHA2
+    return sha256_transform_arm;
+  #endif
+
+    return sha256_transform;
+  }
+
+  static SHA256Transform getSHA256Transform () {
+    // selected once, the CPU does not change while running
+    static const auto transform = selectSHA256Transform();
+    return transform;
+  }
+
+  bool sha256_accelerated () {
+    return getSHA256Transform() != sha256_transform;
+  }
+
+  void sha256_init (SHA256Context *ctx) {
+    ctx->bitCount = 0;
+    ctx->state[0] = 0x6a09e667UL;
+    ctx->state[1] = 0xbb67ae85UL;
+    ctx->state[2] = 0x3c6ef372UL;
+    ctx->state[3] = 0xa54ff53aUL;
+    ctx->state[4] = 0x510e527fUL;
+    ctx->state[5] = 0x9b05688cUL;
+    ctx->state[6] = 0x1f83d9abUL;
+    ctx->state[7] = 0x5be0cd19UL;
+    memset(ctx->buffer, 0, sizeof(ctx->buffer));
+  }
+
+  void sha256_update (SHA256Context *ctx, const unsigned char *data, size_t size) {
+    size_t i = 0;
+    size_t index = (size_t)((ctx->bitCount >> 3) & 0x3F);
+    ctx->bitCount += (uint64_t)size << 3;
+
+    size_t space = 64 - index;
+
+    if (size >= space) {
+      const auto transform = getSHA256Transform();
+      memcpy(&ctx->buffer[index], data, space);
+      transform(ctx->state, ctx->buffer, 1);
+      // whole blocks are compressed straight from the input
+      const auto blocks = (size - space) / 64;
+      if (blocks > 0) {
+        transform(ctx->state, &data[space], blocks);
+      }
+      i = space + blocks * 64;
+      index = 0;
+    }
+
+    memcpy(&ctx->buffer[index], &data[i], size - i);
+  }
+
+  void sha256_final (SHA256Context *ctx, unsigned char out[SHA256_DIGEST_SIZE]) {
+    static const unsigned char pad[64] = { 0x80 };
+    unsigned char bits[8];
+    size_t index = (size_t)((ctx->bitCount >> 3) & 0x3F);
+    size_t padSize;
+    uint64_t bitCount = ctx->bitCount;
+
+    /* convert bit count to big-endian */
+    for (int i = 0; i < 8; i++) {
+      bits[i] = (unsigned char)((bitCount >> (56 - i * 8)) & 0xFF);
+    }
+
+    padSize = (index < 56) ? (56 - index) : (120 - index);
+    sha256_update(ctx, pad, padSize);
+    sha256_update(ctx, bits, 8);
+
+    for (int i = 0; i < 8; i++) {
+      out[i*4]     = (unsigned char)((ctx->state[i] >> 24) & 0xFF);
+      out[i*4 + 1] = (unsigned char)((ctx->state[i] >> 16) & 0xFF);
+      out[i*4 + 2] = (unsigned char)((ctx->state[i] >> 8) & 0xFF);
+      out[i*4 + 3] = (unsigned char)(ctx->state[i] & 0xFF);
+    }
+
+    /* wipe context */
+    memset(ctx, 0, sizeof(*ctx));
+  }
+
+  void sha256 (
+    const unsigned char *data,
+    size_t size,
+    unsigned char out[SHA256_DIGEST_SIZE]
+  ) {
+    memset(out, 0, SHA256_DIGEST_SIZE);
+    SHA256Context ctx;
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, size);
+    sha256_final(&ctx, out);
+  }
+
+  SHA256::SHA256 () {
+    sha256_init(&this->context);
+  }
+
+  SHA256::SHA256 (const String& data) : SHA256() {
+    this->update(data);
+  }
+
+  SHA256::SHA256 (
+    const SharedPointer<unsigned char[]>& data,
+    size_t size
+  ) : SHA256() {
+    this->update(
+      reinterpret_cast<const unsigned char*>(data.get()),
+      size
+    );
+  }
+
+  SHA256::SHA256 (
+    const unsigned char* data,
+    size_t size
+  ) : SHA256() {
+    this->update(data, size);
+  }
+
+  SHA256& SHA256::update (
+    const unsigned char* data,
+    size_t size
+  ) {
+    sha256_update(&this->context, data, size);
+    return *this;
+  }
+
+  SHA256& SHA256::update (const String& string) {
+    return this->update(
+      reinterpret_cast<const unsigned char*>(string.data()),
+      string.size()
+    );
+  }
+
+  bool SHA256::finalized () const {
+    return this->isFinalized;
+  }
+
+  Vector<uint8_t> SHA256::finalize () {
+    if (this->isFinalized == false) {
+      sha256_final(&this->context, this->output);
+      this->isFinalized = true;
+    }
+
+    return Vector<uint8_t>(
+      this->output,
+      this->output + SHA256_DIGEST_SIZE
+    );
+  }
+
+  String SHA256::str () {
+    return toUpperCase(encodeHexString(this->finalize()));
+  }
+
+  const String sha256 (const String& input) {
+    return SHA256(input).str();
+  }
+
+  const String sha256 (const SharedPointer<unsigned char[]>& input, size_t size) {
+    return SHA256(input, size).str();
+  }
+
+  const String sha256 (const unsigned char * input, size_t size) {
+    return SHA256(input, size).str();
+  }
+}
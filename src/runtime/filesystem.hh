@@ -11,6 +11,19 @@ namespace ssc::runtime::filesystem {
       struct Cache {
         SharedPointer<unsigned char[]> bytes = nullptr;
         size_t size = 0;
+        // modification time (in nanoseconds) of the file when it was read
+        int64_t mtime = 0;
+      };
+
+      /**
+       * HTTP cache validators of a resource computed lazily and cached
+       * for as long as its inode, size, and modification time are the same.
+       */
+      struct Validators {
+        // a strong entity tag (including quotes)
+        String etag = "";
+        // seconds since the epoch
+        time_t lastModified = 0;
       };
 
       struct WellKnownPaths {
@@ -78,6 +91,11 @@ namespace ssc::runtime::filesystem {
         #elif SOCKET_RUNTIME_PLATFORM_LINUX
           GFileInputStream* stream = nullptr;
           GFile* file = nullptr;
+        #elif SOCKET_RUNTIME_PLATFORM_ANDROID
+          android::Asset* asset = nullptr;
+          int fd = -1;
+        #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+          HANDLE handle = nullptr;
         #endif
 
           Options options;
@@ -170,6 +188,7 @@ namespace ssc::runtime::filesystem {
       const unsigned char* read () const;
       const unsigned char* read (bool cached = false);
       const String str (bool cached = false);
+      const Validators validators () const;
       ReadStream stream (const ReadStream::Options& options = {});
 
     #if SOCKET_RUNTIME_PLATFORM_ANDROID
@@ -1,18 +1,20 @@
 #include "../env.hh"
 #include "../cwd.hh"
 #include "../config.hh"
+#include "../crypto.hh"
 #include "../string.hh"
 #include "../filesystem.hh"
 
-#if SOCKET_RUNTIME_PLATFORM_ANDROID
-#include <fstream>
+#if !SOCKET_RUNTIME_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 using namespace ssc::runtime::string;
 using ssc::runtime::config::getUserConfig;
 
 namespace ssc::runtime::filesystem {
-  static Map<String, Resource::Cache> caches;
   static Mutex mutex;
   static Resource::WellKnownPaths defaultWellKnownPaths;
 
@@ -30,6 +32,234 @@ namespace ssc::runtime::filesystem {
   }
   #endif
 
+  // files larger than this get an entity tag derived from their inode,
+  // size, and modification time instead of a digest of their contents
+  static constexpr size_t RESOURCE_CONTENT_ETAG_THRESHOLD = 16 * 1024 * 1024;
+
+  struct ValidatorsCacheEntry {
+    uint64_t inode = 0;
+    uint64_t size = 0;
+    int64_t mtime = 0; // in nanoseconds
+    Resource::Validators validators;
+  };
+
+  static Map<String, ValidatorsCacheEntry> validatorsCache;
+
+  // files smaller than this are read into the heap directly as the cost of
+  // setting up (and tearing down) a mapping outweighs a single `read(2)`
+  static constexpr size_t RESOURCE_MEMORY_MAP_THRESHOLD = 16 * 1024;
+
+  // cached resource bytes (and the mappings backing them) beyond this
+  // budget are dropped, least recently used first
+  static constexpr size_t RESOURCE_CACHE_MAX_BYTES = 32 * 1024 * 1024;
+
+  struct ResourceCacheEntry {
+    Resource::Cache cache;
+    uint64_t used = 0;
+  };
+
+  static Map<String, ResourceCacheEntry> caches;
+  static size_t cachesBytes = 0;
+  static uint64_t cachesClock = 0;
+
+  struct ResourceFileStat {
+    uint64_t inode = 0;
+    uint64_t size = 0;
+    int64_t mtime = 0; // in nanoseconds
+  };
+
+  static bool statResourceFile (const Path& path, ResourceFileStat& stat) {
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    struct _stat64 st;
+    if (_wstat64(convertStringToWString(path.string()).c_str(), &st) != 0) {
+      return false;
+    }
+
+    stat.mtime = static_cast<int64_t>(st.st_mtime) * 1000000000;
+  #else
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+      return false;
+    }
+
+  #if SOCKET_RUNTIME_PLATFORM_APPLE
+    stat.mtime = (
+      static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 +
+      st.st_mtimespec.tv_nsec
+    );
+  #else
+    stat.mtime = (
+      static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+      st.st_mtim.tv_nsec
+    );
+  #endif
+  #endif
+
+    stat.inode = static_cast<uint64_t>(st.st_ino);
+    stat.size = static_cast<uint64_t>(st.st_size);
+    return true;
+  }
+
+  // expects `mutex` to be held
+  static void evictResourceCaches (size_t bytes) {
+    while (caches.size() > 0 && cachesBytes + bytes > RESOURCE_CACHE_MAX_BYTES) {
+      auto oldest = caches.begin();
+      for (auto it = caches.begin(); it != caches.end(); ++it) {
+        if (it->second.used < oldest->second.used) {
+          oldest = it;
+        }
+      }
+
+      cachesBytes -= oldest->second.cache.size;
+      caches.erase(oldest);
+    }
+  }
+
+#if !SOCKET_RUNTIME_PLATFORM_WINDOWS
+  static SharedPointer<unsigned char[]> readResourceFile (
+    const Path& path,
+    size_t& size
+  ) {
+    struct stat st;
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    size = 0;
+
+    if (fd < 0) {
+      return nullptr;
+    }
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+      ::close(fd);
+      return nullptr;
+    }
+
+    size = static_cast<size_t>(st.st_size);
+
+    // a mapped file truncated in place raises `SIGBUS` when the pages past
+    // its new end are touched, so only files this process cannot write to
+    // (bundled and installed assets) are mapped, others are read
+    if (size < RESOURCE_MEMORY_MAP_THRESHOLD || ::access(path.c_str(), W_OK) == 0) {
+      auto bytes = SharedPointer<unsigned char[]>(new unsigned char[size]);
+      size_t offset = 0;
+
+      while (offset < size) {
+        const auto result = ::read(fd, bytes.get() + offset, size - offset);
+        if (result < 0 && errno == EINTR) {
+          continue;
+        } else if (result <= 0) {
+          break;
+        }
+
+        offset += result;
+      }
+
+      ::close(fd);
+
+      if (offset != size) {
+        size = 0;
+        return nullptr;
+      }
+
+      return bytes;
+    }
+
+    // the mapping holds a reference to the file, so the descriptor
+    // can be closed right away
+    auto pointer = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (pointer == MAP_FAILED) {
+      size = 0;
+      return nullptr;
+    }
+
+    // assets are almost always consumed front to back by the scheme handlers
+    madvise(pointer, size, MADV_SEQUENTIAL);
+
+    return SharedPointer<unsigned char[]>(
+      reinterpret_cast<unsigned char*>(pointer),
+      [size](unsigned char* bytes) {
+        munmap(reinterpret_cast<void*>(bytes), size);
+      }
+    );
+  }
+#else
+  static SharedPointer<unsigned char[]> readResourceFile (
+    const Path& path,
+    size_t& size
+  ) {
+    LARGE_INTEGER fileSize;
+    auto handle = CreateFile(
+      convertWStringToString(path.string()).c_str(),
+      GENERIC_READ, // access
+      FILE_SHARE_READ, // share mode
+      nullptr, // security attribues (unused)
+      OPEN_EXISTING, // creation disposition
+      FILE_FLAG_SEQUENTIAL_SCAN, // flags and attribues
+      nullptr // templte file (unused)
+    );
+
+    size = 0;
+
+    if (handle == INVALID_HANDLE_VALUE || handle == nullptr) {
+      return nullptr;
+    }
+
+    if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart <= 0) {
+      CloseHandle(handle);
+      return nullptr;
+    }
+
+    size = static_cast<size_t>(fileSize.QuadPart);
+
+    if (size < RESOURCE_MEMORY_MAP_THRESHOLD) {
+      auto bytes = SharedPointer<unsigned char[]>(new unsigned char[size]);
+      DWORD bytesRead = 0;
+      const auto result = ReadFile(
+        handle, // File handle
+        reinterpret_cast<void*>(bytes.get()),
+        (DWORD) size, // output buffer size
+        &bytesRead, // bytes read
+        nullptr // ignored (unused)
+      );
+
+      CloseHandle(handle);
+
+      if (!result || bytesRead != size) {
+        size = 0;
+        return nullptr;
+      }
+
+      return bytes;
+    }
+
+    auto mapping = CreateFileMapping(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);
+
+    if (mapping == nullptr) {
+      size = 0;
+      return nullptr;
+    }
+
+    // the view holds a reference to the mapping object
+    auto pointer = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (pointer == nullptr) {
+      size = 0;
+      return nullptr;
+    }
+
+    return SharedPointer<unsigned char[]>(
+      reinterpret_cast<unsigned char*>(pointer),
+      [](unsigned char* bytes) {
+        UnmapViewOfFile(reinterpret_cast<void*>(bytes));
+      }
+    );
+  }
+#endif
+
 #if SOCKET_RUNTIME_PLATFORM_ANDROID
   static android::AssetManager* sharedAndroidAssetManager = nullptr;
   static Path externalAndroidStorageDirectory;
@@ -672,9 +902,14 @@ namespace ssc::runtime::filesystem {
       return false;
     }
 
-    if (caches.contains(this->path.string())) {
-      this->cache = caches.at(this->path.string());
-    }
+    do {
+      Lock lock(mutex);
+      if (caches.contains(this->path.string())) {
+        auto& entry = caches.at(this->path.string());
+        entry.used = ++cachesClock;
+        this->cache = entry.cache;
+      }
+    } while (0);
 
   #if SOCKET_RUNTIME_PLATFORM_APPLE
     if (this->nsURL == nullptr) {
@@ -965,13 +1200,23 @@ namespace ssc::runtime::filesystem {
     return this->cache.bytes.get();
   }
 
-  // caller takes ownership of returned pointer
+  // returned pointer is owned by the resource (and its cache) and may be
+  // backed by a read-only memory mapping of the file, so it must not be
+  // written to and is not guaranteed to be NUL terminated
   const unsigned char* Resource::read (bool cached) {
     if (!this->accessing || !this->exists()) {
       return nullptr;
     }
 
-    if (cached && this->cache.bytes != nullptr) {
+    auto stat = ResourceFileStat {};
+    const auto hasStat = statResourceFile(this->path, stat);
+
+    // cached bytes are only used while the file has not changed
+    if (
+      cached &&
+      this->cache.bytes != nullptr &&
+      (!hasStat || (stat.size == this->cache.size && stat.mtime == this->cache.mtime))
+    ) {
       return this->cache.bytes.get();
     }
 
@@ -988,53 +1233,14 @@ namespace ssc::runtime::filesystem {
     if (data.length > 0) {
       this->bytes.reset(new unsigned char[data.length]{0});
       memcpy(this->bytes.get(), data.bytes, data.length);
+      this->cache.size = data.length;
     }
-  #elif SOCKET_RUNTIME_PLATFORM_LINUX
+  #elif SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_WINDOWS
     auto span = this->tracer.span("read");
-    GError* error = nullptr;
-    char* contents = nullptr;
-    gsize size = 0;
-    if (g_file_get_contents(this->path.string().c_str(), &contents, &size, &error)) {
-      if (size > 0) {
-        this->bytes.reset(new unsigned char[size]{0});
-        memcpy(this->bytes.get(), contents, size);
-      }
-    }
-
-    if (contents) {
-      g_free(contents);
-    }
+    size_t size = 0;
+    this->bytes = readResourceFile(this->path, size);
+    this->cache.size = size;
     span->end();
-  #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
-    auto handle = CreateFile(
-      convertWStringToString(this->path.string()).c_str(),
-      GENERIC_READ, // access
-      FILE_SHARE_READ, // share mode
-      nullptr, // security attribues (unused)
-      OPEN_EXISTING, // creation disposition
-      0, // flags and attribues (unused)
-      nullptr // templte file (unused)
-    );
-
-    if (handle) {
-      const auto size = this->size();
-      auto bytes = new unsigned char[size]{0};
-      auto result = ReadFile(
-        handle, // File handle
-        reinterpret_cast<void*>(bytes),
-        (DWORD) size, // output buffer size
-        nullptr, // bytes read (unused)
-        nullptr // ignored (unused)
-      );
-
-      if (result) {
-        this->bytes.reset(bytes);
-      } else {
-        delete [] bytes;
-      }
-
-      CloseHandle(handle);
-    }
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
     bool success = false;
     if (sharedAndroidAssetManager && !fs::exists(this->path)) {
@@ -1063,30 +1269,31 @@ namespace ssc::runtime::filesystem {
     }
 
     if (!success) {
-      auto stream = std::ifstream(this->path);
-      auto buffer = std::istreambuf_iterator<char>(stream);
-      auto size = fs::file_size(this->path);
-      auto end = std::istreambuf_iterator<char>();
-      if (size == 0) {
-        this->bytes = nullptr;
-      } else {
-        auto bytes = new unsigned char[size]{0};
-        String content;
-
-        content.assign(buffer, end);
-        memcpy(bytes, content.data(), size);
-
-        this->bytes.reset(bytes);
-      }
-
+      size_t size = 0;
+      this->bytes = readResourceFile(this->path, size);
       this->cache.size = size;
     }
   #endif
 
     this->cache.bytes = this->bytes;
+    this->cache.mtime = stat.mtime;
+
     if (this->options.cache) {
-      caches.insert_or_assign(this->path.string(), this->cache);
+      Lock lock(mutex);
+      const auto key = this->path.string();
+
+      if (caches.contains(key)) {
+        cachesBytes -= caches.at(key).cache.size;
+        caches.erase(key);
+      }
+
+      if (this->cache.size <= RESOURCE_CACHE_MAX_BYTES) {
+        evictResourceCaches(this->cache.size);
+        caches.insert_or_assign(key, ResourceCacheEntry { this->cache, ++cachesClock });
+        cachesBytes += this->cache.size;
+      }
     }
+
     return this->cache.bytes.get();
   }
 
@@ -1105,6 +1312,64 @@ namespace ssc::runtime::filesystem {
     return "";
   }
 
+  const Resource::Validators Resource::validators () const {
+    auto entry = ValidatorsCacheEntry {};
+    auto stat = ResourceFileStat {};
+    char hex[64] = {0};
+
+    if (!statResourceFile(this->path, stat)) {
+      return Validators {};
+    }
+
+    entry.inode = stat.inode;
+    entry.size = stat.size;
+    entry.mtime = stat.mtime;
+
+    do {
+      Lock lock(mutex);
+      if (validatorsCache.contains(this->path.string())) {
+        const auto& cached = validatorsCache.at(this->path.string());
+        if (
+          cached.inode == entry.inode &&
+          cached.size == entry.size &&
+          cached.mtime == entry.mtime
+        ) {
+          return cached.validators;
+        }
+      }
+    } while (0);
+
+    entry.validators.lastModified = static_cast<time_t>(stat.mtime / 1000000000);
+
+    if (entry.size > 0 && entry.size <= RESOURCE_CONTENT_ETAG_THRESHOLD) {
+      size_t size = 0;
+      const auto bytes = readResourceFile(this->path, size);
+      if (bytes != nullptr && size == entry.size) {
+        entry.validators.etag = "\"" + crypto::sha1(bytes, size) + "\"";
+      }
+    }
+
+    if (entry.validators.etag.size() == 0) {
+      snprintf(
+        hex,
+        sizeof(hex),
+        "\"%llx-%llx-%llx\"",
+        static_cast<unsigned long long>(entry.inode),
+        static_cast<unsigned long long>(entry.size),
+        static_cast<unsigned long long>(entry.mtime)
+      );
+
+      entry.validators.etag = hex;
+    }
+
+    do {
+      Lock lock(mutex);
+      validatorsCache.insert_or_assign(this->path.string(), entry);
+    } while (0);
+
+    return entry.validators;
+  }
+
   Resource::ReadStream Resource::stream (const ReadStream::Options& options) {
     return ReadStream(ReadStream::Options(this->path, options.highWaterMark, this->size()));
   }
@@ -1131,7 +1396,20 @@ namespace ssc::runtime::filesystem {
       this->stream = nullptr;
     }
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
+    if (this->asset != nullptr) {
+      AAsset_close(this->asset);
+      this->asset = nullptr;
+    }
+
+    if (this->fd > -1) {
+      ::close(this->fd);
+      this->fd = -1;
+    }
   #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    if (this->handle != nullptr && this->handle != INVALID_HANDLE_VALUE) {
+      CloseHandle(this->handle);
+      this->handle = nullptr;
+    }
   #endif
   }
 
@@ -1175,7 +1453,13 @@ namespace ssc::runtime::filesystem {
       stream.stream = nullptr;
     }
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
+    this->asset = stream.asset;
+    this->fd = stream.fd;
+    stream.asset = nullptr;
+    stream.fd = -1;
   #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    this->handle = stream.handle;
+    stream.handle = nullptr;
   #endif
   }
 
@@ -1227,7 +1511,13 @@ namespace ssc::runtime::filesystem {
       stream.stream = nullptr;
     }
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
+    this->asset = stream.asset;
+    this->fd = stream.fd;
+    stream.asset = nullptr;
+    stream.fd = -1;
   #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    this->handle = stream.handle;
+    stream.handle = nullptr;
   #endif
     return *this;
   }
@@ -1249,7 +1539,15 @@ namespace ssc::runtime::filesystem {
     #if SOCKET_RUNTIME_PLATFORM_APPLE
       if (this->data == nullptr) {
         auto url = [NSURL fileURLWithPath: @(this->options.resourcePath.string().c_str())];
-        this->data = [NSData dataWithContentsOfURL: url];
+        // a mapped read only pages in the slices of the file that are read
+        this->data = [NSData
+          dataWithContentsOfURL: url
+                        options: NSDataReadingMappedIfSafe
+                          error: nil
+        ];
+      }
+
+      if (this->data != nullptr) {
         @try {
           [this->data
             getBytes: buffer.bytes.get()
@@ -1279,27 +1577,88 @@ namespace ssc::runtime::filesystem {
         return buffer;
       }
 
-      if (offset > this->offset) {
-        g_input_stream_skip(
-          reinterpret_cast<GInputStream*>(this->stream),
-          offset - this->offset,
+      if (offset != this->offset) {
+        // `GFileInputStream` is seekable, so slices (like byte ranges) can be
+        // read without reading everything that comes before them
+        if (!g_seekable_seek(
+          G_SEEKABLE(this->stream),
+          offset,
+          G_SEEK_SET,
           nullptr,
-          nullptr
-        );
+          &this->error
+        )) {
+          buffer.size = 0;
+        }
 
         this->offset = offset;
       }
 
-      buffer.size = g_input_stream_read(
-        reinterpret_cast<GInputStream*>(this->stream),
-        buffer.bytes.get(),
-        size,
-        nullptr,
-        &this->error
-      );
-
+      if (buffer.size > 0) {
+        buffer.size = g_input_stream_read(
+          reinterpret_cast<GInputStream*>(this->stream),
+          buffer.bytes.get(),
+          size,
+          nullptr,
+          &this->error
+        );
+      }
     #elif SOCKET_RUNTIME_PLATFORM_ANDROID
+      if (this->fd == -1 && this->asset == nullptr) {
+        this->fd = ::open(this->options.resourcePath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (this->fd == -1 && sharedAndroidAssetManager != nullptr) {
+          const auto assetPath = getRelativeAndroidAssetManagerPath(this->options.resourcePath);
+          this->asset = AAssetManager_open(
+            sharedAndroidAssetManager,
+            assetPath.c_str(),
+            AASSET_MODE_RANDOM
+          );
+        }
+      }
+
+      ssize_t result = -1;
+      if (this->fd > -1) {
+        do {
+          result = ::pread(this->fd, buffer.bytes.get(), size, offset);
+        } while (result == -1 && errno == EINTR);
+      } else if (this->asset != nullptr) {
+        if (AAsset_seek(this->asset, offset, SEEK_SET) == offset) {
+          result = AAsset_read(this->asset, buffer.bytes.get(), size);
+        }
+      }
+
+      buffer.size = result > 0 ? result : 0;
+      this->offset = offset;
     #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      if (this->handle == nullptr) {
+        this->handle = CreateFile(
+          convertWStringToString(this->options.resourcePath.string()).c_str(),
+          GENERIC_READ, // access
+          FILE_SHARE_READ, // share mode
+          nullptr, // security attribues (unused)
+          OPEN_EXISTING, // creation disposition
+          FILE_FLAG_SEQUENTIAL_SCAN, // flags and attribues
+          nullptr // templte file (unused)
+        );
+      }
+
+      DWORD bytesRead = 0;
+      if (this->handle != INVALID_HANDLE_VALUE) {
+        OVERLAPPED overlapped = {0};
+        overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+        overlapped.OffsetHigh = static_cast<DWORD>((static_cast<uint64_t>(offset) >> 32) & 0xFFFFFFFF);
+        if (!ReadFile(
+          this->handle,
+          reinterpret_cast<void*>(buffer.bytes.get()),
+          (DWORD) size,
+          &bytesRead,
+          &overlapped
+        )) {
+          bytesRead = 0;
+        }
+      }
+
+      buffer.size = bytesRead;
+      this->offset = offset;
     #endif
     }
 
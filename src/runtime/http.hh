@@ -23,6 +23,44 @@ namespace ssc::runtime::http {
 
   const String toHeaderCase (const String&);
 
+  // `IMF-fixdate` HTTP dates (`Sun, 06 Nov 1994 08:49:37 GMT`)
+  String formatDate (time_t);
+  time_t parseDate (const String&);
+
+  /**
+   * A single satisfiable byte range (inclusive) of a representation
+   * of a known size parsed from a `Range` request header.
+   */
+  struct ByteRange {
+    size_t start = 0;
+    size_t end = 0;
+    size_t size () const;
+    // `bytes <start>-<end>/<total>` suitable for a `content-range` header
+    String str (size_t total) const;
+  };
+
+  /**
+   * A parsed `Range: bytes=...` request header. Ranges are resolved against
+   * the size of the representation, sorted and coalesced so they can be
+   * served in a single forward pass over the representation.
+   */
+  struct ByteRanges {
+    // the maximum number of (coalesced) ranges served in a single response
+    static constexpr size_t MAX_RANGES = 32;
+
+    Vector<ByteRange> entries;
+    // `false` if the header is missing, malformed, or not in `bytes` units,
+    // in which case the header should be ignored
+    bool valid = false;
+    // `false` if no range overlapped the representation (416)
+    bool satisfiable = false;
+
+    static ByteRanges parse (const String& header, size_t size);
+
+    size_t size () const;
+    bool empty () const;
+  };
+
   class Headers {
     public:
       class Value {
@@ -0,0 +1,50 @@
+#include "../http.hh"
+#include "../string.hh"
+
+#include <iomanip>
+
+using ssc::runtime::string::trim;
+
+namespace ssc::runtime::http {
+  static constexpr auto HTTP_DATE_FORMAT = "%a, %d %b %Y %H:%M:%S GMT";
+
+  String formatDate (time_t time) {
+    struct tm value = {0};
+    char output[64] = {0};
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    if (gmtime_s(&value, &time) != 0) {
+      return "";
+    }
+  #else
+    if (gmtime_r(&time, &value) == nullptr) {
+      return "";
+    }
+  #endif
+
+    // `strftime()` is locale dependent, but the runtime never sets
+    // `LC_TIME` so day and month names are always in the "C" locale
+    const auto size = strftime(output, sizeof(output), HTTP_DATE_FORMAT, &value);
+    return String(output, size);
+  }
+
+  time_t parseDate (const String& input) {
+    struct tm value = {0};
+    auto stream = std::istringstream(trim(input));
+
+    stream.imbue(std::locale::classic());
+    stream >> std::get_time(&value, HTTP_DATE_FORMAT);
+
+    if (stream.fail()) {
+      return 0;
+    }
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    const auto time = _mkgmtime(&value);
+  #else
+    const auto time = timegm(&value);
+  #endif
+
+    return time > 0 ? time : 0;
+  }
+}
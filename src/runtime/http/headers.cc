@@ -44,9 +44,10 @@ namespace ssc::runtime::http {
 
   Headers::Headers (const String& source) {
     for (const auto& entry : split(source, '\n')) {
-      const auto tuple = split(entry, ':');
-      if (tuple.size() == 2) {
-        this->set(trim(tuple.front()), trim(tuple.back()));
+      // values may contain `:` (dates, URLs) so only the first one separates
+      const auto separator = entry.find(':');
+      if (separator != String::npos && separator > 0) {
+        this->set(trim(entry.substr(0, separator)), trim(entry.substr(separator + 1)));
       }
     }
   }
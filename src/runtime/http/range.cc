@@ -0,0 +1,164 @@
+#include "../http.hh"
+#include "../string.hh"
+
+using ssc::runtime::string::split;
+using ssc::runtime::string::toLowerCase;
+using ssc::runtime::string::trim;
+
+namespace ssc::runtime::http {
+  static bool parseRangeValue (const String& input, size_t& output) {
+    if (input.size() == 0 || input.size() > 19) {
+      return false;
+    }
+
+    size_t value = 0;
+    for (const auto character : input) {
+      if (character < '0' || character > '9') {
+        return false;
+      }
+
+      value = (value * 10) + (character - '0');
+    }
+
+    output = value;
+    return true;
+  }
+
+  size_t ByteRange::size () const {
+    return this->end - this->start + 1;
+  }
+
+  String ByteRange::str (size_t total) const {
+    return (
+      "bytes " +
+      std::to_string(this->start) + "-" +
+      std::to_string(this->end) + "/" +
+      std::to_string(total)
+    );
+  }
+
+  ByteRanges ByteRanges::parse (const String& header, size_t size) {
+    auto ranges = ByteRanges {};
+    const auto value = trim(header);
+    const auto equals = value.find('=');
+
+    if (equals == String::npos) {
+      return ranges;
+    }
+
+    if (toLowerCase(trim(value.substr(0, equals))) != "bytes") {
+      return ranges;
+    }
+
+    const auto specs = split(value.substr(equals + 1), ',');
+    if (specs.size() == 0) {
+      return ranges;
+    }
+
+    bool hasSpecs = false;
+
+    for (const auto& entry : specs) {
+      const auto spec = trim(entry);
+      const auto dash = spec.find('-');
+
+      if (spec.size() == 0) {
+        continue;
+      }
+
+      hasSpecs = true;
+
+      if (dash == String::npos) {
+        return ByteRanges {};
+      }
+
+      const auto first = trim(spec.substr(0, dash));
+      const auto last = trim(spec.substr(dash + 1));
+      size_t start = 0;
+      size_t end = 0;
+
+      if (first.size() == 0) {
+        // suffix range: `-<length>`
+        size_t length = 0;
+        if (!parseRangeValue(last, length)) {
+          return ByteRanges {};
+        }
+
+        if (length == 0 || size == 0) {
+          continue;
+        }
+
+        start = length >= size ? 0 : size - length;
+        end = size - 1;
+      } else {
+        if (!parseRangeValue(first, start)) {
+          return ByteRanges {};
+        }
+
+        if (last.size() == 0) {
+          end = size > 0 ? size - 1 : 0;
+        } else if (!parseRangeValue(last, end) || end < start) {
+          return ByteRanges {};
+        }
+
+        if (start >= size) {
+          continue;
+        }
+
+        if (end >= size) {
+          end = size - 1;
+        }
+      }
+
+      ranges.entries.push_back(ByteRange { start, end });
+    }
+
+    // `bytes=` (or only empty specs) is not a range request, so it is
+    // ignored and the full representation is served instead of a 416
+    if (!hasSpecs) {
+      return ByteRanges {};
+    }
+
+    ranges.valid = true;
+    ranges.satisfiable = ranges.entries.size() > 0;
+
+    if (ranges.entries.size() > 1) {
+      std::sort(
+        ranges.entries.begin(),
+        ranges.entries.end(),
+        [](const auto& a, const auto& b) { return a.start < b.start; }
+      );
+
+      auto coalesced = Vector<ByteRange> {};
+      for (const auto& range : ranges.entries) {
+        if (coalesced.size() > 0 && range.start <= coalesced.back().end + 1) {
+          if (range.end > coalesced.back().end) {
+            coalesced.back().end = range.end;
+          }
+        } else {
+          coalesced.push_back(range);
+        }
+      }
+
+      // too many disjoint ranges are served as a single range
+      // spanning all of them
+      if (coalesced.size() > MAX_RANGES) {
+        const auto start = coalesced.front().start;
+        const auto end = coalesced.back().end;
+        coalesced.clear();
+        coalesced.push_back(ByteRange { start, end });
+      }
+
+      ranges.entries = coalesced;
+    }
+
+    return ranges;
+  }
+
+  size_t ByteRanges::size () const {
+    return this->entries.size();
+  }
+
+  bool ByteRanges::empty () const {
+    return this->entries.empty();
+  }
+}
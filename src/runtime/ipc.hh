@@ -29,9 +29,20 @@ namespace ssc::runtime::ipc {
     {}
   };
 
+  /**
+   * A cancellation handler for an HTTP IPC request. The handler may be set,
+   * cleared and called from different threads.
+   */
   struct MessageCancellation {
-    void (*handler)(void*) = nullptr;
+    using Handler = void (*)(void*);
+
+    Handler handler = nullptr;
     void* data = nullptr;
+    Mutex mutex;
+
+    void set (Handler handler, void* data);
+    bool reset (void* data);
+    bool cancel ();
   };
 
   class Message {
@@ -135,9 +146,55 @@ namespace ssc::runtime::ipc {
         ReplyCallback
       )>;
 
+      /**
+       * Counters for a mapped route, updated lock-free from any thread.
+       * Latencies are measured in microseconds from `invoke()` until the
+       * route first replies and are kept in a log-linear histogram with four
+       * buckets per power of two, so percentiles are within 25%.
+       */
+      struct RouteStats {
+        static constexpr size_t LATENCY_SUB_BUCKETS = 4;
+        // the last bucket holds everything above ~33 seconds
+        static constexpr size_t LATENCY_BUCKETS = 96;
+
+        struct Snapshot {
+          uint64_t calls = 0;
+          uint64_t errors = 0;
+          uint64_t bytesIn = 0;
+          uint64_t bytesOut = 0;
+          uint64_t replies = 0;
+          // latencies in microseconds
+          uint64_t averageLatency = 0;
+          uint64_t p50 = 0;
+          uint64_t p99 = 0;
+          uint64_t maxLatency = 0;
+          JSON::Object json () const;
+        };
+
+        Atomic<uint64_t> calls = 0;
+        Atomic<uint64_t> errors = 0;
+        // payload bytes: the message URI and body in, the response body out
+        Atomic<uint64_t> bytesIn = 0;
+        Atomic<uint64_t> bytesOut = 0;
+        Atomic<uint64_t> replies = 0;
+        Atomic<uint64_t> totalLatency = 0;
+        Atomic<uint64_t> maxLatency = 0;
+        Atomic<uint64_t> latencies[LATENCY_BUCKETS] = {};
+
+        static uint64_t now ();
+        static size_t getLatencyBucket (uint64_t latency);
+        static uint64_t getLatencyBucketLimit (size_t bucket);
+
+        void call (size_t bytes);
+        void reply (uint64_t latency, size_t bytes, bool error);
+        Snapshot snapshot () const;
+      };
+
       struct MessageCallbackContext {
         bool async = true;
         MessageCallback callback;
+        // shared by copies of this context, such as the preserved table
+        SharedPointer<RouteStats> stats = nullptr;
       };
 
       struct MessageCallbackListenerContext {
@@ -146,6 +203,7 @@ namespace ssc::runtime::ipc {
       };
 
       using Table = Map<String, MessageCallbackContext>;
+      using Stats = Map<String, RouteStats::Snapshot>;
       using Listeners = Map<String, Vector<MessageCallbackListenerContext>>;
 
     private:
@@ -156,7 +214,8 @@ namespace ssc::runtime::ipc {
       bridge::Bridge& bridge;
 
       Listeners listeners;
-      Mutex mutex;
+      // guards `table` and the preserved table
+      mutable Mutex mutex;
       Table table;
 
       // owned by bridge
@@ -182,6 +241,8 @@ namespace ssc::runtime::ipc {
       bool invoke (const String& uri, SharedPointer<unsigned char[]> bytes, size_t size);
       bool invoke (const String&, SharedPointer<unsigned char[]>, size_t, const ResultCallback);
       bool invoke (const Message&, SharedPointer<unsigned char[]>, size_t, const ResultCallback);
+      bool stats (const String& name, RouteStats::Snapshot& snapshot) const;
+      Stats stats () const;
   };
 
   /**
@@ -6,6 +6,35 @@
 using ssc::runtime::url::decodeURIComponent;
 
 namespace ssc::runtime::ipc {
+  void MessageCancellation::set (Handler handler, void* data) {
+    Lock lock(this->mutex);
+    this->handler = handler;
+    this->data = data;
+  }
+
+  bool MessageCancellation::reset (void* data) {
+    Lock lock(this->mutex);
+    // only the handler for `data`, another one may have replaced it
+    if (this->data != data) {
+      return false;
+    }
+
+    this->handler = nullptr;
+    this->data = nullptr;
+    return true;
+  }
+
+  bool MessageCancellation::cancel () {
+    // held while the handler runs, so `reset()` waits for it to return
+    Lock lock(this->mutex);
+    if (this->handler == nullptr) {
+      return false;
+    }
+
+    this->handler(this->data);
+    return true;
+  }
+
   Message::Message (const String& source, bool decodeValues)
     : uri(source, decodeValues)
   {
@@ -1,3 +1,6 @@
+#include <bit>
+
+#include "../runtime.hh"
 #include "../bridge.hh"
 #include "../crypto.hh"
 #include "../string.hh"
@@ -7,6 +10,131 @@ using ssc::runtime::string::toLowerCase;
 using ssc::runtime::crypto::rand64;
 
 namespace ssc::runtime::ipc {
+  static bool isErrorResult (const Result& result) {
+    if (!result.err.isNull()) {
+      return true;
+    }
+
+    if (result.value.isObject()) {
+      const auto& object = result.value.as<JSON::Object>();
+      return object.has("err") && !object.get("err").isNull();
+    }
+
+    return false;
+  }
+
+  uint64_t Router::RouteStats::now () {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+  }
+
+  size_t Router::RouteStats::getLatencyBucket (uint64_t latency) {
+    if (latency < LATENCY_SUB_BUCKETS) {
+      return latency;
+    }
+
+    // the power of two selects a group of buckets, the next two
+    // significant bits select the bucket in that group
+    const auto exponent = std::bit_width(latency) - 1;
+    const auto bucket = (exponent - 1) * LATENCY_SUB_BUCKETS + ((latency >> (exponent - 2)) & 3);
+    return std::min(static_cast<size_t>(bucket), LATENCY_BUCKETS - 1);
+  }
+
+  uint64_t Router::RouteStats::getLatencyBucketLimit (size_t bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+      return bucket;
+    }
+
+    const auto exponent = bucket / LATENCY_SUB_BUCKETS + 1;
+    const auto width = uint64_t(1) << (exponent - 2);
+    return (LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS) * width + width - 1;
+  }
+
+  void Router::RouteStats::call (size_t bytes) {
+    this->calls.fetch_add(1, std::memory_order_relaxed);
+    this->bytesIn.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void Router::RouteStats::reply (uint64_t latency, size_t bytes, bool error) {
+    this->replies.fetch_add(1, std::memory_order_relaxed);
+    this->bytesOut.fetch_add(bytes, std::memory_order_relaxed);
+    this->totalLatency.fetch_add(latency, std::memory_order_relaxed);
+    this->latencies[getLatencyBucket(latency)].fetch_add(1, std::memory_order_relaxed);
+
+    if (error) {
+      this->errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto max = this->maxLatency.load(std::memory_order_relaxed);
+    while (latency > max && !this->maxLatency.compare_exchange_weak(
+      max,
+      latency,
+      std::memory_order_relaxed
+    ));
+  }
+
+  Router::RouteStats::Snapshot Router::RouteStats::snapshot () const {
+    uint64_t buckets[LATENCY_BUCKETS];
+    uint64_t count = 0;
+    Snapshot snapshot;
+
+    // counters are read independently, a snapshot taken while the route is
+    // called may be off by the calls in flight
+    snapshot.calls = this->calls.load(std::memory_order_relaxed);
+    snapshot.errors = this->errors.load(std::memory_order_relaxed);
+    snapshot.bytesIn = this->bytesIn.load(std::memory_order_relaxed);
+    snapshot.bytesOut = this->bytesOut.load(std::memory_order_relaxed);
+    snapshot.replies = this->replies.load(std::memory_order_relaxed);
+    snapshot.maxLatency = this->maxLatency.load(std::memory_order_relaxed);
+
+    for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+      buckets[i] = this->latencies[i].load(std::memory_order_relaxed);
+      count += buckets[i];
+    }
+
+    if (count == 0) {
+      return snapshot;
+    }
+
+    snapshot.averageLatency = this->totalLatency.load(std::memory_order_relaxed) / count;
+
+    const auto percentile = [&](uint64_t p) -> uint64_t {
+      const auto rank = std::max<uint64_t>(1, (count * p + 99) / 100);
+      uint64_t seen = 0;
+      for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+          return std::min(getLatencyBucketLimit(i), snapshot.maxLatency);
+        }
+      }
+
+      return snapshot.maxLatency;
+    };
+
+    snapshot.p50 = percentile(50);
+    snapshot.p99 = percentile(99);
+    return snapshot;
+  }
+
+  JSON::Object Router::RouteStats::Snapshot::json () const {
+    return JSON::Object::Entries {
+      {"calls", this->calls},
+      {"replies", this->replies},
+      {"errors", this->errors},
+      {"bytes", JSON::Object::Entries {
+        {"in", this->bytesIn},
+        {"out", this->bytesOut}
+      }},
+      {"latency", JSON::Object::Entries {
+        {"average", this->averageLatency},
+        {"p50", this->p50},
+        {"p99", this->p99},
+        {"max", this->maxLatency}
+      }}
+    };
+  }
+
   Router::Router (bridge::Bridge& bridge)
     : dispatcher(bridge.dispatcher),
       bridge(bridge)
@@ -18,6 +146,7 @@ namespace ssc::runtime::ipc {
   }
 
   void Router::preserveCurrentTable () {
+    Lock lock(this->mutex);
     this->preserved = this->table;
   }
 
@@ -66,14 +195,17 @@ namespace ssc::runtime::ipc {
   ) {
     if (callback != nullptr) {
       const auto key = toLowerCase(name);
+      Lock lock(this->mutex);
       this->table.insert_or_assign(key, MessageCallbackContext {
         async,
-        callback
+        callback,
+        std::make_shared<RouteStats>()
       });
     }
   }
 
   void Router::unmap (const String& name) {
+    Lock lock(this->mutex);
     this->table.erase(toLowerCase(name));
   }
 
@@ -122,13 +254,16 @@ namespace ssc::runtime::ipc {
 
     // lookup router function in the preserved table,
     // then the public table, return if unable to determine a context
-    if (this->preserved.contains(name)) {
-      context = this->preserved.at(name);
-    } else if (this->table.contains(name)) {
-      context = this->table.at(name);
-    } else {
-      return false;
-    }
+    do {
+      Lock lock(this->mutex);
+      if (this->preserved.contains(name)) {
+        context = this->preserved.at(name);
+      } else if (this->table.contains(name)) {
+        context = this->table.at(name);
+      } else {
+        return false;
+      }
+    } while (0);
 
     if (context.callback == nullptr) {
       return false;
@@ -156,34 +291,104 @@ namespace ssc::runtime::ipc {
       }
     }
 
+    if (context.stats != nullptr) {
+      context.stats->call(incomingMessage.href.size() + size);
+    }
+
+    auto reply = ReplyCallback([
+      this,
+      stats = context.stats,
+      seq = incomingMessage.seq,
+      started = RouteStats::now(),
+      // shared by copies of this callback
+      replied = std::make_shared<AtomicBool>(false),
+      callback = std::move(callback)
+    ](const auto result) mutable {
+      // only the first reply to this message completes the call, not the
+      // events (seq `-1`) a route may send before it or the further replies
+      // of a chunked or event stream
+      if (stats != nullptr && result.seq == seq && !replied->exchange(true)) {
+        stats->reply(
+          RouteStats::now() - started,
+          result.queuedResponse.length,
+          isErrorResult(result)
+        );
+      }
+
+      const auto deliver = [this, callback] (const Result& result) {
+        if (result.seq == "-1") {
+          this->bridge.send(result.seq, result.str(), result.queuedResponse);
+        } else {
+          callback(result);
+        }
+      };
+
+      // services on a dedicated loop reply from its thread, the reply is
+      // marshalled to the main thread before it reaches the webview or a
+      // scheme handler response, neither of which are thread safe
+      if (this->bridge.getRuntime()->services.isDedicatedLoopThread()) {
+        this->bridge.dispatch([deliver, result] () {
+          deliver(result);
+        });
+      } else {
+        deliver(result);
+      }
+    });
+
     if (context.async) {
       return this->dispatcher.dispatch([
         this,
         context = std::move(context),
-        callback = std::move(callback),
+        reply = std::move(reply),
         incomingMessage = std::move(incomingMessage)
       ]() mutable {
-        context.callback(incomingMessage, this, [this, incomingMessage, callback](const auto result) mutable {
-          if (result.seq == "-1") {
-            this->bridge.send(result.seq, result.str(), result.queuedResponse);
-          } else {
-            callback(result);
-          }
-        });
+        context.callback(incomingMessage, this, reply);
       });
     }
 
-    context.callback(incomingMessage, this, [
-      this,
-      callback = std::move(callback)
-    ](const auto result) mutable {
-      if (result.seq == "-1") {
-        this->bridge.send(result.seq, result.str(), result.queuedResponse);
-      } else {
-        callback(result);
+    context.callback(incomingMessage, this, reply);
+    return true;
+  }
+
+  bool Router::stats (const String& name, RouteStats::Snapshot& snapshot) const {
+    const auto key = toLowerCase(name);
+    SharedPointer<RouteStats> stats = nullptr;
+
+    // resolved in the same order as `invoke()`
+    do {
+      Lock lock(this->mutex);
+      if (this->preserved.contains(key)) {
+        stats = this->preserved.at(key).stats;
+      } else if (this->table.contains(key)) {
+        stats = this->table.at(key).stats;
       }
-    });
+    } while (0);
 
+    if (stats == nullptr) {
+      return false;
+    }
+
+    snapshot = stats->snapshot();
     return true;
   }
+
+  Router::Stats Router::stats () const {
+    Lock lock(this->mutex);
+    Stats stats;
+
+    // routes that were never called are left out
+    for (const auto& table : { &this->preserved, &this->table }) {
+      for (const auto& entry : *table) {
+        if (
+          entry.second.stats != nullptr &&
+          entry.second.stats->calls.load(std::memory_order_relaxed) > 0 &&
+          !stats.contains(entry.first)
+        ) {
+          stats.insert_or_assign(entry.first, entry.second.stats->snapshot());
+        }
+      }
+    }
+
+    return stats;
+  }
 }
@@ -67,6 +67,50 @@ static JSON::Any validateMessageParameters (
   return nullptr;
 }
 
+// resolves the service worker server of the `origin` in the message (or of
+// the bridge) the same way the `serviceWorker.*` routes do, falling back to
+// the server of the bridge's navigator
+static SharedPointer<serviceworker::Server> getServiceWorkerServer (
+  const Message& message,
+  Router* router
+) {
+  const auto origin = webview::Origin(
+    message.get("origin", router->bridge.navigator.location.origin)
+  );
+
+  auto serviceWorkerServer = router->bridge.getRuntime()->serviceWorkerManager.get(origin.name());
+
+  if (!serviceWorkerServer) {
+    serviceWorkerServer = router->bridge.navigator.serviceWorkerServer;
+  }
+
+  return serviceWorkerServer;
+}
+
+// resolves the service worker cache for the `serviceWorker.cache.*` routes,
+// replying with a `NotFoundError` and returning `nullptr` if there is no
+// service worker server for the origin, the cache keeps its server alive
+static SharedPointer<serviceworker::Cache> getServiceWorkerCache (
+  const Message& message,
+  Router* router,
+  const Router::ReplyCallback& reply
+) {
+  const auto serviceWorkerServer = getServiceWorkerServer(message, router);
+
+  if (!serviceWorkerServer) {
+    reply(Result::Err { message, JSON::Object::Entries {
+      {"type", "NotFoundError"},
+      {"message", "Service worker server not found for origin"}
+    }});
+    return nullptr;
+  }
+
+  return SharedPointer<serviceworker::Cache>(
+    serviceWorkerServer,
+    &serviceWorkerServer->container.cache
+  );
+}
+
 static void mapIPCRoutes (Router *router) {
   auto userConfig = router->bridge.getRuntime()->userConfig;
 
@@ -992,6 +1036,7 @@ static void mapIPCRoutes (Router *router) {
    *
    * @param id
    * @param args (command, ...args)
+   * @param stream Stream output with `child_process.stream` [default = false]
    */
   router->map("child_process.spawn", [](auto message, auto router, auto reply) {
     #if SOCKET_RUNTIME_PLATFORM_IOS
@@ -1035,7 +1080,14 @@ static void mapIPCRoutes (Router *router) {
         .env = env,
         .allowStdin = message.get("stdin") != "false",
         .allowStdout = message.get("stdout") != "false",
-        .allowStderr = message.get("stderr") != "false"
+        .allowStderr = message.get("stderr") != "false",
+        .raw = message.get("stream") == "true",
+        // output is posted as raw chunks where a scheme handler response
+        // would only reach the webview once the child process exited
+        .stream = (
+          message.get("stream") == "true" &&
+          webview::SchemeHandlers::Response::STREAMS_WRITES
+        )
       };
 
       router->bridge.getRuntime()->services.process.spawn(
@@ -1152,12 +1204,203 @@ static void mapIPCRoutes (Router *router) {
     #endif
   });
 
+  /**
+   * Streams the output of a child process spawned with `stream=true` as a
+   * chunked response. Reading from the child process is paused while too
+   * much output is waiting to be read.
+   *
+   * @param id
+   * @param source `stdout` or `stderr` [default = stdout]
+   */
+  router->map("child_process.stream", [](auto message, auto router, auto reply) {
+    #if SOCKET_RUNTIME_PLATFORM_IOS
+      auto err = JSON::Object::Entries {
+        {"type", "NotSupportedError"},
+        {"message", "Operation is not supported on this platform"}
+      };
+
+      return reply(Result::Err { message, err });
+    #else
+      auto err = validateMessageParameters(message, {"id"});
+
+      if (err.type != JSON::Type::Null) {
+        return reply(Result::Err { message, err });
+      }
+
+      if (!message.isHTTP) {
+        auto err = JSON::Object::Entries {
+          {"type", "NotSupportedError"},
+          {"message", "Child process output can only be streamed with a HTTP request"}
+        };
+
+        return reply(Result::Err { message, err });
+      }
+
+      const auto source = message.get("source", "stdout");
+
+      if (source != "stdout" && source != "stderr") {
+        auto err = JSON::Object::Entries {
+          {"type", "TypeError"},
+          {"message", "Expecting 'source' to be 'stdout' or 'stderr'"}
+        };
+
+        return reply(Result::Err { message, err });
+      }
+
+      uint64_t id;
+      REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+      router->bridge.getRuntime()->services.process.stream(
+        message.seq,
+        id,
+        source,
+        RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+      );
+    #endif
+  });
+
+  /**
+   * Pauses reading the output of a child process.
+   *
+   * @param id
+   */
+  router->map("child_process.pause", [](auto message, auto router, auto reply) {
+    #if SOCKET_RUNTIME_PLATFORM_IOS
+      auto err = JSON::Object::Entries {
+        {"type", "NotSupportedError"},
+        {"message", "Operation is not supported on this platform"}
+      };
+
+      return reply(Result::Err { message, err });
+    #else
+      auto err = validateMessageParameters(message, {"id"});
+
+      if (err.type != JSON::Type::Null) {
+        return reply(Result::Err { message, err });
+      }
+
+      uint64_t id;
+      REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+      router->bridge.getRuntime()->services.process.pause(
+        message.seq,
+        id,
+        RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+      );
+    #endif
+  });
+
+  /**
+   * Resumes reading the output of a paused child process.
+   *
+   * @param id
+   */
+  router->map("child_process.resume", [](auto message, auto router, auto reply) {
+    #if SOCKET_RUNTIME_PLATFORM_IOS
+      auto err = JSON::Object::Entries {
+        {"type", "NotSupportedError"},
+        {"message", "Operation is not supported on this platform"}
+      };
+
+      return reply(Result::Err { message, err });
+    #else
+      auto err = validateMessageParameters(message, {"id"});
+
+      if (err.type != JSON::Type::Null) {
+        return reply(Result::Err { message, err });
+      }
+
+      uint64_t id;
+      REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+
+      router->bridge.getRuntime()->services.process.resume(
+        message.seq,
+        id,
+        RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+      );
+    #endif
+  });
+
+  /**
+   * Computes a digest of an open file descriptor, a file, or the request
+   * body on the libuv threadpool.
+   *
+   * @param algorithm `sha1`, `sha256` or `blake3` [default = sha256]
+   * @param id An open file descriptor id (optional)
+   * @param path A path to a file (optional)
+   * @param progress An id progress is posted with for large inputs (optional)
+   */
+  router->map("crypto.digest", [](auto message, auto router, auto reply) {
+    auto algorithm = crypto::Digest::Algorithm::SHA256;
+
+    if (
+      message.has("algorithm") &&
+      !crypto::Digest::getAlgorithm(message.get("algorithm"), algorithm)
+    ) {
+      auto err = JSON::Object::Entries {
+        {"type", "NotSupportedError"},
+        {"message", "Unsupported digest algorithm: " + message.get("algorithm")}
+      };
+
+      return reply(Result::Err { message, err });
+    }
+
+    uint64_t id = 0;
+    uint64_t progress = 0;
+
+    if (message.has("id")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
+    }
+
+    if (message.has("progress")) {
+      REQUIRE_AND_GET_MESSAGE_VALUE(progress, "progress", std::stoull);
+    }
+
+    const auto options = ssc::runtime::core::services::Crypto::DigestOptions {
+      .algorithm = algorithm,
+      .descriptor = id,
+      .path = message.get("path"),
+      .bytes = message.buffer.shared(),
+      .size = message.buffer.size(),
+      .progress = progress
+    };
+
+    router->bridge.getRuntime()->services.crypto.digest(
+      message.seq,
+      options,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
+  /**
+   * Generates `size` cryptographically secure random bytes natively.
+   * @param size The number of bytes to generate
+   */
+  router->map("crypto.getRandomValues", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"size"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result::Err { message, err });
+    }
+
+    size_t size = 0;
+    REQUIRE_AND_GET_MESSAGE_VALUE(size, "size", std::stoull);
+
+    router->bridge.getRuntime()->services.crypto.getRandomValues(
+      message.seq,
+      size,
+      RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
+    );
+  });
+
   /**
    * Query diagnostics information about the runtime core.
    */
   router->map("diagnostics.query", [](auto message, auto router, auto reply) {
+    // route counters are snapshot here, on the thread routes are invoked on
     router->bridge.getRuntime()->services.diagnostics.query(
       message.seq,
+      router->stats(),
       RESULT_CALLBACK_FROM_CORE_CALLBACK(message, reply)
     );
   });
@@ -2690,7 +2933,10 @@ static void mapIPCRoutes (Router *router) {
     uint64_t id;
     REQUIRE_AND_GET_MESSAGE_VALUE(id, "id", std::stoull);
 
-    if (!router->bridge.getRuntime()->queuedResponses.contains(id)) {
+    auto result = Result { message.seq, message };
+
+    // expired (or evicted) responses are gone, like ones that never existed
+    if (!router->bridge.getRuntime()->queuedResponses.take(id, result.queuedResponse)) {
       return reply(Result::Err { message, JSON::Object::Entries {
         {"id", std::to_string(id)},
         {"type", "NotFoundError"},
@@ -2698,10 +2944,7 @@ static void mapIPCRoutes (Router *router) {
       }});
     }
 
-    auto result = Result { message.seq, message };
-    result.queuedResponse = router->bridge.getRuntime()->queuedResponses[id];
     reply(result);
-    router->bridge.getRuntime()->queuedResponses.erase(id);
   });
 
   /**
@@ -3392,6 +3635,240 @@ static void mapIPCRoutes (Router *router) {
     });
   });
 
+  /**
+   * Opens (creates) a named service worker cache.
+   * @param name
+   */
+  router->map("serviceWorker.cache.open", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    if (!cache->open(message.get("name"))) {
+      return reply(Result::Err { message, JSON::Object::Entries {
+        {"message", "Failed to open cache"}
+      }});
+    }
+
+    reply(Result::Data { message, JSON::Object {}});
+  });
+
+  /**
+   * Queries if a named service worker cache exists.
+   * @param name
+   */
+  router->map("serviceWorker.cache.has", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    reply(Result::Data { message, JSON::Object::Entries {
+      {"has", cache->has(message.get("name"))}
+    }});
+  });
+
+  /**
+   * Deletes a named service worker cache and all of its entries.
+   * @param name
+   */
+  router->map("serviceWorker.cache.delete", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    reply(Result::Data { message, JSON::Object::Entries {
+      {"deleted", cache->destroy(message.get("name"))}
+    }});
+  });
+
+  /**
+   * Gets the names of all service worker caches in creation order.
+   */
+  router->map("serviceWorker.cache.names", [](auto message, auto router, auto reply) {
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    auto names = JSON::Array {};
+
+    do {
+      Lock lock(cache->mutex);
+      for (const auto& name : cache->names) {
+        names.push(name);
+      }
+    } while (0);
+
+    reply(Result::Data { message, names });
+  });
+
+  /**
+   * Gets the request URLs of the entries in a service worker cache.
+   * @param name
+   */
+  router->map("serviceWorker.cache.keys", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    auto keys = JSON::Array {};
+
+    for (const auto& key : cache->keys(message.get("name"))) {
+      keys.push(key);
+    }
+
+    reply(Result::Data { message, keys });
+  });
+
+  /**
+   * Puts a response (the message buffer is its body) for a request in a
+   * service worker cache.
+   * @param name
+   * @param url
+   * @param statusCode
+   * @param headers
+   * @param requestHeaders
+   */
+  router->map("serviceWorker.cache.put", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name", "url", "statusCode"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    int statusCode;
+    REQUIRE_AND_GET_MESSAGE_VALUE(statusCode, "statusCode", std::stoi);
+
+    auto request = serviceworker::Request();
+    request.method = "GET";
+    request.url = URL(message.get("url"));
+    request.headers = http::Headers(message.get("requestHeaders"));
+
+    auto response = serviceworker::Response(statusCode);
+    response.statusCode = statusCode;
+    response.headers = http::Headers(message.get("headers"));
+    response.body = bytes::Buffer::from(message.buffer);
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    if (!cache->put(message.get("name"), request, response)) {
+      return reply(Result::Err { message, JSON::Object::Entries {
+        {"message", "Failed to put response in cache"}
+      }});
+    }
+
+    reply(Result::Data { message, JSON::Object {}});
+  });
+
+  /**
+   * Matches a request in all (or a named) service worker caches. The body
+   * of the matched response is the reply body and its headers are the reply
+   * headers. An empty object is the reply when nothing matched.
+   * @param url
+   * @param headers
+   * @param name
+   */
+  router->map("serviceWorker.cache.match", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"url"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    auto request = serviceworker::Request();
+    request.method = "GET";
+    request.url = URL(message.get("url"));
+    request.headers = http::Headers(message.get("headers"));
+
+    auto response = serviceworker::Response(404);
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+
+    if (!cache->match(request, response, message.get("name"))) {
+      return reply(Result::Data { message, JSON::Object {}});
+    }
+
+    // the cached status travels with the cached headers because the reply
+    // body is the cached response body
+    auto headers = response.headers;
+    headers.set("x-service-worker-cache-status", std::to_string(response.statusCode));
+
+    reply(Result {
+      message.seq,
+      message,
+      JSON::Object {},
+      QueuedResponse {
+        rand64(),
+        0,
+        response.body.shared(),
+        response.body.size(),
+        headers.str()
+      }
+    });
+  });
+
+  /**
+   * Removes the entries matching a request from a service worker cache.
+   * @param name
+   * @param url
+   * @param headers
+   */
+  router->map("serviceWorker.cache.remove", [](auto message, auto router, auto reply) {
+    auto err = validateMessageParameters(message, {"name", "url"});
+
+    if (err.type != JSON::Type::Null) {
+      return reply(Result { message.seq, message, err });
+    }
+
+    auto request = serviceworker::Request();
+    request.method = "GET";
+    request.url = URL(message.get("url"));
+    request.headers = http::Headers(message.get("headers"));
+
+    const auto cache = getServiceWorkerCache(message, router, reply);
+
+    if (cache == nullptr) {
+      return;
+    }
+    reply(Result::Data { message, JSON::Object::Entries {
+      {"deleted", cache->remove(message.get("name"), request)}
+    }});
+  });
+
   router->map("timers.setTimeout", [](auto message, auto router, auto reply) {
     auto err = validateMessageParameters(message, {"timeout"});
 
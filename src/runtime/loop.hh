@@ -41,6 +41,45 @@ namespace ssc::runtime::loop {
         Shutdown = 5 // loop is shutdown, it cannot be restored
       };
 
+      /**
+       * Priorities of dispatched callbacks. All `High` callbacks (I/O
+       * completions) queued when the loop drains its queues run before
+       * `Default` callbacks, which run before `Low` (background) callbacks.
+       */
+      enum class Priority {
+        High,
+        Default,
+        Low
+      };
+
+      // the number of `Priority` levels, each has its own queue
+      static constexpr size_t PRIORITIES = 3;
+
+      /**
+       * A multiple producer, single consumer queue of dispatched callbacks.
+       * Producers push onto a lock-free stack and the loop thread takes
+       * the whole batch with a single exchange.
+       */
+      struct DispatchQueue {
+        struct Node {
+          DispatchCallback callback = nullptr;
+          Node* next = nullptr;
+        };
+
+        Atomic<Node*> head = nullptr;
+
+        /**
+         * Pushes a callback onto the queue, returning `true` if the queue
+         * was empty before it.
+         */
+        bool push (const DispatchCallback&);
+
+        /**
+         * Takes all queued callbacks, in the order they were pushed.
+         */
+        Node* drain ();
+      };
+
       /**
        * Various options to configure the event loop
        */
@@ -50,6 +89,10 @@ namespace ssc::runtime::loop {
       #else
         bool dedicatedThread = false;
       #endif
+
+        // the time (in milliseconds) dispatched callbacks may run for before
+        // the loop yields to polling for I/O, `0` disables the budget
+        uint64_t dispatchTimeBudget = 8;
       };
 
     #if SOCKET_RUNTIME_PLATFORM_LINUX
@@ -73,7 +116,10 @@ namespace ssc::runtime::loop {
     #endif
 
       const Options options;
-      Queue<DispatchCallback> queue;
+      DispatchQueue queues[PRIORITIES];
+      // callbacks taken from `queues`, but not yet run when the dispatch
+      // time budget ran out (only touched on the loop thread)
+      DispatchQueue::Node* backlog[PRIORITIES] = {};
       Thread thread;
       Mutex mutex;
       Atomic<State> state = State::None;
@@ -83,6 +129,7 @@ namespace ssc::runtime::loop {
       Loop (const Options&);
       Loop (const Loop&) = delete;
       Loop (Loop&&) = delete;
+      ~Loop ();
 
       Loop& operator = (const Loop&) = delete;
       Loop& operator = (Loop&&) = delete;
@@ -136,7 +183,20 @@ namespace ssc::runtime::loop {
        * This function returns `true` if the loop is in an "active" state
        * such that `state > State::Init && state < State::Paused`.
        */
-      bool dispatch (const DispatchCallback&);
+      bool dispatch (const DispatchCallback&, const Priority = Priority::Default);
+
+      /**
+       * Hands a callback off to this loop from another loop (or thread).
+       * The callback is called right away if the calling thread is already
+       * running this loop, otherwise it is dispatched with `dispatch()`.
+       * This function returns `true` if the callback was called or queued.
+       */
+      bool handoff (const DispatchCallback&, const Priority = Priority::Default);
+
+      /**
+       * Returns `true` if the calling thread is currently running this loop.
+       */
+      bool isCurrentThread () const;
 
       /**
        * Shuts down the loop, transitioning it into a state that cannot be
@@ -6,38 +6,82 @@ struct UVSource {
   GSource base; // should ALWAYS be first member
   gpointer tag;
   ssc::runtime::loop::Loop* loop = nullptr;
+  // deadline (monotonic milliseconds) of the next libuv timer, `0` for none
+  uint64_t deadline = 0;
+  // deadline the source was last dispatched for
+  uint64_t dispatchedDeadline = 0;
 };
 #endif
 
 namespace ssc::runtime::loop {
-  // in milliseconds
-  constexpr int EVENT_LOOP_POLL_TIMEOUT = 32;
+  // the loop the calling thread is running, if any
+  static thread_local const Loop* currentLoop = nullptr;
 
   // async work is dispatched here which will cause the loop state
   // to transitions to `State::Polling` while in a dequeue loop and
   // then finally back to `State::Idle`
   static void onAsyncThread (uv_async_t* async) {
     auto loop = reinterpret_cast<Loop*>(async->data);
-    Loop::DispatchCallback callback = nullptr;
+    const auto budget = loop->options.dispatchTimeBudget * 1000000;
+    const auto start = budget > 0 ? uv_hrtime() : 0;
+    bool yielded = false;
+
     // transition to `State::Polling` while waiting
     loop->state = Loop::State::Polling;
 
-    while (true) {
-      do {
-        Lock lock(loop->mutex);
-        // dequeue dispatched callback
-        if (loop->queue.size() > 0) {
-          callback = std::move(loop->queue.front());
-          loop->queue.pop();
+    while (!yielded) {
+      Loop::DispatchQueue::Node* node = nullptr;
+      size_t priority = 0;
+
+      // callbacks of a higher priority dispatched by callbacks of a lower
+      // priority run before the rest of the lower priority batch
+      for (; priority < Loop::PRIORITIES; ++priority) {
+        if (
+          loop->backlog[priority] == nullptr &&
+          loop->queues[priority].head.load(std::memory_order_relaxed) != nullptr
+        ) {
+          loop->backlog[priority] = loop->queues[priority].drain();
+        }
+
+        if (loop->backlog[priority] != nullptr) {
+          node = loop->backlog[priority];
+          break;
         }
-      } while (0);
+      }
 
-      if (callback == nullptr) {
+      if (node == nullptr) {
         break;
       }
 
-      callback();
-      callback = nullptr;
+      loop->backlog[priority] = node->next;
+
+      if (node->callback != nullptr) {
+        node->callback();
+      }
+
+      delete node;
+
+      // yield to libuv so a flood of dispatched callbacks cannot starve I/O,
+      // the remaining callbacks run on the next loop iteration
+      if (budget > 0 && uv_hrtime() - start >= budget) {
+        for (const auto backlog : loop->backlog) {
+          if (backlog != nullptr) {
+            yielded = true;
+          }
+        }
+
+        for (auto& queue : loop->queues) {
+          if (queue.head.load() != nullptr) {
+            yielded = true;
+          }
+        }
+
+        if (yielded) {
+          uv_async_send(async);
+        }
+
+        break;
+      }
     }
 
     if (loop->state == Loop::State::Polling) {
@@ -46,6 +90,39 @@ namespace ssc::runtime::loop {
     }
   }
 
+  bool Loop::DispatchQueue::push (const DispatchCallback& callback) {
+    auto expected = this->head.load(std::memory_order_relaxed);
+    auto node = new Node { callback, expected };
+
+    // `node` belongs to the loop thread once it was published, so it is not
+    // read again after the exchange succeeded
+    while (!this->head.compare_exchange_weak(
+      expected,
+      node,
+      std::memory_order_release,
+      std::memory_order_relaxed
+    )) {
+      node->next = expected;
+    }
+
+    return expected == nullptr;
+  }
+
+  Loop::DispatchQueue::Node* Loop::DispatchQueue::drain () {
+    auto node = this->head.exchange(nullptr, std::memory_order_acquire);
+    Node* nodes = nullptr;
+
+    // nodes are pushed onto a stack, so they are reversed into FIFO order
+    while (node != nullptr) {
+      auto next = node->next;
+      node->next = nodes;
+      nodes = node;
+      node = next;
+    }
+
+    return nodes;
+  }
+
   // `onLoopThread` is used by android/darwin/win32 while linux uses a gsoure
   static void onLoopThread (Loop* loop) {
     while (loop->started() && loop->alive()) {
@@ -113,23 +190,45 @@ namespace ssc::runtime::loop {
   }
 
   bool Loop::UV::run (uv_run_mode mode) {
+    const auto previousLoop = currentLoop;
+    bool alive = false;
+
+    currentLoop = reinterpret_cast<const Loop*>(uv_loop_get_data(&this->loop));
+
     if (mode == UV_RUN_DEFAULT) {
       if (uv_run(&this->loop, mode) != 0) {
-        return uv_run(&this->loop, UV_RUN_NOWAIT) > 0;
+        alive = uv_run(&this->loop, UV_RUN_NOWAIT) > 0;
       }
+    } else if (mode == UV_RUN_NOWAIT || mode == UV_RUN_ONCE) {
+      alive = uv_run(&this->loop, mode) > 0;
     }
 
-    if (mode == UV_RUN_NOWAIT || mode == UV_RUN_ONCE) {
-      return uv_run(&this->loop, mode) > 0;
-    }
-
-    return false;
+    currentLoop = previousLoop;
+    return alive;
   }
 
   Loop::Loop (const Options& options)
     : options(options)
   {}
 
+  Loop::~Loop () {
+    for (size_t priority = 0; priority < PRIORITIES; ++priority) {
+      auto node = this->backlog[priority];
+      while (node != nullptr) {
+        auto next = node->next;
+        delete node;
+        node = next;
+      }
+
+      node = this->queues[priority].drain();
+      while (node != nullptr) {
+        auto next = node->next;
+        delete node;
+        node = next;
+      }
+    }
+  }
+
   bool Loop::init () {
     if (this->state == State::None) {
       this->state = State::Init;
@@ -146,61 +245,96 @@ namespace ssc::runtime::loop {
         this->gtk.source = nullptr;
       }
 
-      // @see https://api.gtkd.org/glib.c.types.GSourceFuncs.html
-      this->gtk.functions.prepare = [](GSource *source, gint *timeout) -> gboolean {
-        auto loop = reinterpret_cast<UVSource*>(source)->loop;
-
-        if (!loop->started()) {
-          return false;
-        }
-
-        if (!loop->alive()) {
-          return true;
-        }
-
-        *timeout = loop->timeout();
-        return *timeout == 0;
-      };
-
-      this->gtk.functions.check = [](GSource* source) -> gboolean {
-        const auto loop = reinterpret_cast<UVSource*>(source)->loop;
-        const auto tag = reinterpret_cast<UVSource *>(source)->tag;
-        const auto timeout = loop->timeout();
-
-        if (timeout == 0) {
+      // a loop with a dedicated thread runs itself, it is never driven by
+      // the GTK main loop
+      if (!this->options.dedicatedThread) {
+        // @see https://api.gtkd.org/glib.c.types.GSourceFuncs.html
+        // the source wakes the GTK main loop only when the libuv backend fd is
+        // readable, which includes the eventfd `uv_async_send()` writes to for
+        // `Loop::dispatch()`, or when the next libuv timer is due
+        this->gtk.functions.prepare = [](GSource *source, gint *timeout) -> gboolean {
+          auto uvsource = reinterpret_cast<UVSource*>(source);
+          auto loop = uvsource->loop;
+
+          uvsource->deadline = 0;
+          *timeout = -1;
+
+          if (!loop->started()) {
+            return false;
+          }
+
+          // `uv_backend_timeout()` is relative to the cached loop time, which
+          // is the same monotonic clock GLib caches for this iteration
+          const auto backendTimeout = uv_backend_timeout(loop->get());
+
+          if (backendTimeout == 0) {
+            *timeout = 0;
+            return true;
+          } else if (backendTimeout < 0) {
+            return false;
+          }
+
+          const auto now = static_cast<uint64_t>(g_source_get_time(source) / 1000);
+          uvsource->deadline = uv_now(loop->get()) + backendTimeout;
+
+          if (uvsource->deadline > now) {
+            *timeout = static_cast<gint>(uvsource->deadline - now);
+            return false;
+          }
+
+          // the coarse libuv clock can trail GLib's clock by a tick, so a
+          // deadline that was already dispatched waits a millisecond instead
+          // of spinning until libuv considers the timer due
+          if (uvsource->dispatchedDeadline == uvsource->deadline) {
+            *timeout = 1;
+            return false;
+          }
+
+          *timeout = 0;
           return true;
-        }
-
-        const auto condition = g_source_query_unix_fd(source, tag);
-        return (
-          ((condition & G_IO_IN) == G_IO_IN) ||
-          ((condition & G_IO_OUT) == G_IO_OUT)
+        };
+
+        this->gtk.functions.check = [](GSource* source) -> gboolean {
+          const auto uvsource = reinterpret_cast<UVSource*>(source);
+          const auto condition = g_source_query_unix_fd(source, uvsource->tag);
+
+          if ((condition & (G_IO_IN | G_IO_ERR | G_IO_HUP)) != 0) {
+            return true;
+          }
+
+          return (
+            uvsource->deadline > 0 &&
+            uvsource->deadline != uvsource->dispatchedDeadline &&
+            static_cast<uint64_t>(g_source_get_time(source) / 1000) >= uvsource->deadline
+          );
+        };
+
+        this->gtk.functions.dispatch = [](
+          GSource *source,
+          GSourceFunc callback,
+          gpointer user_data
+        ) -> gboolean {
+          const auto uvsource = reinterpret_cast<UVSource*>(source);
+          const auto loop = uvsource->loop;
+          loop->state = Loop::State::Polling;
+          loop->uv.run(UV_RUN_NOWAIT);
+          loop->state = Loop::State::Idle;
+          uvsource->dispatchedDeadline = uvsource->deadline;
+          return G_SOURCE_CONTINUE;
+        };
+
+        this->gtk.source = g_source_new(&this->gtk.functions, sizeof(UVSource));
+        auto uvsource = reinterpret_cast<UVSource*>(this->gtk.source);
+        uvsource->loop = this;
+        uvsource->tag = g_source_add_unix_fd(
+          this->gtk.source,
+          uv_backend_fd(this->get()),
+          (GIOCondition) (G_IO_IN | G_IO_ERR | G_IO_HUP)
         );
-      };
-
-      this->gtk.functions.dispatch = [](
-        GSource *source,
-        GSourceFunc callback,
-        gpointer user_data
-      ) -> gboolean {
-        const auto loop = reinterpret_cast<UVSource*>(source)->loop;
-        loop->state = Loop::State::Polling;
-        loop->uv.run(UV_RUN_NOWAIT);
-        loop->state = Loop::State::Idle;
-        return G_SOURCE_CONTINUE;
-      };
-
-      this->gtk.source = g_source_new(&this->gtk.functions, sizeof(UVSource));
-      auto uvsource = reinterpret_cast<UVSource*>(this->gtk.source);
-      uvsource->loop = this;
-      uvsource->tag = g_source_add_unix_fd(
-        this->gtk.source,
-        uv_backend_fd(this->get()),
-        (GIOCondition) (G_IO_IN | G_IO_OUT | G_IO_ERR)
-      );
-
-      g_source_set_priority(this->gtk.source, G_PRIORITY_HIGH);
-      g_source_attach(this->gtk.source, nullptr);
+
+        g_source_set_priority(this->gtk.source, G_PRIORITY_HIGH);
+        g_source_attach(this->gtk.source, nullptr);
+      }
 
     #endif
     }
@@ -300,7 +434,7 @@ namespace ssc::runtime::loop {
     return this->state == State::Paused;
   }
 
-  bool Loop::dispatch (const DispatchCallback& callback) {
+  bool Loop::dispatch (const DispatchCallback& callback, const Priority priority) {
     if (callback == nullptr) {
       return false;
     } else if (this->state > State::Polling) {
@@ -309,15 +443,32 @@ namespace ssc::runtime::loop {
       return false;
     }
 
-    do {
-      Lock lock(this->mutex);
-      this->queue.push(callback);
-    } while (0);
+    // only the producer that makes a queue non-empty needs to wake the loop,
+    // `uv_async_send()` coalesces the rest anyway
+    if (this->queues[static_cast<size_t>(priority)].push(callback)) {
+      uv_async_send(&this->uv.async);
+    }
 
-    uv_async_send(&this->uv.async);
     return this->state == State::Idle || this->state == State::Polling;
   }
 
+  bool Loop::handoff (const DispatchCallback& callback, const Priority priority) {
+    if (callback == nullptr) {
+      return false;
+    }
+
+    if (this->isCurrentThread()) {
+      callback();
+      return true;
+    }
+
+    return this->dispatch(callback, priority);
+  }
+
+  bool Loop::isCurrentThread () const {
+    return currentLoop == this;
+  }
+
   bool Loop::shutdown () {
     if (this->state > State::None && this->state < State::Shutdown) {
       if (this->stop()) {
@@ -3,6 +3,7 @@
 
 #include "platform.hh"
 #include "string.hh"
+#include "loop.hh"
 
 #if SOCKET_RUNTIME_PLATFORM_WINDOWS
 #include <tlhelp32.h>
@@ -259,6 +260,134 @@ namespace ssc::runtime::process {
   };
 }
 
+namespace ssc::runtime::process {
+  /**
+   * A child process spawned with `uv_spawn()` on a `loop::Loop`. Its stdio
+   * is read from `uv_pipe_t` handles on the loop thread into pooled buffers,
+   * so no thread is needed per child process. Output is byte exact and is
+   * delivered as it is read (`ReadMode::Raw`) or split into lines without
+   * their trailing `\n` (`ReadMode::Lines`).
+   *
+   * A `Child` MUST be created with `std::make_shared()` as it keeps itself
+   * alive until all of its handles are closed, and all of its functions
+   * MUST be called on the loop thread.
+   */
+  class Child : public std::enable_shared_from_this<Child> {
+    public:
+      using PID = int;
+      using ReadCallback = Function<void(const unsigned char*, size_t)>;
+      using ExitCallback = Function<void(int64_t, int)>;
+      using CloseCallback = Function<void(int64_t, int)>;
+      using WriteCallback = Function<void(int)>;
+
+      enum class ReadMode {
+        Raw,
+        Lines
+      };
+
+      // the size of pooled read buffers
+      static constexpr size_t READ_BUFFER_SIZE = 64 * 1024;
+      // the number of unused read buffers kept in the pool
+      static constexpr size_t READ_BUFFER_POOL_SIZE = 32;
+
+      struct Options {
+        String command;
+        String cwd;
+        Vector<String> env;
+        bool allowStdin = true;
+        bool allowStdout = true;
+        bool allowStderr = true;
+        ReadMode readMode = ReadMode::Raw;
+      #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+        String shell = "";
+      #else
+        String shell = "/bin/sh";
+      #endif
+        // called for each chunk (or line) read from stdout and stderr
+        ReadCallback onStdout = nullptr;
+        ReadCallback onStderr = nullptr;
+        // called with the exit code and signal when the process exits
+        ExitCallback onExit = nullptr;
+        // called with the exit code and signal when the process exited and
+        // all of its output was read
+        CloseCallback onClose = nullptr;
+      };
+
+      struct Pipe {
+        uv_pipe_t handle;
+        Child* child = nullptr;
+        bool open = false;
+        bool reading = false;
+        // a partial line in `ReadMode::Lines`
+        String line;
+      };
+
+      loop::Loop& loop;
+      const Options options;
+      Atomic<PID> id = 0;
+      Atomic<bool> exited = false;
+      Atomic<int64_t> status = -1;
+      Atomic<int> signal = 0;
+
+      Child (loop::Loop&, const Options&);
+      Child () = delete;
+      Child (const Child&) = delete;
+      Child (Child&&) = delete;
+      ~Child ();
+      Child& operator = (const Child&) = delete;
+      Child& operator = (Child&&) = delete;
+
+      /**
+       * Spawns the process, returning `0` or a libuv error code.
+       */
+      int spawn ();
+
+      /**
+       * Writes bytes to stdin, calling `callback` with a libuv status when
+       * the bytes were written.
+       */
+      bool write (SharedPointer<unsigned char[]>, size_t, const WriteCallback = nullptr);
+      void closeStdin ();
+
+      /**
+       * Stops (and restarts) reading stdout and stderr, which fills the
+       * pipes and eventually blocks the child process on write.
+       */
+      void pause ();
+      void resume ();
+      bool paused () const;
+
+      /**
+       * Sends `signal` to the process (and its process group).
+       */
+      int kill (int signal);
+
+      /**
+       * Delivers bytes read from `pipe`, or the end of its stream when
+       * `bytes` is `nullptr` (called on the loop thread by libuv callbacks).
+       */
+      void read (Pipe* pipe, const unsigned char* bytes, size_t size);
+
+      /**
+       * Closes `pipe`, the child releases itself once all handles closed.
+       */
+      void close (Pipe* pipe);
+
+    private:
+      uv_process_t process;
+      uv_process_options_t processOptions;
+      Pipe stdinPipe;
+      Pipe stdoutPipe;
+      Pipe stderrPipe;
+      Atomic<bool> isPaused = false;
+      bool spawned = false;
+      int pendingCloses = 0;
+      SharedPointer<Child> self = nullptr;
+
+      void closed ();
+  };
+}
+
 namespace ssc::runtime {
   using Process = process::Process;
 }
@@ -0,0 +1,394 @@
+#include "../env.hh"
+#include "../process.hh"
+
+namespace ssc::runtime::process {
+  /**
+   * A pool of read buffers shared by all child processes. A buffer is only
+   * held for the duration of a read callback, so a few buffers serve any
+   * number of child processes.
+   */
+  struct ReadBufferPool {
+    Mutex mutex;
+    Vector<char*> buffers;
+
+    ~ReadBufferPool () {
+      for (const auto buffer : this->buffers) {
+        delete [] buffer;
+      }
+    }
+
+    char* acquire () {
+      Lock lock(this->mutex);
+      if (this->buffers.size() == 0) {
+        return new char[Child::READ_BUFFER_SIZE];
+      }
+
+      const auto buffer = this->buffers.back();
+      this->buffers.pop_back();
+      return buffer;
+    }
+
+    void release (char* buffer) {
+      if (buffer == nullptr) {
+        return;
+      }
+
+      Lock lock(this->mutex);
+      if (this->buffers.size() < Child::READ_BUFFER_POOL_SIZE) {
+        this->buffers.push_back(buffer);
+      } else {
+        delete [] buffer;
+      }
+    }
+  };
+
+  struct WriteRequest {
+    uv_write_t req;
+    SharedPointer<unsigned char[]> bytes = nullptr;
+    Child::WriteCallback callback = nullptr;
+  };
+
+  static ReadBufferPool readBufferPool;
+
+  static void onReadBufferAllocate (uv_handle_t* handle, size_t size, uv_buf_t* buf) {
+    buf->base = readBufferPool.acquire();
+    buf->len = buf->base != nullptr ? Child::READ_BUFFER_SIZE : 0;
+  }
+
+  static void onPipeRead (uv_stream_t* stream, ssize_t size, const uv_buf_t* buf) {
+    auto pipe = reinterpret_cast<Child::Pipe*>(stream->data);
+    // the child may release its last reference to itself in a callback
+    const auto child = pipe->child->shared_from_this();
+
+    if (size > 0) {
+      child->read(pipe, reinterpret_cast<const unsigned char*>(buf->base), size);
+    } else if (size < 0) {
+      // `UV_EOF` or a read error, either way nothing more can be read
+      child->read(pipe, nullptr, 0);
+      child->close(pipe);
+    }
+
+    readBufferPool.release(buf->base);
+  }
+
+  Child::Child (loop::Loop& loop, const Options& options)
+    : loop(loop),
+      options(options)
+  {
+    this->stdinPipe.child = this;
+    this->stdoutPipe.child = this;
+    this->stderrPipe.child = this;
+  }
+
+  Child::~Child () {}
+
+  int Child::spawn () {
+  #if SOCKET_RUNTIME_PLATFORM_IOS
+    return UV_ENOTSUP;
+  #else
+    if (this->spawned || this->self != nullptr) {
+      return UV_EALREADY;
+    }
+
+    auto loop = this->loop.get();
+    uv_stdio_container_t stdio[3];
+    Vector<String> args;
+    Vector<String> environment;
+    Vector<char*> argv;
+    Vector<char*> envp;
+
+    const auto pipes = Vector<std::pair<Pipe*, bool>> {
+      { &this->stdinPipe, this->options.allowStdin },
+      { &this->stdoutPipe, this->options.allowStdout },
+      { &this->stderrPipe, this->options.allowStderr }
+    };
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    auto shell = this->options.shell;
+    if (shell.size() == 0 || shell == "cmd.exe") {
+      shell = env::get("COMSPEC", "cmd.exe");
+    }
+
+    args = { shell, "/d", "/s", "/c", "\"" + this->options.command + "\"" };
+  #else
+    args = { this->options.shell, "-c", this->options.command };
+  #endif
+
+    for (auto& arg : args) {
+      argv.push_back(arg.data());
+    }
+
+    argv.push_back(nullptr);
+
+    // extra environment variables are added to the environment of the
+    // calling process, otherwise it is inherited as is
+    if (this->options.env.size() > 0) {
+      uv_env_item_t* items = nullptr;
+      int count = 0;
+
+      if (uv_os_environ(&items, &count) == 0) {
+        for (int i = 0; i < count; ++i) {
+          environment.push_back(String(items[i].name) + "=" + items[i].value);
+        }
+
+        uv_os_free_environ(items, count);
+      }
+
+      for (const auto& entry : this->options.env) {
+        environment.push_back(entry);
+      }
+
+      for (auto& entry : environment) {
+        envp.push_back(entry.data());
+      }
+
+      envp.push_back(nullptr);
+    }
+
+    for (size_t i = 0; i < pipes.size(); ++i) {
+      const auto pipe = pipes[i].first;
+
+      if (!pipes[i].second) {
+        stdio[i].flags = UV_IGNORE;
+        continue;
+      }
+
+      uv_pipe_init(loop, &pipe->handle, 0);
+      pipe->handle.data = pipe;
+      pipe->open = true;
+      this->pendingCloses++;
+
+      stdio[i].flags = static_cast<uv_stdio_flags>(
+        UV_CREATE_PIPE | (i == 0 ? UV_READABLE_PIPE : UV_WRITABLE_PIPE)
+      );
+      stdio[i].data.stream = reinterpret_cast<uv_stream_t*>(&pipe->handle);
+    }
+
+    this->processOptions = uv_process_options_t {};
+    this->processOptions.file = argv[0];
+    this->processOptions.args = argv.data();
+    this->processOptions.env = envp.size() > 0 ? envp.data() : nullptr;
+    this->processOptions.cwd = this->options.cwd.size() > 0 ? this->options.cwd.c_str() : nullptr;
+    this->processOptions.stdio = stdio;
+    this->processOptions.stdio_count = 3;
+    this->processOptions.exit_cb = [](uv_process_t* handle, int64_t status, int signal) {
+      auto child = reinterpret_cast<Child*>(handle->data)->shared_from_this();
+
+      child->status = status;
+      child->signal = signal;
+      child->exited = true;
+
+      if (child->options.onExit != nullptr) {
+        child->options.onExit(status, signal);
+      }
+
+      // nothing can be written to a process that exited
+      child->closeStdin();
+
+      uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t* handle) {
+        reinterpret_cast<Child*>(handle->data)->closed();
+      });
+    };
+
+  #if SOCKET_RUNTIME_PLATFORM_WINDOWS
+    this->processOptions.flags = UV_PROCESS_WINDOWS_HIDE | UV_PROCESS_WINDOWS_VERBATIM_ARGUMENTS;
+  #else
+    // the child leads a process group so `kill()` reaches its children too
+    this->processOptions.flags = UV_PROCESS_DETACHED;
+  #endif
+
+    this->process.data = this;
+    this->pendingCloses++;
+    this->self = this->shared_from_this();
+
+    const auto err = uv_spawn(loop, &this->process, &this->processOptions);
+
+    if (err != 0) {
+      // initialized handles are closed before the child releases itself
+      uv_close(reinterpret_cast<uv_handle_t*>(&this->process), [](uv_handle_t* handle) {
+        reinterpret_cast<Child*>(handle->data)->closed();
+      });
+
+      for (const auto& entry : pipes) {
+        this->close(entry.first);
+      }
+
+      return err;
+    }
+
+    this->spawned = true;
+    this->id = this->process.pid;
+
+    for (const auto pipe : { &this->stdoutPipe, &this->stderrPipe }) {
+      if (pipe->open) {
+        pipe->reading = uv_read_start(
+          reinterpret_cast<uv_stream_t*>(&pipe->handle),
+          onReadBufferAllocate,
+          onPipeRead
+        ) == 0;
+      }
+    }
+
+    return 0;
+  #endif
+  }
+
+  void Child::read (Pipe* pipe, const unsigned char* bytes, size_t size) {
+    const auto& callback = pipe == &this->stdoutPipe
+      ? this->options.onStdout
+      : this->options.onStderr;
+
+    if (callback == nullptr) {
+      return;
+    }
+
+    if (this->options.readMode == ReadMode::Raw) {
+      if (size > 0) {
+        callback(bytes, size);
+      }
+      return;
+    }
+
+    // end of stream, flush a trailing line without a `\n`
+    if (bytes == nullptr) {
+      if (pipe->line.size() > 0) {
+        const auto line = std::move(pipe->line);
+        pipe->line.clear();
+        callback(reinterpret_cast<const unsigned char*>(line.data()), line.size());
+      }
+      return;
+    }
+
+    auto start = bytes;
+    const auto end = bytes + size;
+
+    while (start < end) {
+      const auto newline = reinterpret_cast<const unsigned char*>(
+        memchr(start, '\n', end - start)
+      );
+
+      if (newline == nullptr) {
+        pipe->line.append(reinterpret_cast<const char*>(start), end - start);
+        break;
+      }
+
+      if (pipe->line.size() > 0) {
+        pipe->line.append(reinterpret_cast<const char*>(start), newline - start);
+        const auto line = std::move(pipe->line);
+        pipe->line.clear();
+        callback(reinterpret_cast<const unsigned char*>(line.data()), line.size());
+      } else {
+        callback(start, newline - start);
+      }
+
+      start = newline + 1;
+    }
+  }
+
+  bool Child::write (
+    SharedPointer<unsigned char[]> bytes,
+    size_t size,
+    const WriteCallback callback
+  ) {
+    if (!this->stdinPipe.open || bytes == nullptr) {
+      return false;
+    }
+
+    auto request = new WriteRequest { uv_write_t {}, bytes, callback };
+    const auto buf = uv_buf_init(reinterpret_cast<char*>(request->bytes.get()), size);
+
+    request->req.data = request;
+
+    const auto err = uv_write(
+      &request->req,
+      reinterpret_cast<uv_stream_t*>(&this->stdinPipe.handle),
+      &buf,
+      1,
+      [](uv_write_t* req, int status) {
+        auto request = reinterpret_cast<WriteRequest*>(req->data);
+        if (request->callback != nullptr) {
+          request->callback(status);
+        }
+        delete request;
+      }
+    );
+
+    if (err != 0) {
+      delete request;
+      return false;
+    }
+
+    return true;
+  }
+
+  void Child::closeStdin () {
+    this->close(&this->stdinPipe);
+  }
+
+  void Child::pause () {
+    this->isPaused = true;
+    for (const auto pipe : { &this->stdoutPipe, &this->stderrPipe }) {
+      if (pipe->open && pipe->reading) {
+        uv_read_stop(reinterpret_cast<uv_stream_t*>(&pipe->handle));
+        pipe->reading = false;
+      }
+    }
+  }
+
+  void Child::resume () {
+    this->isPaused = false;
+    for (const auto pipe : { &this->stdoutPipe, &this->stderrPipe }) {
+      if (pipe->open && !pipe->reading) {
+        pipe->reading = uv_read_start(
+          reinterpret_cast<uv_stream_t*>(&pipe->handle),
+          onReadBufferAllocate,
+          onPipeRead
+        ) == 0;
+      }
+    }
+  }
+
+  bool Child::paused () const {
+    return this->isPaused;
+  }
+
+  int Child::kill (int signal) {
+    if (!this->spawned || this->exited) {
+      return UV_ESRCH;
+    }
+
+  #if !SOCKET_RUNTIME_PLATFORM_WINDOWS
+    if (uv_kill(-this->id, signal) == 0) {
+      return 0;
+    }
+  #endif
+
+    return uv_process_kill(&this->process, signal);
+  }
+
+  void Child::close (Pipe* pipe) {
+    if (!pipe->open) {
+      return;
+    }
+
+    pipe->open = false;
+    pipe->reading = false;
+
+    uv_close(reinterpret_cast<uv_handle_t*>(&pipe->handle), [](uv_handle_t* handle) {
+      reinterpret_cast<Pipe*>(handle->data)->child->closed();
+    });
+  }
+
+  void Child::closed () {
+    if (--this->pendingCloses > 0) {
+      return;
+    }
+
+    // the last reference may be the one the child holds to itself
+    const auto self = std::move(this->self);
+
+    if (this->spawned && this->options.onClose != nullptr) {
+      this->options.onClose(this->status, this->signal);
+    }
+  }
+}
@@ -335,13 +335,12 @@ namespace ssc::runtime::process {
         for (size_t i = 0; i < pollfds.size(); ++i) {
           if (!(pollfds[i].fd >= 0)) continue;
           if (pollfds[i].revents & POLLIN) {
-            memset(buffer.get(), 0, config.bufferSize);
             const ssize_t n = ::read(pollfds[i].fd, buffer.get(), config.bufferSize);
 
             if (n > 0) {
               if (fd_is_stdout[i]) {
                 Lock lock(stdoutMutex);
-                auto b = String(reinterpret_cast<char*>(buffer.get()));
+                auto b = String(reinterpret_cast<char*>(buffer.get()), n);
                 auto parts = splitc(b, '\n');
 
                 if (parts.size() > 1) {
@@ -361,7 +360,7 @@ namespace ssc::runtime::process {
                 }
               } else {
                 Lock lock(stderrMutex);
-                readStderr(String(reinterpret_cast<char*>(buffer.get())));
+                readStderr(String(reinterpret_cast<char*>(buffer.get()), n));
               }
             } else if (n < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK) {
               pollfds[i].fd = -1;
@@ -85,8 +85,99 @@ namespace ssc::runtime {
   };
 
   /**
-   * Container alias for storing multiple QueuedResponse entries by ID.
+   * A store for queued responses waiting to be fetched by a client. Entries
+   * expire after their `ttl` (or the store's default TTL) and the oldest
+   * entries are evicted when the store grows beyond its byte budget, so
+   * responses that are never fetched do not stay in memory forever.
    */
-  using QueuedResponses = Map<QueuedResponse::ID, QueuedResponse>;
+  class QueuedResponses {
+    public:
+      using ID = QueuedResponse::ID;
+
+      // the default time (in milliseconds) a queued response is kept for
+      static constexpr uint64_t DEFAULT_TTL = 30 * 1000;
+      // the default upper bound (in bytes) of queued response bodies
+      static constexpr size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+      // the default time (in milliseconds) a queued response is never
+      // evicted for, which gives its client a chance to take it
+      static constexpr uint64_t DEFAULT_EVICTION_GRACE_PERIOD = 1000;
+
+      struct Options {
+        uint64_t ttl = DEFAULT_TTL;
+        size_t maxBytes = DEFAULT_MAX_BYTES;
+        uint64_t evictionGracePeriod = DEFAULT_EVICTION_GRACE_PERIOD;
+      };
+
+      struct Entry {
+        QueuedResponse response;
+        // monotonic time (in milliseconds) the entry was queued at
+        uint64_t queued = 0;
+        // monotonic time (in milliseconds) the entry expires at
+        uint64_t expires = 0;
+        // insertion order of the entry, used for eviction
+        uint64_t sequence = 0;
+      };
+
+      struct Counters {
+        Atomic<size_t> bytes = 0;
+        Atomic<uint64_t> expirations = 0;
+        Atomic<uint64_t> evictions = 0;
+        Atomic<uint64_t> hits = 0;
+        Atomic<uint64_t> misses = 0;
+        // total and maximum time (in milliseconds) between queueing a
+        // response and it being taken
+        Atomic<uint64_t> hitLatency = 0;
+        Atomic<uint64_t> maxHitLatency = 0;
+      };
+
+      Options options;
+      Counters counters;
+
+      QueuedResponses () = default;
+      QueuedResponses (const Options&);
+      QueuedResponses (const QueuedResponses&) = delete;
+      QueuedResponses (QueuedResponses&&) = delete;
+      QueuedResponses& operator = (const QueuedResponses&) = delete;
+      QueuedResponses& operator = (QueuedResponses&&) = delete;
+
+      /**
+       * Gets the current monotonic time in milliseconds.
+       */
+      static uint64_t now ();
+
+      /**
+       * Queues a response, evicting the oldest entries if the byte budget
+       * is exceeded. Entries younger than the eviction grace period are
+       * kept even if that leaves the store over its budget until they are
+       * taken or expire. A response larger than the budget is kept on its own.
+       */
+      void put (QueuedResponse);
+
+      /**
+       * Removes the queued response for `id` and stores it in `response`,
+       * returning `false` if there is none.
+       */
+      bool take (const ID, QueuedResponse&);
+
+      bool contains (const ID) const;
+      bool remove (const ID);
+      size_t size () const;
+      size_t bytes () const;
+      const Vector<ID> ids () const;
+
+      /**
+       * Removes all expired entries, returning the number removed.
+       */
+      size_t expire ();
+      void clear ();
+
+    private:
+      mutable Mutex mutex;
+      Map<ID, Entry> entries;
+      Map<uint64_t, ID> order;
+      uint64_t sequence = 0;
+
+      void erase (Map<ID, Entry>::iterator);
+  };
 }
 #endif
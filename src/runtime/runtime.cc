@@ -15,7 +15,11 @@ namespace ssc::runtime {
       windowManager(*this),
       dispatcher(*this),
       options(options),
-      services(*this, { this->dispatcher, options.features })
+      services(*this, {
+        this->dispatcher,
+        options.features,
+        core::Services::getLoopAffinity(options.userConfig)
+      })
   {
     this->init();
   }
@@ -51,10 +55,24 @@ namespace ssc::runtime {
       return false;
     }
 
+    if (this->services.timers.enabled && this->queuedResponsesExpiryTimer == 0) {
+      this->queuedResponsesExpiryTimer = this->services.timers.setInterval(
+        QUEUED_RESPONSES_EXPIRY_INTERVAL,
+        [this](auto) {
+          this->queuedResponses.expire();
+        }
+      );
+    }
+
     return true;
   }
 
   bool Runtime::pause () {
+    if (this->queuedResponsesExpiryTimer > 0) {
+      this->services.timers.clearInterval(this->queuedResponsesExpiryTimer);
+      this->queuedResponsesExpiryTimer = 0;
+    }
+
     if (!this->services.stop()) {
       return false;
     }
@@ -28,6 +28,9 @@ namespace ssc::runtime {
         int logSeq = 0;
       };
 
+      // the interval (in milliseconds) expired queued responses are removed at
+      static constexpr uint64_t QUEUED_RESPONSES_EXPIRY_INTERVAL = 5 * 1000;
+
       // managers
       window::Manager windowManager;
       bridge::Manager bridgeManager;
@@ -39,6 +42,9 @@ namespace ssc::runtime {
       Counters counters;
       Options options;
 
+      // timer that expires queued responses in the background
+      core::services::Timers::ID queuedResponsesExpiryTimer = 0;
+
       Runtime (const Options&);
       Runtime () = delete;
       Runtime (const Runtime&) = delete;
@@ -51,9 +51,31 @@ namespace ssc::runtime::serviceworker {
     public:
       using Callback = Function<void(const Response)>;
 
+      /**
+       * Called with the response head and each response body chunk as the
+       * worker writes it. Returning `false` for the first chunk buffers the
+       * whole response body instead, returning `false` after that closes it.
+       */
+      using StreamCallback = Function<bool(const Response&, const bytes::Buffer&)>;
+
+      enum class StreamState {
+        Pending,
+        Streaming,
+        Buffering,
+        Closed
+      };
+
+      /**
+       * Called with a callback to run once the consumer of a streamed
+       * response is ready for more bytes.
+       */
+      using DrainCallback = Function<void(const Function<void()>)>;
+
       struct Options {
         Client client;
         bool waitForRegistrationToFinish = true;
+        StreamCallback stream = nullptr;
+        DrainCallback drain = nullptr;
       };
 
       bytes::BufferQueue writeQueue;
@@ -63,14 +85,24 @@ namespace ssc::runtime::serviceworker {
       Request request;
       Options options;
       Mutex mutex;
+      Atomic<StreamState> streamState = StreamState::Pending;
+      size_t bytesStreamed = 0;
       ID id = crypto::rand64();
 
+      // a large request body is moved out of memory to this file
+      Path requestBodyPath;
+      size_t requestBodySize = 0;
+
       Fetch () = delete;
       Fetch (Container&, const Request&, const Options&);
+      ~Fetch ();
 
       bool init (const Callback);
       bool write (const bytes::Buffer&);
       bool finish ();
+      void drain (const Function<void()>);
+      bool isStreaming () const;
+      const bytes::Buffer readRequestBody (size_t offset = 0, size_t size = -1) const;
   };
 
   class Registration {
@@ -170,16 +202,85 @@ namespace ssc::runtime::serviceworker {
 
   };
 
+  /**
+   * A disk-backed store of named caches of responses (the Cache API)
+   * indexed by request URL and the request headers a response varies on.
+   * The container answers fetches from it without waking a worker.
+   */
+  class Cache {
+    public:
+      struct Entry {
+        String id; // derived from cache name, URL, and varied request headers
+        String name;
+        String url;
+        int statusCode = 200;
+        http::Headers headers;
+        Map<String, String> vary;
+        size_t size = 0;
+
+        bool matches (const Request&) const;
+        const JSON::Object json () const;
+      };
+
+      static const String getRequestURL (const Request&);
+
+      Container& container;
+      Path directory;
+      Vector<String> names;
+      // entries by request URL
+      Map<String, Vector<Entry>> entries;
+      Mutex mutex;
+
+      Cache (Container&);
+      Cache () = delete;
+      Cache (const Cache&) = delete;
+      Cache (Cache&&) = delete;
+
+      Cache& operator = (const Cache&) = delete;
+      Cache& operator = (Cache&&) = delete;
+
+      bool init (const Path&);
+      bool open (const String& name);
+      bool has (const String& name);
+      bool destroy (const String& name);
+      bool put (const String& name, const Request&, const Response&);
+      bool match (const Request&, Response&, const String& name = "");
+      bool remove (const String& name, const Request&);
+      const Vector<String> keys (const String& name);
+  };
+
   class Container {
     public:
+      /**
+       * A longest-prefix index of registration scopes by scheme. It is
+       * rebuilt when registrations change and replaced atomically so fetch
+       * routing can read it without taking the container lock.
+       */
+      struct ScopeIndex {
+        struct Entries {
+          // scope -> registration key
+          UnorderedMap<String, String> scopes;
+          // distinct scope sizes, largest first
+          Vector<size_t> sizes;
+        };
+
+        Map<String, Entries> schemes;
+
+        const String match (const String& scheme, const String& pathname) const;
+      };
+
       SharedPointer<bridge::Bridge> bridge = nullptr;
       Atomic<bool> isReady = false;
       Mutex mutex;
 
       Protocols protocols;
+      Cache cache;
       Origin origin;
       Map<String, Registration> registrations;
       Map<ID, SharedPointer<Fetch>> fetches;
+      // IDs of fetches waiting for a registration (by ID) to activate
+      Map<ID, Vector<ID>> pendingFetches;
+      SharedPointer<const ScopeIndex> scopeIndex = nullptr;
 
       Container ();
       ~Container ();
@@ -194,6 +295,9 @@ namespace ssc::runtime::serviceworker {
       void updateState (ID, const String&);
       bool claimClients (const String& scope);
       bool fetch (const Request&, const Fetch::Options&, const Fetch::Callback);
+      void releasePendingFetches (const Registration&);
+      void updateScopeIndex ();
+      const SharedPointer<const ScopeIndex> getScopeIndex () const;
   };
 
   class Server {
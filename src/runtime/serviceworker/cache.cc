@@ -0,0 +1,405 @@
+#include "../filesystem.hh"
+#include "../crypto.hh"
+#include "../string.hh"
+#include "../ini.hh"
+#include "../url.hh"
+
+#include "../serviceworker.hh"
+
+using ssc::runtime::string::split;
+using ssc::runtime::string::toLowerCase;
+using ssc::runtime::string::trim;
+using ssc::runtime::url::decodeURIComponent;
+using ssc::runtime::url::encodeURIComponent;
+
+namespace ssc::runtime::serviceworker {
+  static constexpr auto CACHE_NAMES_FILENAME = "caches";
+  static constexpr auto CACHE_ENTRY_EXTENSION = ".ini";
+  static constexpr auto CACHE_ENTRY_BODY_EXTENSION = ".body";
+
+  // serializes headers as `name: value` lines that survive `:` in values
+  static const String serializeHeaderLines (const Vector<std::pair<String, String>>& lines) {
+    StringStream stream;
+    for (const auto& line : lines) {
+      stream << line.first << ": " << line.second << "\n";
+    }
+    return stream.str();
+  }
+
+  static const Vector<std::pair<String, String>> parseHeaderLines (const String& source) {
+    Vector<std::pair<String, String>> lines;
+    for (const auto& line : split(source, '\n')) {
+      const auto separator = line.find(':');
+      if (separator != String::npos) {
+        lines.push_back({
+          trim(line.substr(0, separator)),
+          trim(line.substr(separator + 1))
+        });
+      }
+    }
+    return lines;
+  }
+
+  static bool writeCacheFile (const Path& path, const char* bytes, size_t size) {
+    auto stream = OutputFileStream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream.good()) {
+      return false;
+    }
+
+    stream.write(bytes, size);
+    stream.close();
+    return !stream.fail();
+  }
+
+  bool Cache::Entry::matches (const Request& request) const {
+    for (const auto& entry : this->vary) {
+      // `Vary: *` never matches (RFC 9110, section 12.5.5)
+      if (entry.first == "*") {
+        return false;
+      }
+
+      if (request.headers.get(entry.first).value.string != entry.second) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  const JSON::Object Cache::Entry::json () const {
+    return JSON::Object::Entries {
+      {"name", this->name},
+      {"url", this->url},
+      {"statusCode", this->statusCode},
+      {"headers", this->headers.json()},
+      {"size", this->size}
+    };
+  }
+
+  const String Cache::getRequestURL (const Request& request) {
+    // fragments are never part of a cache key
+    return (
+      request.url.scheme + "://" +
+      request.url.hostname +
+      (request.url.port.size() > 0 ? ":" + request.url.port : "") +
+      request.url.pathname +
+      request.url.search
+    );
+  }
+
+  Cache::Cache (Container& container)
+    : container(container)
+  {}
+
+  bool Cache::init (const Path& directory) {
+    Lock lock(this->mutex);
+    std::error_code ec;
+
+    this->directory = directory;
+    this->names.clear();
+    this->entries.clear();
+
+    fs::create_directories(directory, ec);
+    if (ec) {
+      debug("ServiceWorkerCache: Failed to create directory '%s': %s", directory.string().c_str(), ec.message().c_str());
+      return false;
+    }
+
+    auto names = filesystem::Resource(directory / CACHE_NAMES_FILENAME);
+    if (names.exists()) {
+      for (const auto& name : split(names.str(), '\n')) {
+        if (name.size() > 0) {
+          this->names.push_back(decodeURIComponent(name));
+        }
+      }
+    }
+
+    for (const auto& file : fs::directory_iterator(directory, ec)) {
+      if (file.path().extension() != CACHE_ENTRY_EXTENSION) {
+        continue;
+      }
+
+      auto resource = filesystem::Resource(file.path());
+      auto fields = INI::parse(resource.str());
+      auto body = Path(file.path()).replace_extension(CACHE_ENTRY_BODY_EXTENSION);
+      auto entry = Entry {};
+
+      entry.id = file.path().stem().string();
+      entry.name = decodeURIComponent(fields["name"]);
+      entry.url = decodeURIComponent(fields["url"]);
+
+      try {
+        entry.statusCode = std::stoi(fields["status"]);
+        entry.size = std::stoull(fields["size"]);
+      } catch (...) {
+        continue;
+      }
+
+      if (
+        entry.url.size() == 0 ||
+        !fs::exists(body, ec) ||
+        std::find(this->names.begin(), this->names.end(), entry.name) == this->names.end()
+      ) {
+        // orphaned entry of a deleted cache or a partial write
+        fs::remove(file.path(), ec);
+        fs::remove(body, ec);
+        continue;
+      }
+
+      for (const auto& header : parseHeaderLines(decodeURIComponent(fields["headers"]))) {
+        entry.headers.set(header.first, header.second);
+      }
+
+      for (const auto& header : parseHeaderLines(decodeURIComponent(fields["vary"]))) {
+        entry.vary[header.first] = header.second;
+      }
+
+      this->entries[entry.url].push_back(entry);
+    }
+
+    return true;
+  }
+
+  bool Cache::open (const String& name) {
+    Lock lock(this->mutex);
+
+    if (std::find(this->names.begin(), this->names.end(), name) != this->names.end()) {
+      return true;
+    }
+
+    this->names.push_back(name);
+
+    StringStream stream;
+    for (const auto& entry : this->names) {
+      stream << encodeURIComponent(entry) << "\n";
+    }
+
+    const auto bytes = stream.str();
+    return writeCacheFile(this->directory / CACHE_NAMES_FILENAME, bytes.data(), bytes.size());
+  }
+
+  bool Cache::has (const String& name) {
+    Lock lock(this->mutex);
+    return std::find(this->names.begin(), this->names.end(), name) != this->names.end();
+  }
+
+  bool Cache::destroy (const String& name) {
+    Lock lock(this->mutex);
+    std::error_code ec;
+
+    const auto cursor = std::find(this->names.begin(), this->names.end(), name);
+    if (cursor == this->names.end()) {
+      return false;
+    }
+
+    this->names.erase(cursor);
+
+    for (auto& entry : this->entries) {
+      auto& candidates = entry.second;
+      for (auto it = candidates.begin(); it != candidates.end();) {
+        if (it->name == name) {
+          fs::remove(this->directory / (it->id + CACHE_ENTRY_EXTENSION), ec);
+          fs::remove(this->directory / (it->id + CACHE_ENTRY_BODY_EXTENSION), ec);
+          it = candidates.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    std::erase_if(this->entries, [](const auto& entry) {
+      return entry.second.size() == 0;
+    });
+
+    StringStream stream;
+    for (const auto& entry : this->names) {
+      stream << encodeURIComponent(entry) << "\n";
+    }
+
+    const auto bytes = stream.str();
+    return writeCacheFile(this->directory / CACHE_NAMES_FILENAME, bytes.data(), bytes.size());
+  }
+
+  bool Cache::put (
+    const String& name,
+    const Request& request,
+    const Response& response
+  ) {
+    if (request.method != "GET" || response.statusCode == 206) {
+      return false;
+    }
+
+    if (!this->open(name)) {
+      return false;
+    }
+
+    Lock lock(this->mutex);
+    Vector<std::pair<String, String>> vary;
+    Vector<std::pair<String, String>> headers;
+    auto entry = Entry {};
+
+    entry.name = name;
+    entry.url = getRequestURL(request);
+    entry.statusCode = response.statusCode;
+    entry.headers = response.headers;
+    entry.size = response.body.size();
+
+    for (const auto& value : split(response.headers.get("vary").value.string, ',')) {
+      const auto header = toLowerCase(trim(value));
+      if (header.size() > 0) {
+        entry.vary[header] = header == "*" ? "" : request.headers.get(header).value.string;
+      }
+    }
+
+    for (const auto& header : entry.vary) {
+      vary.push_back(header);
+    }
+
+    for (const auto& header : entry.headers) {
+      headers.push_back({ header.name, header.value.string });
+    }
+
+    entry.id = crypto::sha1(name + "\n" + entry.url + "\n" + serializeHeaderLines(vary));
+
+    const auto fields = INI::Map {
+      {"name", encodeURIComponent(entry.name)},
+      {"url", encodeURIComponent(entry.url)},
+      {"status", std::to_string(entry.statusCode)},
+      {"size", std::to_string(entry.size)},
+      {"headers", encodeURIComponent(serializeHeaderLines(headers))},
+      {"vary", encodeURIComponent(serializeHeaderLines(vary))}
+    };
+
+    const auto metadata = INI::serialize(fields);
+
+    // the body is written first so an entry is never loaded without one
+    if (
+      !writeCacheFile(
+        this->directory / (entry.id + CACHE_ENTRY_BODY_EXTENSION),
+        reinterpret_cast<const char*>(response.body.data()),
+        entry.size
+      ) ||
+      !writeCacheFile(
+        this->directory / (entry.id + CACHE_ENTRY_EXTENSION),
+        metadata.data(),
+        metadata.size()
+      )
+    ) {
+      return false;
+    }
+
+    auto& candidates = this->entries[entry.url];
+    std::erase_if(candidates, [&entry](const auto& candidate) {
+      return candidate.id == entry.id;
+    });
+
+    candidates.push_back(entry);
+    return true;
+  }
+
+  bool Cache::match (
+    const Request& request,
+    Response& response,
+    const String& name
+  ) {
+    Entry entry;
+
+    if (request.method != "GET" && request.method != "HEAD") {
+      return false;
+    }
+
+    do {
+      Lock lock(this->mutex);
+      const auto url = getRequestURL(request);
+      bool found = false;
+
+      if (!this->entries.contains(url)) {
+        return false;
+      }
+
+      // caches are searched in creation order, like `caches.match()`
+      for (const auto& cacheName : this->names) {
+        if (name.size() > 0 && cacheName != name) {
+          continue;
+        }
+
+        for (const auto& candidate : this->entries.at(url)) {
+          if (candidate.name == cacheName && candidate.matches(request)) {
+            entry = candidate;
+            found = true;
+            break;
+          }
+        }
+
+        if (found) {
+          break;
+        }
+      }
+
+      if (!found) {
+        return false;
+      }
+    } while (0);
+
+    auto body = filesystem::Resource(this->directory / (entry.id + CACHE_ENTRY_BODY_EXTENSION));
+    const auto bytes = entry.size > 0 ? body.read() : nullptr;
+
+    if (entry.size > 0 && (bytes == nullptr || body.size(true) != entry.size)) {
+      return false;
+    }
+
+    response.statusCode = entry.statusCode;
+    response.status = http::Status(entry.statusCode);
+    response.headers = entry.headers;
+    response.body = request.method == "HEAD" || entry.size == 0
+      ? bytes::Buffer::empty()
+      : bytes::Buffer::from(bytes, entry.size);
+
+    return true;
+  }
+
+  bool Cache::remove (const String& name, const Request& request) {
+    Lock lock(this->mutex);
+    std::error_code ec;
+    const auto url = getRequestURL(request);
+    bool removed = false;
+
+    if (!this->entries.contains(url)) {
+      return false;
+    }
+
+    auto& candidates = this->entries.at(url);
+    for (auto it = candidates.begin(); it != candidates.end();) {
+      if (it->name == name && it->matches(request)) {
+        fs::remove(this->directory / (it->id + CACHE_ENTRY_EXTENSION), ec);
+        fs::remove(this->directory / (it->id + CACHE_ENTRY_BODY_EXTENSION), ec);
+        it = candidates.erase(it);
+        removed = true;
+      } else {
+        ++it;
+      }
+    }
+
+    if (candidates.size() == 0) {
+      this->entries.erase(url);
+    }
+
+    return removed;
+  }
+
+  const Vector<String> Cache::keys (const String& name) {
+    Lock lock(this->mutex);
+    Vector<String> keys;
+
+    for (const auto& entry : this->entries) {
+      for (const auto& candidate : entry.second) {
+        if (candidate.name == name) {
+          keys.push_back(entry.first);
+          break;
+        }
+      }
+    }
+
+    return keys;
+  }
+}
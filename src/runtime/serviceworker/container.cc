@@ -1,3 +1,4 @@
+#include "../filesystem.hh"
 #include "../runtime.hh"
 #include "../bridge.hh"
 #include "../config.hh"
@@ -12,8 +13,61 @@ using ssc::runtime::string::split;
 using ssc::runtime::string::join;
 
 namespace ssc::runtime::serviceworker {
+  // the largest request body range given to the worker in a single reply
+  static constexpr size_t FETCH_REQUEST_BODY_MAX_RANGE_SIZE = 1024 * 1024;
+
+  // responses the preload may be injected into when they finish are buffered
+  static bool shouldStreamFetchResponse (const Fetch& fetch, const String& preloadInjection) {
+    const auto contentType = fetch.response.headers.get("content-type").value.string;
+    const auto extname = Path(fetch.request.url.pathname).extension().string();
+    return (
+      fetch.options.stream != nullptr &&
+      preloadInjection != "always" &&
+      contentType.size() > 0 &&
+      !contentType.starts_with("text/html") &&
+      !extname.ends_with("html")
+    );
+  }
+
+  const String Container::ScopeIndex::match (
+    const String& scheme,
+    const String& pathname
+  ) const {
+    String key;
+    size_t size = 0;
+
+    // registrations for the exact scheme win over wildcard registrations
+    // with a scope of the same size
+    for (const auto& name : { scheme, String("*") }) {
+      if (!this->schemes.contains(name)) {
+        continue;
+      }
+
+      const auto& entries = this->schemes.at(name);
+      for (const auto candidate : entries.sizes) {
+        if (candidate <= size) {
+          break;
+        }
+
+        if (candidate > pathname.size()) {
+          continue;
+        }
+
+        const auto entry = entries.scopes.find(pathname.substr(0, candidate));
+        if (entry != entries.scopes.end()) {
+          key = entry->second;
+          size = candidate;
+          break;
+        }
+      }
+    }
+
+    return key;
+  }
+
   Container::Container ()
-    : protocols(*this)
+    : protocols(*this),
+      cache(*this)
   {}
 
   Container::~Container () {
@@ -22,6 +76,35 @@ namespace ssc::runtime::serviceworker {
     }
   }
 
+  void Container::updateScopeIndex () {
+    auto index = std::make_shared<ScopeIndex>();
+
+    do {
+      Lock lock(this->mutex);
+      for (const auto& entry : this->registrations) {
+        const auto& options = entry.second.options;
+        auto& entries = index->schemes[options.scheme];
+        entries.scopes.insert_or_assign(options.scope, entry.first);
+        entries.sizes.push_back(options.scope.size());
+      }
+    } while (0);
+
+    for (auto& entry : index->schemes) {
+      auto& sizes = entry.second.sizes;
+      std::sort(sizes.begin(), sizes.end(), std::greater<size_t>());
+      sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    }
+
+    std::atomic_store(
+      &this->scopeIndex,
+      SharedPointer<const ScopeIndex>(std::move(index))
+    );
+  }
+
+  const SharedPointer<const Container::ScopeIndex> Container::getScopeIndex () const {
+    return std::atomic_load(&this->scopeIndex);
+  }
+
   bool Container::ready () {
     return this->isReady.load(std::memory_order_relaxed);
   }
@@ -40,6 +123,13 @@ namespace ssc::runtime::serviceworker {
 
     this->reset();
     this->bridge = bridge;
+    this->cache.init(
+      filesystem::Resource::getWellKnownPaths().data /
+      "serviceworker" /
+      "caches" /
+      crypto::sha1(this->origin.name())
+    );
+
     this->isReady = true;
 
     this->bridge->router.map("serviceWorker.fetch.request.body", [this](auto message, auto router, auto reply) mutable {
@@ -67,11 +157,46 @@ namespace ssc::runtime::serviceworker {
         fetch = this->fetches.at(id);
       } while (0);
 
+      // the body is given in ranges when the worker asks for one so a large
+      // upload is never copied into a single reply
+      if (message.has("offset")) {
+        size_t offset = 0;
+        size_t size = FETCH_REQUEST_BODY_MAX_RANGE_SIZE;
+
+        try {
+          offset = std::stoull(message.get("offset"));
+          if (message.has("size")) {
+            size = std::min(size, (size_t) std::stoull(message.get("size")));
+          }
+        } catch (...) {
+          return reply(ipc::Result::Err { message, JSON::Object::Entries {
+            {"message", "Invalid 'offset' or 'size' given in parameters"}
+          }});
+        }
+
+        const auto total = fetch->requestBodySize;
+        const auto range = fetch->readRequestBody(offset, size);
+
+        return reply(ipc::Result {
+          message.seq,
+          message,
+          JSON::Object {},
+          QueuedResponse {
+            rand64(),
+            0,
+            range.shared(),
+            range.size(),
+            "runtime-request-body-size: " + std::to_string(total)
+          }
+        });
+      }
+
+      const auto body = fetch->readRequestBody();
       const auto queuedResponse = QueuedResponse {
         0,
         0,
-        fetch->request.body.buffer.as<unsigned char>(),
-        fetch->request.body.size()
+        body.shared(),
+        body.size()
       };
 
       reply(ipc::Result { message.seq, message, JSON::Object {}, queuedResponse });
@@ -130,12 +255,44 @@ namespace ssc::runtime::serviceworker {
           fetch->response.headers = http::Headers(message.get("headers"));
         }
 
-        if (message.buffer.size() > 0) {
+        if (
+          fetch->streamState == Fetch::StreamState::Pending &&
+          !shouldStreamFetchResponse(*fetch, message.get("runtime-preload-injection"))
+        ) {
+          fetch->streamState = Fetch::StreamState::Buffering;
+        }
+
+        if (message.buffer.size() > 0 && fetch->streamState == Fetch::StreamState::Buffering) {
           fetch->write(message.buffer);
         }
       } while (0);
 
-      reply(ipc::Result { message.seq, message });
+      if (message.buffer.size() == 0 || fetch->streamState == Fetch::StreamState::Buffering) {
+        return reply(ipc::Result { message.seq, message });
+      }
+
+      // the worker writes the next chunk only after this reply, so replying
+      // once the consumer drained the chunk bounds the bytes in flight
+      const auto buffer = bytes::Buffer::from(message.buffer);
+      this->bridge->dispatch([=]() {
+        bool written = false;
+
+        do {
+          Lock lock(fetch->mutex);
+          written = fetch->write(buffer);
+        } while (0);
+
+        if (!written) {
+          return reply(ipc::Result::Err { message, JSON::Object::Entries {
+            {"type", "AbortError"},
+            {"message", "Response stream was closed"}
+          }});
+        }
+
+        fetch->drain([=]() {
+          reply(ipc::Result { message.seq, message });
+        });
+      });
     });
 
     this->bridge->router.map("serviceWorker.fetch.response.finish", [this](auto message, auto router, auto reply) mutable {
@@ -193,11 +350,23 @@ namespace ssc::runtime::serviceworker {
           fetch->response.headers = http::Headers(message.get("headers"));
         }
 
-        if (message.buffer.size() > 0) {
+        if (
+          fetch->streamState == Fetch::StreamState::Pending &&
+          !shouldStreamFetchResponse(*fetch, message.get("runtime-preload-injection"))
+        ) {
+          fetch->streamState = Fetch::StreamState::Buffering;
+        }
+
+        if (message.buffer.size() > 0 && fetch->streamState == Fetch::StreamState::Buffering) {
           fetch->write(message.buffer);
         }
       } while (0);
 
+      // the last chunk of a streamed response is written with the callback
+      const auto buffer = fetch->streamState != Fetch::StreamState::Buffering
+        ? bytes::Buffer::from(message.buffer)
+        : bytes::Buffer::empty();
+
       fetch->finish();
 
       // XXX(@jwerle): we handle this in the android runtime
@@ -245,6 +414,12 @@ namespace ssc::runtime::serviceworker {
       } while (0);
 
       this->bridge->dispatch([=](){
+        if (buffer.size() > 0) {
+          Lock lock(fetch->mutex);
+          fetch->write(buffer);
+          fetch->finish();
+        }
+
         fetch->callback(fetch->response);
       });
 
@@ -326,6 +501,8 @@ namespace ssc::runtime::serviceworker {
 
     const auto& registration = this->registrations.at(key);
 
+    this->updateScopeIndex();
+
     if (this->bridge != nullptr) {
       this->bridge->emit("serviceWorker.register", registration.json(true));
     }
@@ -347,6 +524,7 @@ namespace ssc::runtime::serviceworker {
       }
 
       this->registrations.erase(scope);
+      this->updateScopeIndex();
       return true;
     }
 
@@ -359,6 +537,7 @@ namespace ssc::runtime::serviceworker {
         }
 
         this->registrations.erase(entry.first);
+        this->updateScopeIndex();
         return true;
       }
     }
@@ -378,6 +557,7 @@ namespace ssc::runtime::serviceworker {
         }
 
         this->registrations.erase(entry.first);
+        this->updateScopeIndex();
         return true;
       }
     }
@@ -432,19 +612,99 @@ namespace ssc::runtime::serviceworker {
           this->bridge->emit("serviceWorker.updateState", registration.json().str());
         }
 
+        if (
+          registration.state == Registration::State::Activated ||
+          registration.state == Registration::State::Error
+        ) {
+          this->releasePendingFetches(registration);
+        }
+
         break;
       }
     }
   }
 
+  void Container::releasePendingFetches (const Registration& registration) {
+    Vector<SharedPointer<Fetch>> fetches;
+
+    do {
+      Lock lock(this->mutex);
+      if (!this->pendingFetches.contains(registration.id)) {
+        return;
+      }
+
+      for (const auto id : this->pendingFetches.at(registration.id)) {
+        if (this->fetches.contains(id)) {
+          fetches.push_back(this->fetches.at(id));
+        }
+      }
+
+      this->pendingFetches.erase(registration.id);
+    } while (0);
+
+    for (const auto& fetch : fetches) {
+      // a registration that failed will never handle the fetch, so the
+      // default response is given instead
+      if (registration.state == Registration::State::Error) {
+        do {
+          Lock lock(this->mutex);
+          this->fetches.erase(fetch->id);
+        } while (0);
+
+        if (fetch->callback != nullptr) {
+          fetch->callback(fetch->response);
+        }
+      } else if (!fetch->init(nullptr)) {
+        debug(
+        #if SOCKET_RUNTIME_PLATFORM_APPLE
+          "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%llu'",
+        #else
+          "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%lu'",
+        #endif
+          fetch->request.method.c_str(),
+          fetch->request.url.pathname.c_str(),
+          fetch->request.url.search.c_str(),
+          fetch->request.client.id
+        );
+      }
+    }
+  }
+
   bool Container::fetch (
     const Request& request,
     const Fetch::Options& options,
     const Fetch::Callback callback
   ) {
-    Lock lock(this->mutex);
+    // responses put in the native cache are served for requests in the
+    // scope of a registration without waking the worker, the cache and the
+    // scope index have their own locks so a cached body is read without
+    // holding the container lock
+    if (
+      this->ready() &&
+      request.method == "GET" &&
+      request.headers.get("runtime-serviceworker-fetch-mode") != "ignore"
+    ) {
+      const auto scopeIndex = this->getScopeIndex();
+      if (
+        scopeIndex != nullptr &&
+        scopeIndex->match(request.url.scheme, request.url.pathname).size() > 0
+      ) {
+        auto response = Response(404);
+        if (this->cache.match(request, response)) {
+          response.client = options.client;
+          callback(response);
+          return true;
+        }
+      }
+    }
+
     auto fetch = std::make_shared<Fetch>(*this, request, options);
-    this->fetches.insert_or_assign(fetch->id, fetch);
+
+    do {
+      Lock lock(this->mutex);
+      this->fetches.insert_or_assign(fetch->id, fetch);
+    } while (0);
+
     return fetch->init(callback);
   }
 }
@@ -4,6 +4,12 @@
 using ssc::runtime::string::replace;
 
 namespace ssc::runtime::serviceworker {
+  // how long (in milliseconds) a fetch waits for its registration to activate
+  static constexpr uint64_t FETCH_REGISTRATION_ACTIVATION_TIMEOUT = 32000;
+  // request bodies larger than this (in bytes) are written to a temporary
+  // file for the worker to read in ranges instead of staying in memory
+  static constexpr size_t FETCH_REQUEST_BODY_SPILL_SIZE = 1024 * 1024;
+
   Fetch::Fetch (Container& container, const Request& request, const Options& options)
     : container(container),
       response(404),
@@ -12,6 +18,35 @@ namespace ssc::runtime::serviceworker {
   {
     this->request.client = options.client;
     this->response.client = options.client;
+    this->requestBodySize = this->request.body.size();
+
+    if (this->requestBodySize > FETCH_REQUEST_BODY_SPILL_SIZE) {
+      const auto path = fs::temp_directory_path() / (
+        "socket-serviceworker-fetch-" + std::to_string(this->id) + ".body"
+      );
+
+      std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+      stream.write(
+        reinterpret_cast<const char*>(this->request.body.data()),
+        this->requestBodySize
+      );
+      stream.close();
+
+      if (stream) {
+        this->requestBodyPath = path;
+        this->request.body = bytes::Buffer();
+      } else {
+        std::error_code error;
+        fs::remove(path, error);
+      }
+    }
+  }
+
+  Fetch::~Fetch () {
+    if (!this->requestBodyPath.empty()) {
+      std::error_code error;
+      fs::remove(this->requestBodyPath, error);
+    }
   }
 
   bool Fetch::init (const Callback callback) {
@@ -19,8 +54,16 @@ namespace ssc::runtime::serviceworker {
       return false;
     }
 
-    String scope;
     String pathname = this->request.url.pathname;
+    String scope;
+
+    // the longest registered scope matching the request is found without
+    // taking the container lock
+    const auto scopeIndex = this->container.getScopeIndex();
+    if (scopeIndex != nullptr) {
+      scope = scopeIndex->match(this->request.url.scheme, pathname);
+    }
+
     Lock lock(this->container.mutex);
 
     if (this->container.bridge == nullptr || !this->container.ready()) {
@@ -31,24 +74,6 @@ namespace ssc::runtime::serviceworker {
       this->callback = std::move(callback);
     }
 
-    for (const auto& entry : this->container.registrations) {
-      const auto& registration = entry.second;
-      const auto origin = Origin(this->request.url.str());
-
-      if (
-        (
-          (registration.options.scheme == "*") ||
-          registration.options.scheme == this->request.url.scheme
-        ) &&
-        this->request.url.pathname.starts_with(registration.options.scope)
-      ) {
-        if (entry.first.size() > scope.size()) {
-          scope = entry.first;
-          break;
-        }
-      }
-    }
-
     if (scope.size() > 0) {
       scope = normalizeScope(scope);
     } else {
@@ -70,30 +95,46 @@ namespace ssc::runtime::serviceworker {
           registration.state == Registration::State::Registered
         )
       ) {
-        auto runtime = this->container.bridge->getRuntime();
-        runtime->dispatch([this, runtime, &registration]() {
-          const auto interval = runtime->services.timers.setInterval(8, [this, runtime, &registration] (auto cancel) {
-            if (registration.state == Registration::State::Activated) {
-              if (!this->init(this->callback)) {
-                debug(
-                #if SOCKET_RUNTIME_PLATFORM_APPLE
-                  "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%llu'",
-                #else
-                  "ServiceWorkerContainer: Failed to dispatch fetch request '%s %s%s' for client '%lu'",
-                #endif
-                  request.method.c_str(),
-                  request.url.pathname.c_str(),
-                  request.url.search.c_str(),
-                  request.client.id
-                );
+        // the fetch is released by `Container::updateState()` the instant
+        // the registration activates, or fails after a timeout
+        const auto id = this->id;
+        const auto registrationId = registration.id;
+        auto& container = this->container;
+        auto runtime = container.bridge->getRuntime();
+
+        container.pendingFetches[registrationId].push_back(id);
+
+        runtime->dispatch([runtime, &container, id, registrationId]() {
+          runtime->services.timers.setTimeout(FETCH_REGISTRATION_ACTIVATION_TIMEOUT, [&container, id, registrationId] {
+            SharedPointer<Fetch> fetch = nullptr;
+
+            do {
+              Lock lock(container.mutex);
+              if (!container.pendingFetches.contains(registrationId)) {
+                return;
               }
 
-              cancel();
-            }
-          });
+              auto& pending = container.pendingFetches.at(registrationId);
+              const auto cursor = std::find(pending.begin(), pending.end(), id);
+
+              if (cursor == pending.end()) {
+                return;
+              }
+
+              pending.erase(cursor);
+              if (pending.size() == 0) {
+                container.pendingFetches.erase(registrationId);
+              }
 
-          runtime->services.timers.setTimeout(32000, [this, runtime, interval] {
-            runtime->services.timers.clearInterval(interval);
+              if (container.fetches.contains(id)) {
+                fetch = container.fetches.at(id);
+                container.fetches.erase(id);
+              }
+            } while (0);
+
+            if (fetch != nullptr && fetch->callback != nullptr) {
+              fetch->callback(fetch->response);
+            }
           });
         });
 
@@ -131,11 +172,83 @@ namespace ssc::runtime::serviceworker {
   }
 
   bool Fetch::write (const bytes::Buffer& buffer) {
-    return this->writeQueue.push(buffer);
+    if (this->streamState == StreamState::Closed) {
+      return false;
+    }
+
+    if (
+      this->options.stream == nullptr ||
+      this->streamState == StreamState::Buffering
+    ) {
+      this->streamState = StreamState::Buffering;
+      return this->writeQueue.push(buffer);
+    }
+
+    if (!this->options.stream(this->response, buffer)) {
+      // the consumer declined the stream before any bytes were written
+      if (this->streamState == StreamState::Pending) {
+        this->streamState = StreamState::Buffering;
+        return this->writeQueue.push(buffer);
+      }
+
+      this->streamState = StreamState::Closed;
+      return false;
+    }
+
+    this->streamState = StreamState::Streaming;
+    this->bytesStreamed += buffer.size();
+    return true;
   }
 
   bool Fetch::finish () {
+    // streamed bytes were already handed to the consumer
+    if (
+      this->streamState == StreamState::Streaming ||
+      this->streamState == StreamState::Closed
+    ) {
+      this->response.body = bytes::Buffer::empty();
+      return true;
+    }
+
     this->response.body = bytes::Buffer::from(this->writeQueue);
     return true;
   }
+
+  void Fetch::drain (const Function<void()> callback) {
+    if (this->options.drain != nullptr && this->streamState == StreamState::Streaming) {
+      return this->options.drain(callback);
+    }
+
+    callback();
+  }
+
+  bool Fetch::isStreaming () const {
+    return this->streamState == StreamState::Streaming;
+  }
+
+  const bytes::Buffer Fetch::readRequestBody (size_t offset, size_t size) const {
+    const auto start = std::min(offset, this->requestBodySize);
+    const auto end = size < this->requestBodySize - start
+      ? start + size
+      : this->requestBodySize;
+
+    if (start >= end) {
+      return bytes::Buffer::empty();
+    }
+
+    if (this->requestBodyPath.empty()) {
+      return this->request.body.slice(start, end);
+    }
+
+    auto buffer = bytes::Buffer(end - start);
+    std::ifstream stream(this->requestBodyPath, std::ios::binary);
+    stream.seekg(start);
+    stream.read(reinterpret_cast<char*>(buffer.data()), end - start);
+
+    if (!stream) {
+      return bytes::Buffer::empty();
+    }
+
+    return buffer;
+  }
 }
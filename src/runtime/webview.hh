@@ -56,8 +56,12 @@ namespace ssc::runtime::webview {
         Navigator& navigator;
         Map<String, String> workers;
         Map<String, String> mounts;
+        // drops the resources resolution index when `[webview] watch` sees
+        // a change, owned by the bridge and stopped with it
+        SharedPointer<filesystem::Watcher> resolutionIndexWatcher = nullptr;
 
         Location (Navigator&);
+        ~Location ();
         Location () = delete;
         Location (const Location&) = delete;
         Location (Location&&) = delete;
@@ -232,6 +236,9 @@ namespace ssc::runtime::webview {
 
       #if SOCKET_RUNTIME_PLATFORM_WINDOWS
         ICoreWebView2Environment* env = nullptr;
+        // hands a platform response to the webview, a streamed response is
+        // handed over when its head is written, otherwise when it finishes
+        Function<void(PlatformResponse)> respond = nullptr;
       #endif
 
         Request () = delete;
@@ -286,6 +293,30 @@ namespace ssc::runtime::webview {
         IStream* platformResponseStream = nullptr;
       #endif
 
+      #if SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_WINDOWS
+        // the body of a `streamed` response, the webview reads it
+        // while it is written instead of after `finish()`
+        struct BodyStream;
+        SharedPointer<BodyStream> bodyStream = nullptr;
+      #endif
+
+        // written bytes reach the webview as they are written on Apple and
+        // Android, the linux and windows responses are backed by memory
+        // streams that are read only after `finish()` unless `streamed`
+      #if SOCKET_RUNTIME_PLATFORM_APPLE || SOCKET_RUNTIME_PLATFORM_ANDROID
+        static constexpr bool STREAMS_WRITES = true;
+      #else
+        static constexpr bool STREAMS_WRITES = false;
+      #endif
+
+        // bytes a `streamed` response may hold that the webview has not
+        // read yet before `drain()` defers its callback
+        static constexpr size_t STREAM_HIGH_WATER_MARK = 1024 * 1024;
+
+        // set before `writeHead()` to hand the response to the webview with
+        // its head so its body is read as it is written on every platform
+        bool streamed = false;
+
         Response (
           SharedPointer<Request> request,
           int statusCode = 200,
@@ -312,6 +343,7 @@ namespace ssc::runtime::webview {
         bool send (const filesystem::Resource& resource);
         bool writeHead (int statusCode = 0, const http::Headers headers = {});
         bool finish ();
+        void drain (const Function<void()> callback);
         void setHeader (const String& name, const http::Headers::Value& value);
         void setHeader (const String& name, size_t value);
         void setHeader (const String& name, int64_t value);
@@ -70,7 +70,150 @@ namespace ssc::runtime::webview {
       URL()
   {}
 
-  void Navigator::Location::init () {}
+  // the maximum number of files indexed in a resources directory before
+  // location resolution falls back to probing the file system
+  static constexpr size_t LOCATION_RESOLUTION_INDEX_MAX_ENTRIES = 64 * 1024;
+
+  /**
+   * An in-memory index of the files in the application resources directory
+   * so resolving a location pathname is a few hash lookups instead of
+   * several `stat()` calls per request. Paths are relative to the
+   * directory, `/` separated and case folded on file systems that are
+   * case insensitive by default.
+   */
+  struct LocationResolutionIndex {
+    UnorderedSet<String> files;
+    // `false` if the directory could not be (entirely) indexed
+    bool complete = false;
+  };
+
+  static Map<String, SharedPointer<LocationResolutionIndex>> locationResolutionIndexes;
+  static Mutex locationResolutionIndexMutex;
+
+  static inline String getLocationResolutionIndexKey (const String& path) {
+  #if SOCKET_RUNTIME_PLATFORM_MACOS || SOCKET_RUNTIME_PLATFORM_WINDOWS
+    return string::toLowerCase(path);
+  #else
+    return path;
+  #endif
+  }
+
+  static SharedPointer<LocationResolutionIndex> createLocationResolutionIndex (
+    const String& dirname
+  ) {
+    auto index = std::make_shared<LocationResolutionIndex>();
+
+  #if !SOCKET_RUNTIME_PLATFORM_ANDROID
+    // application resources on android are assets that can not be walked
+    std::error_code error;
+    auto iterator = fs::recursive_directory_iterator(
+      dirname,
+      fs::directory_options::follow_directory_symlink |
+      fs::directory_options::skip_permission_denied,
+      error
+    );
+
+    if (error) {
+      return index;
+    }
+
+    const auto root = fs::canonical(dirname, error);
+    if (error) {
+      return index;
+    }
+
+    // the walk stops on the first error instead of throwing, which leaves
+    // the index incomplete so resolution probes the file system instead
+    const auto end = fs::recursive_directory_iterator();
+    for (; iterator != end; iterator.increment(error)) {
+      if (error) {
+        break;
+      }
+
+      std::error_code ec;
+      const auto& entry = *iterator;
+
+      // a symlinked directory leading back into the tree is not descended
+      // into, it would index the same files again until the path is too long
+      if (entry.is_symlink(ec) && entry.is_directory(ec)) {
+        const auto target = fs::canonical(entry.path(), ec);
+        const auto relative = target.lexically_relative(root).generic_string();
+        if (ec || relative == "." || (relative.size() > 0 && !relative.starts_with(".."))) {
+          iterator.disable_recursion_pending();
+          continue;
+        }
+      }
+
+      if (!entry.is_regular_file(ec)) {
+        continue;
+      }
+
+      if (index->files.size() >= LOCATION_RESOLUTION_INDEX_MAX_ENTRIES) {
+        index->files.clear();
+        return index;
+      }
+
+      const auto relative = entry.path().lexically_relative(dirname).generic_string();
+      index->files.insert(getLocationResolutionIndexKey(relative));
+    }
+
+    if (error) {
+      index->files.clear();
+      return index;
+    }
+
+    index->complete = true;
+  #endif
+
+    return index;
+  }
+
+  static SharedPointer<LocationResolutionIndex> getLocationResolutionIndex (
+    const String& dirname
+  ) {
+    Lock lock(locationResolutionIndexMutex);
+
+    if (!locationResolutionIndexes.contains(dirname)) {
+      locationResolutionIndexes[dirname] = createLocationResolutionIndex(dirname);
+    }
+
+    const auto& index = locationResolutionIndexes.at(dirname);
+    return index->complete ? index : nullptr;
+  }
+
+  static void invalidateLocationResolutionIndex (const String& dirname) {
+    Lock lock(locationResolutionIndexMutex);
+    locationResolutionIndexes.erase(dirname);
+  }
+
+  Navigator::Location::~Location () {
+    if (this->resolutionIndexWatcher != nullptr) {
+      this->resolutionIndexWatcher->stop();
+      this->resolutionIndexWatcher = nullptr;
+    }
+  }
+
+  void Navigator::Location::init () {
+    const auto dirname = filesystem::Resource::getResourcesPath().string();
+
+    this->navigator.bridge.context.loop.dispatch([=]() {
+      getLocationResolutionIndex(dirname);
+    }, loop::Loop::Priority::Low);
+
+  #if !SOCKET_RUNTIME_PLATFORM_ANDROID && !SOCKET_RUNTIME_PLATFORM_IOS
+    // resources change while developing so the index is dropped (and lazily
+    // rebuilt) when anything in the resources directory changes
+    auto userConfig = this->navigator.bridge.userConfig;
+    if (userConfig["webview_watch"] == "true" && this->resolutionIndexWatcher == nullptr) {
+      this->resolutionIndexWatcher = std::make_shared<filesystem::Watcher>(dirname);
+      this->resolutionIndexWatcher->loop = &this->navigator.bridge.context.loop;
+      this->resolutionIndexWatcher->ownsLoop = false;
+      this->resolutionIndexWatcher->start([dirname](auto, auto, auto) {
+        invalidateLocationResolutionIndex(dirname);
+      });
+    }
+  #endif
+  }
 
   /**
    * .
@@ -99,7 +242,8 @@ namespace ssc::runtime::webview {
    **/
   static const Navigator::Location::Resolution resolveLocationPathname (
     const String& pathname,
-    const String& dirname
+    const String& dirname,
+    const SharedPointer<LocationResolutionIndex>& resolutionIndex = nullptr
   ) {
     auto result = pathname;
 
@@ -107,6 +251,66 @@ namespace ssc::runtime::webview {
       result = result.substr(1);
     }
 
+    if (resolutionIndex != nullptr) {
+      const auto hasTrailingSeparator = (
+        result.size() == 0 ||
+        result.ends_with("/") ||
+        result.ends_with("\\")
+      );
+
+      auto key = fs::path(result).lexically_normal().generic_string();
+
+      while (key.ends_with("/")) {
+        key = key.substr(0, key.size() - 1);
+      }
+
+      if (key == ".") {
+        key = "";
+      }
+
+      // paths escaping the directory are resolved on the file system below
+      if (key != ".." && !key.starts_with("../") && !fs::path(result).has_root_path()) {
+        const auto contains = [&resolutionIndex](const String& path) {
+          return resolutionIndex->files.contains(getLocationResolutionIndexKey(path));
+        };
+
+        // 1. the given path is a file
+        if (!hasTrailingSeparator && key.size() > 0 && contains(key)) {
+          return Navigator::Location::Resolution {
+            .pathname = "/" + key
+          };
+        }
+
+        // 2. the given path is a directory with an index.html
+        const auto indexKey = key.size() > 0 ? key + "/index.html" : String("index.html");
+        if (contains(indexKey)) {
+          if (hasTrailingSeparator) {
+            return Navigator::Location::Resolution {
+              .pathname = "/" + indexKey,
+              .redirect = false
+            };
+          } else {
+            return Navigator::Location::Resolution {
+              .pathname = "/" + key + "/",
+              .redirect = true
+            };
+          }
+        }
+
+        // 3. the given path with a .html file extension is a file
+        if (!hasTrailingSeparator && key.size() > 0) {
+          const auto htmlKey = fs::path(key).replace_extension(".html").generic_string();
+          if (contains(htmlKey)) {
+            return Navigator::Location::Resolution {
+              .pathname = "/" + htmlKey
+            };
+          }
+        }
+
+        return Navigator::Location::Resolution {};
+      }
+    }
+
     // Resolve the full path
     const auto filename = (fs::path(dirname) / fs::path(result)).make_preferred();
 
@@ -163,7 +367,21 @@ namespace ssc::runtime::webview {
       }
     }
 
-    auto resolution = resolveLocationPathname(pathname, dirname);
+    const auto resolutionIndex = getLocationResolutionIndex(dirname);
+    auto resolution = resolveLocationPathname(pathname, dirname, resolutionIndex);
+
+    // a file added after the index was built is found on the file system,
+    // which means the index is stale and is dropped to be rebuilt
+    if (resolution.pathname.size() == 0 && resolutionIndex != nullptr) {
+      resolution = resolveLocationPathname(pathname, dirname);
+      if (resolution.pathname.size() > 0) {
+        invalidateLocationResolutionIndex(dirname);
+        this->navigator.bridge.context.loop.dispatch([=]() {
+          getLocationResolutionIndex(dirname);
+        }, loop::Loop::Priority::Low);
+      }
+    }
+
     if (resolution.pathname.size() > 0) {
       resolution.type = Navigator::Location::Resolution::Type::Resource;
     }
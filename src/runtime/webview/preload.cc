@@ -54,6 +54,35 @@ namespace ssc::runtime::webview {
     R"HTML(</script>)HTML"
   );
 
+  static constexpr auto RUNTIME_PRELOAD_PROTOCOL_HANDLERS_PLACEHOLDER = "protocol_handlers";
+  static constexpr const char* RUNTIME_PRELOAD_INJECTION_DISABLED_META_TAGS[] = {
+    R"HTML(<meta name="runtime-preload-injection" content="disabled")HTML",
+    R"HTML(<meta content="disabled" name="runtime-preload-injection")HTML"
+  };
+
+  // the maximum number of documents kept in the injected HTML cache,
+  // the least recently used document is evicted first
+  static constexpr size_t RUNTIME_PRELOAD_HTML_CACHE_MAX_ENTRIES = 64;
+
+  struct InjectedHTMLCacheEntry {
+    String etag;
+    String importMapETag;
+    String html;
+    uint64_t used = 0;
+  };
+
+  static Map<String, InjectedHTMLCacheEntry> injectedHTMLCache;
+  static Mutex injectedHTMLCacheMutex;
+  static uint64_t injectedHTMLCacheClock = 0;
+
+  static inline bool startsWithAt (
+    const String& source,
+    size_t offset,
+    const char* prefix
+  ) {
+    return source.compare(offset, strlen(prefix), prefix) == 0;
+  }
+
   const Preload Preload::compile (const Options& options) {
     auto preload = Preload(options);
     preload.compile();
@@ -741,6 +770,7 @@ namespace ssc::runtime::webview {
       // 22. compile 'sourceURL' source map value if `options.features.useHTMLMarkup == false`
       this->compiled += "//# sourceURL=socket:<runtime>/preload.js";
     }
+    this->compiledHash = std::hash<String>{}(this->compiled);
     return this->compiled;
   }
 
@@ -757,74 +787,213 @@ namespace ssc::runtime::webview {
     }
 
     auto protocolHandlerSchemes = options.protocolHandlerSchemes;
-    auto preload = this->str();
-    auto output = html;
-    if (
-      html.find(RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG) == String::npos &&
-      this->options.userConfig.contains("webview_importmap") &&
-      this->options.userConfig.at("webview_importmap").size() > 0
-    ) {
-      auto resource = filesystem::Resource(Path(this->options.userConfig.at("webview_importmap")));
-
-      if (resource.exists()) {
-        const auto bytes = reinterpret_cast<const char*>(resource.read());
-
-        if (bytes != nullptr) {
-          preload = (
-            tmpl(
-              R"HTML(<script type="importmap">{{importmap}}</script>)HTML",
-              Map<String, String> {{"importmap", String(bytes, resource.size())}}
-           ) + preload
-          );
+    protocolHandlerSchemes.push_back("node:");
+    protocolHandlerSchemes.push_back("npm:");
+
+    const auto protocolHandlers = join(protocolHandlerSchemes, " ");
+    const auto placeholderSize = strlen(RUNTIME_PRELOAD_PROTOCOL_HANDLERS_PLACEHOLDER);
+
+    // a single forward scan over the document records the `{{protocol_handlers}}`
+    // placeholders and the first candidate tag of each kind the preload can
+    // be inserted after, the output is then spliced together in one pass
+    Vector<std::pair<size_t, size_t>> placeholders;
+    size_t importMapCursor = String::npos;
+    size_t headCursor = String::npos;
+    size_t bodyCursor = String::npos;
+    size_t htmlCursor = String::npos;
+    bool isPreloadInjectionDisabled = false;
+    size_t cursor = 0;
+
+    while ((cursor = html.find_first_of("<{", cursor)) != String::npos) {
+      if (html[cursor] == '{') {
+        auto offset = cursor;
+        while (offset < html.size() && html[offset] == '{') {
+          offset++;
+        }
+
+        if (startsWithAt(html, offset, RUNTIME_PRELOAD_PROTOCOL_HANDLERS_PLACEHOLDER)) {
+          auto end = offset + placeholderSize;
+          while (end < html.size() && html[end] == '}') {
+            end++;
+          }
+
+          if (end > offset + placeholderSize) {
+            placeholders.push_back({ cursor, end - cursor });
+            cursor = end;
+            continue;
+          }
+        }
+
+        cursor = offset;
+        continue;
+      }
+
+      if (importMapCursor == String::npos && startsWithAt(html, cursor, RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG)) {
+        importMapCursor = cursor;
+      } else if (headCursor == String::npos && startsWithAt(html, cursor, "<head>")) {
+        headCursor = cursor;
+      } else if (bodyCursor == String::npos && startsWithAt(html, cursor, "<body>")) {
+        bodyCursor = cursor;
+      } else if (htmlCursor == String::npos && startsWithAt(html, cursor, "<html>")) {
+        htmlCursor = cursor;
+      } else if (!isPreloadInjectionDisabled) {
+        for (const auto tag : RUNTIME_PRELOAD_INJECTION_DISABLED_META_TAGS) {
+          if (startsWithAt(html, cursor, tag)) {
+            isPreloadInjectionDisabled = true;
+            break;
+          }
         }
       }
+
+      cursor++;
     }
 
-    protocolHandlerSchemes.push_back("node:");
-    protocolHandlerSchemes.push_back("npm:");
+    String preload;
+
+    if (!isPreloadInjectionDisabled) {
+      if (
+        importMapCursor == String::npos &&
+        this->options.userConfig.contains("webview_importmap") &&
+        this->options.userConfig.at("webview_importmap").size() > 0
+      ) {
+        auto resource = filesystem::Resource(Path(this->options.userConfig.at("webview_importmap")));
 
-    output = tmpl(output, Map<String, String> {
-      {"protocol_handlers", join(protocolHandlerSchemes, " ")}
-    });
+        if (resource.exists()) {
+          const auto bytes = reinterpret_cast<const char*>(resource.read());
 
-    if (output.find("<meta name=\"runtime-preload-injection\" content=\"disabled\"") != String::npos) {
-      preload = "";
-    } else if (output.find("<meta content=\"disabled\" name=\"runtime-preload-injection\"") != String::npos) {
-      preload = "";
+          if (bytes != nullptr) {
+            preload += RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG;
+            preload.append(bytes, resource.size());
+            preload += RUNTIME_PRELOAD_IMPORTMAP_END_TAG;
+          }
+        }
+      }
+
+      preload += this->str();
     }
 
-    const auto existingImportMapCursor = output.find(RUNTIME_PRELOAD_IMPORTMAP_BEGIN_TAG);
-    bool preloadWasInjected = false;
+    // the preload goes after an existing import map (which must precede
+    // any module script), otherwise at the start of `<head>`, `<body>`,
+    // `<html>` or the document, in that order
+    size_t insertionCursor = String::npos;
 
-    if (existingImportMapCursor != String::npos) {
-      const auto closingScriptTag = output.find(
+    if (importMapCursor != String::npos) {
+      const auto closingScriptTag = html.find(
         RUNTIME_PRELOAD_JAVASCRIPT_END_TAG,
-        existingImportMapCursor
+        importMapCursor
       );
 
       if (closingScriptTag != String::npos) {
-        output = (
-          output.substr(0, closingScriptTag + 9) +
-          preload +
-          output.substr(closingScriptTag + 9)
-        );
+        insertionCursor = closingScriptTag + strlen(RUNTIME_PRELOAD_JAVASCRIPT_END_TAG);
+      }
+    }
 
+    if (insertionCursor == String::npos) {
+      if (headCursor != String::npos) {
+        insertionCursor = headCursor + strlen("<head>");
+      } else if (bodyCursor != String::npos) {
+        insertionCursor = bodyCursor + strlen("<body>");
+      } else if (htmlCursor != String::npos) {
+        insertionCursor = htmlCursor + strlen("<html>");
+      } else {
+        insertionCursor = 0;
+      }
+    }
+
+    String output;
+    size_t offset = 0;
+    bool preloadWasInjected = false;
+
+    output.reserve(
+      html.size() +
+      preload.size() +
+      placeholders.size() * protocolHandlers.size()
+    );
+
+    for (const auto& placeholder : placeholders) {
+      if (!preloadWasInjected && insertionCursor <= placeholder.first) {
+        output.append(html, offset, insertionCursor - offset);
+        output += preload;
+        offset = insertionCursor;
         preloadWasInjected = true;
       }
+
+      output.append(html, offset, placeholder.first - offset);
+      output += protocolHandlers;
+      offset = placeholder.first + placeholder.second;
     }
 
     if (!preloadWasInjected) {
-      if (output.find("<head>") != String::npos) {
-        output = replace(output, "<head>", String("<head>" + preload));
-      } else if (output.find("<body>") != String::npos) {
-        output = replace(output, "<body>", String("<body>" + preload));
-      } else if (output.find("<html>") != String::npos) {
-        output = replace(output, "<html>", String("<html>" + preload));
-      } else {
-        output = preload + output;
-      }
+      output.append(html, offset, insertionCursor - offset);
+      output += preload;
+      offset = insertionCursor;
     }
 
+    output.append(html, offset, String::npos);
     return output;
   }
+
+  const String Preload::insertIntoHTML (
+    const filesystem::Resource& resource,
+    const InsertIntoHTMLOptions& options
+  ) const {
+    const auto key = (
+      resource.path.string() + "\n" +
+      std::to_string(this->compiledHash) + "\n" +
+      join(options.protocolHandlerSchemes, " ")
+    );
+
+    // resources without validators (like android assets) are immutable
+    const auto etag = resource.validators().etag;
+    String importMapETag;
+
+    if (
+      this->options.userConfig.contains("webview_importmap") &&
+      this->options.userConfig.at("webview_importmap").size() > 0
+    ) {
+      importMapETag = filesystem::Resource(
+        Path(this->options.userConfig.at("webview_importmap"))
+      ).validators().etag;
+    }
+
+    do {
+      Lock lock(injectedHTMLCacheMutex);
+      if (injectedHTMLCache.contains(key)) {
+        auto& entry = injectedHTMLCache.at(key);
+        if (entry.etag == etag && entry.importMapETag == importMapETag) {
+          entry.used = ++injectedHTMLCacheClock;
+          return entry.html;
+        }
+      }
+    } while (0);
+
+    auto input = filesystem::Resource(resource);
+    const auto html = this->insertIntoHTML(input.str(), options);
+
+    do {
+      Lock lock(injectedHTMLCacheMutex);
+      if (
+        !injectedHTMLCache.contains(key) &&
+        injectedHTMLCache.size() >= RUNTIME_PRELOAD_HTML_CACHE_MAX_ENTRIES
+      ) {
+        auto oldest = injectedHTMLCache.begin();
+        for (auto it = injectedHTMLCache.begin(); it != injectedHTMLCache.end(); ++it) {
+          if (it->second.used < oldest->second.used) {
+            oldest = it;
+          }
+        }
+
+        injectedHTMLCache.erase(oldest);
+      }
+
+      injectedHTMLCache.insert_or_assign(key, InjectedHTMLCacheEntry {
+        etag,
+        importMapETag,
+        html,
+        ++injectedHTMLCacheClock
+      });
+    } while (0);
+
+    return html;
+  }
 }
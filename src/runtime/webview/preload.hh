@@ -5,6 +5,10 @@
 #include "../options.hh"
 #include "../http.hh"
 
+namespace ssc::runtime::filesystem {
+  class Resource;
+}
+
 namespace ssc::runtime::webview {
   using Headers = http::Headers;
 
@@ -15,6 +19,7 @@ namespace ssc::runtime::webview {
    */
   class Preload {
     String compiled = "";
+    size_t compiledHash = 0;
     public:
 
       /**
@@ -163,6 +168,16 @@ namespace ssc::runtime::webview {
       const String& html,
       const InsertIntoHTMLOptions& options
     ) const;
+
+    /**
+     * Inserts and returns compiled preload into the HTML of a resource with
+     * insert options. The output is cached by resource path, content and
+     * compiled preload and reused until any of them change.
+     */
+    const String insertIntoHTML (
+      const filesystem::Resource& resource,
+      const InsertIntoHTMLOptions& options
+    ) const;
   };
 }
 #endif
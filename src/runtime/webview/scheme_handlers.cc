@@ -8,6 +8,12 @@
 
 #include "../webview.hh"
 
+#if SOCKET_RUNTIME_PLATFORM_LINUX
+#include <gio/gunixinputstream.h>
+#include <glib-unix.h>
+#include <sys/socket.h>
+#endif
+
 using namespace ssc::runtime;
 using namespace ssc::runtime::webview;
 using ssc::runtime::url::decodeURIComponent;
@@ -118,7 +124,8 @@ using Task = id<WKURLSchemeTask>;
 }
 @end
 #elif SOCKET_RUNTIME_PLATFORM_LINUX
-static const auto MAX_URI_SCHEME_REQUEST_BODY_BYTES = 4 * 1024 * 1024;
+// request bodies are read from webkit in chunks of this size (in bytes)
+static const auto URI_SCHEME_REQUEST_BODY_CHUNK_SIZE = 64 * 1024;
 static void onURISchemeRequest (WebKitURISchemeRequest* schemeRequest, gpointer userData) {
   static auto globalUserConfig = getUserConfig();
   static auto app = App::sharedApplication();
@@ -309,6 +316,138 @@ namespace ssc::runtime::webview {
   static Map<String, Set<String>> globallyRegisteredSchemesForLinux;
 #endif
 
+  // evaluates `If-None-Match` (or `If-Modified-Since` when absent)
+  // conditional request headers against the validators of a resource
+  static bool isResourceNotModified (
+    const SharedPointer<SchemeHandlers::Request>& request,
+    const filesystem::Resource::Validators& validators
+  ) {
+    if (request->method != "GET" && request->method != "HEAD") {
+      return false;
+    }
+
+    if (request->hasHeader("if-none-match")) {
+      if (validators.etag.size() == 0) {
+        return false;
+      }
+
+      // weak comparison (RFC 9110, section 13.1.2)
+      const auto etag = validators.etag.starts_with("W/")
+        ? validators.etag.substr(2)
+        : validators.etag;
+
+      for (const auto& entry : split(request->getHeader("if-none-match"), ',')) {
+        const auto value = trim(entry);
+        if (value == "*") {
+          return true;
+        }
+
+        if ((value.starts_with("W/") ? value.substr(2) : value) == etag) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    if (request->hasHeader("if-modified-since") && validators.lastModified > 0) {
+      const auto since = http::parseDate(request->getHeader("if-modified-since"));
+      return since > 0 && validators.lastModified <= since;
+    }
+
+    return false;
+  }
+
+  // writes the bytes of `range` from `stream` to `response` in
+  // `highWaterMark` sized chunks without reading the entire resource
+  static bool writeResourceRange (
+    SchemeHandlers::Response& response,
+    filesystem::Resource::ReadStream& stream,
+    const http::ByteRange& range
+  ) {
+    size_t offset = range.start;
+    size_t remaining = range.size();
+
+    while (remaining > 0) {
+      const auto highWaterMark = std::min(remaining, stream.options.highWaterMark);
+      const auto buffer = stream.read(offset, highWaterMark);
+      const auto size = buffer.size.load();
+
+      if (buffer.isEmpty() || !response.write(buffer)) {
+        return false;
+      }
+
+      offset += size;
+      remaining -= size > remaining ? remaining : size;
+    }
+
+    return true;
+  }
+
+  static bool writeResourceRanges (
+    SchemeHandlers::Response& response,
+    filesystem::Resource& resource,
+    const http::ByteRanges& ranges
+  ) {
+    const auto size = resource.size();
+    const auto contentType = resource.mimeType();
+    auto stream = resource.stream();
+
+    if (ranges.size() == 1) {
+      const auto& range = ranges.entries.front();
+
+      if (contentType.size() > 0 && !response.hasHeader("content-type")) {
+        response.setHeader("content-type", contentType);
+      }
+
+      response.setHeader("content-range", range.str(size));
+      response.setHeader("content-length", range.size());
+
+      if (!response.writeHead(206)) {
+        return false;
+      }
+
+      return writeResourceRange(response, stream, range);
+    }
+
+    // multiple ranges are sent as a `multipart/byteranges` body with
+    // a part (and part headers) per range
+    const auto boundary = "socket-runtime-byteranges-" + std::to_string(crypto::rand64());
+    const auto tail = "\r\n--" + boundary + "--\r\n";
+    auto parts = Vector<String>();
+    size_t contentLength = tail.size();
+
+    for (const auto& range : ranges.entries) {
+      auto part = "\r\n--" + boundary + "\r\n";
+
+      if (contentType.size() > 0) {
+        part += "content-type: " + contentType + "\r\n";
+      }
+
+      part += "content-range: " + range.str(size) + "\r\n\r\n";
+      contentLength += part.size() + range.size();
+      parts.push_back(part);
+    }
+
+    response.setHeader("content-type", "multipart/byteranges; boundary=" + boundary);
+    response.setHeader("content-length", contentLength);
+
+    if (!response.writeHead(206)) {
+      return false;
+    }
+
+    for (size_t i = 0; i < ranges.entries.size(); ++i) {
+      if (
+        !response.write(parts[i]) ||
+        !writeResourceRange(response, stream, ranges.entries[i])
+      ) {
+        return false;
+      }
+    }
+
+    return response.write(tail);
+  }
+
   SchemeHandlers::SchemeHandlers (bridge::Bridge& bridge)
     : bridge(bridge)
   {
@@ -687,18 +826,31 @@ namespace ssc::runtime::webview {
       this->request->method == "PUT" ||
       this->request->method == "PATCH"
     ) {
-      GError* error = nullptr;
-      unsigned char tmp[MAX_URI_SCHEME_REQUEST_BODY_BYTES] = {0};
+      // the body is read on the heap in chunks so an upload of any size
+      // neither fills the stack nor gets truncated
+      Vector<uint8_t> body;
       size_t size = 0;
-      const auto success = g_input_stream_read_all(
-        stream,
-        reinterpret_cast<gchar*>(tmp),
-        MAX_URI_SCHEME_REQUEST_BODY_BYTES,
-        &size,
-        nullptr,
-        &this->error
-      );
-      this->request->body = bytes::Buffer::from(tmp, size);
+
+      while (true) {
+        gsize read = 0;
+        body.resize(size + URI_SCHEME_REQUEST_BODY_CHUNK_SIZE);
+        const auto success = g_input_stream_read_all(
+          stream,
+          reinterpret_cast<gchar*>(body.data() + size),
+          URI_SCHEME_REQUEST_BODY_CHUNK_SIZE,
+          &read,
+          nullptr,
+          &this->error
+        );
+
+        size += read;
+        if (!success || read < URI_SCHEME_REQUEST_BODY_CHUNK_SIZE) {
+          break;
+        }
+      }
+
+      body.resize(size);
+      this->request->body = bytes::Buffer::from(body);
     }
     return *this;
   }
@@ -871,6 +1023,305 @@ namespace ssc::runtime::webview {
     };
   }
 
+#if SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_WINDOWS
+  // written chunks of a streamed response body waiting to be read by the
+  // webview, linux writes them to a socket the webview polls and windows
+  // hands them to the webview from a blocking `IStream`
+  struct SchemeHandlers::Response::BodyStream
+    : public std::enable_shared_from_this<SchemeHandlers::Response::BodyStream>
+  {
+    struct Chunk {
+      SharedPointer<unsigned char[]> bytes = nullptr;
+      size_t size = 0;
+      size_t offset = 0;
+    };
+
+    bridge::Bridge& bridge;
+    Mutex mutex;
+    std::deque<Chunk> chunks;
+    Vector<Function<void()>> drains;
+    size_t pending = 0;
+    bool closed = false;
+    bool aborted = false;
+
+  #if SOCKET_RUNTIME_PLATFORM_LINUX
+    // the writable end of the socket pair the webview reads the body from
+    int fd = -1;
+    guint source = 0;
+  #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    std::condition_variable_any condition;
+  #endif
+
+    BodyStream (bridge::Bridge& bridge)
+      : bridge(bridge)
+    {}
+
+    ~BodyStream () {
+    #if SOCKET_RUNTIME_PLATFORM_LINUX
+      if (this->fd > -1) {
+        ::close(this->fd);
+      }
+    #endif
+    }
+
+    bool write (size_t size, SharedPointer<unsigned char[]> bytes) {
+      Lock lock(this->mutex);
+      if (this->closed) {
+        return false;
+      }
+
+      this->chunks.push_back(Chunk { bytes, size, 0 });
+      this->pending += size;
+    #if SOCKET_RUNTIME_PLATFORM_LINUX
+      this->flush();
+    #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      this->condition.notify_all();
+    #endif
+      return true;
+    }
+
+    void drain (const Function<void()> callback) {
+      Lock lock(this->mutex);
+      this->drains.push_back(callback);
+      this->notify();
+    }
+
+    // ends the body once every written chunk was read
+    void close () {
+      Lock lock(this->mutex);
+      this->closed = true;
+    #if SOCKET_RUNTIME_PLATFORM_LINUX
+      this->flush();
+    #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      this->condition.notify_all();
+    #endif
+    }
+
+    // drops unread chunks and ends the body, also called when the
+    // webview stops reading because the request was cancelled
+    void abort () {
+      Lock lock(this->mutex);
+      this->aborted = true;
+      this->closed = true;
+      this->chunks.clear();
+      this->pending = 0;
+    #if SOCKET_RUNTIME_PLATFORM_LINUX
+      this->flush();
+    #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      this->condition.notify_all();
+      this->notify();
+    #endif
+    }
+
+    // runs `drain()` callbacks on the bridge once the unread bytes
+    // fall below the high water mark, the caller holds `mutex`
+    void notify () {
+      if (this->drains.size() == 0 || this->pending >= STREAM_HIGH_WATER_MARK) {
+        return;
+      }
+
+      const auto drains = std::move(this->drains);
+      this->drains.clear();
+      this->bridge.dispatch([drains]() {
+        for (const auto& callback : drains) {
+          callback();
+        }
+      });
+    }
+
+  #if SOCKET_RUNTIME_PLATFORM_LINUX
+    // writes as many chunks as the socket takes without blocking and waits
+    // for it to be writable for the rest, the caller holds `mutex`
+    void flush () {
+      while (this->fd > -1 && this->chunks.size() > 0) {
+        auto& chunk = this->chunks.front();
+        const auto result = ::send(
+          this->fd,
+          chunk.bytes.get() + chunk.offset,
+          chunk.size - chunk.offset,
+          MSG_DONTWAIT | MSG_NOSIGNAL
+        );
+
+        if (result < 0) {
+          if (errno == EINTR) {
+            continue;
+          }
+
+          if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            this->watch();
+            break;
+          }
+
+          // the webview closed its end of the socket
+          this->aborted = true;
+          this->closed = true;
+          this->chunks.clear();
+          this->pending = 0;
+          break;
+        }
+
+        chunk.offset += result;
+        this->pending -= result;
+
+        if (chunk.offset == chunk.size) {
+          this->chunks.pop_front();
+        }
+      }
+
+      if (this->closed && this->chunks.size() == 0 && this->fd > -1) {
+        ::close(this->fd);
+        this->fd = -1;
+      }
+
+      this->notify();
+    }
+
+    void watch () {
+      if (this->source > 0) {
+        return;
+      }
+
+      this->source = g_unix_fd_add_full(
+        G_PRIORITY_DEFAULT,
+        this->fd,
+        G_IO_OUT,
+        [](int fd, GIOCondition condition, gpointer pointer) -> gboolean {
+          const auto stream = *reinterpret_cast<SharedPointer<BodyStream>*>(pointer);
+          Lock lock(stream->mutex);
+          stream->source = 0;
+          stream->flush();
+          return G_SOURCE_REMOVE;
+        },
+        new SharedPointer<BodyStream>(this->shared_from_this()),
+        [](gpointer pointer) {
+          delete reinterpret_cast<SharedPointer<BodyStream>*>(pointer);
+        }
+      );
+    }
+  #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    // blocks the calling webview thread until chunks were written or
+    // the body ended, returns 0 at the end of the body
+    size_t read (unsigned char* output, size_t size) {
+      UniqueLock lock(this->mutex);
+      this->condition.wait(lock, [this]() {
+        return this->chunks.size() > 0 || this->closed;
+      });
+
+      size_t count = 0;
+      while (count < size && this->chunks.size() > 0) {
+        auto& chunk = this->chunks.front();
+        const auto length = std::min(size - count, chunk.size - chunk.offset);
+        memcpy(output + count, chunk.bytes.get() + chunk.offset, length);
+        chunk.offset += length;
+        this->pending -= length;
+        count += length;
+
+        if (chunk.offset == chunk.size) {
+          this->chunks.pop_front();
+        }
+      }
+
+      this->notify();
+      return count;
+    }
+  #endif
+  };
+#endif
+
+#if SOCKET_RUNTIME_PLATFORM_WINDOWS
+  // a read only `IStream` over a `BodyStream` for a streamed
+  // `ICoreWebView2WebResourceResponse` content
+  class SchemeHandlersResponseBodyIStream : public IStream {
+    Atomic<ULONG> references = 1;
+    SharedPointer<SchemeHandlers::Response::BodyStream> stream;
+
+    public:
+      SchemeHandlersResponseBodyIStream (
+        SharedPointer<SchemeHandlers::Response::BodyStream> stream
+      ) : stream(stream)
+      {}
+
+      HRESULT STDMETHODCALLTYPE QueryInterface (REFIID iid, void** object) override {
+        if (object == nullptr) {
+          return E_POINTER;
+        }
+
+        if (iid == IID_IUnknown || iid == IID_ISequentialStream || iid == IID_IStream) {
+          *object = static_cast<IStream*>(this);
+          this->AddRef();
+          return S_OK;
+        }
+
+        *object = nullptr;
+        return E_NOINTERFACE;
+      }
+
+      ULONG STDMETHODCALLTYPE AddRef () override {
+        return ++this->references;
+      }
+
+      ULONG STDMETHODCALLTYPE Release () override {
+        const auto references = --this->references;
+        if (references == 0) {
+          // the webview no longer reads the body
+          this->stream->abort();
+          delete this;
+        }
+        return references;
+      }
+
+      HRESULT STDMETHODCALLTYPE Read (void* output, ULONG size, ULONG* read) override {
+        const auto count = this->stream->read(reinterpret_cast<unsigned char*>(output), size);
+
+        if (read != nullptr) {
+          *read = (ULONG) count;
+        }
+
+        return count > 0 || size == 0 ? S_OK : S_FALSE;
+      }
+
+      HRESULT STDMETHODCALLTYPE Write (const void*, ULONG, ULONG*) override {
+        return STG_E_ACCESSDENIED;
+      }
+
+      HRESULT STDMETHODCALLTYPE Seek (LARGE_INTEGER, DWORD, ULARGE_INTEGER*) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE SetSize (ULARGE_INTEGER) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE CopyTo (IStream*, ULARGE_INTEGER, ULARGE_INTEGER*, ULARGE_INTEGER*) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE Commit (DWORD) override {
+        return S_OK;
+      }
+
+      HRESULT STDMETHODCALLTYPE Revert () override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE LockRegion (ULARGE_INTEGER, ULARGE_INTEGER, DWORD) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE UnlockRegion (ULARGE_INTEGER, ULARGE_INTEGER, DWORD) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE Stat (STATSTG*, DWORD) override {
+        return E_NOTIMPL;
+      }
+
+      HRESULT STDMETHODCALLTYPE Clone (IStream**) override {
+        return E_NOTIMPL;
+      }
+  };
+#endif
+
   SchemeHandlers::Response::Response (
     SharedPointer<Request> request,
     int statusCode,
@@ -943,8 +1394,9 @@ namespace ssc::runtime::webview {
     }
 
   #if SOCKET_RUNTIME_PLATFORM_APPLE || SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_ANDROID
-    // webkit status codes cannot be in the range of 300 >= statusCode < 400
-    if (this->statusCode >= 300 && this->statusCode < 400) {
+    // webkit status codes cannot be in the range of 300 >= statusCode < 400,
+    // with the exception of `304 Not Modified` for conditional requests
+    if (this->statusCode >= 300 && this->statusCode < 400 && this->statusCode != 304) {
       this->statusCode = 200;
     }
   #endif
@@ -991,7 +1443,18 @@ namespace ssc::runtime::webview {
       } catch (...) {}
     }
 
-    if (this->platformResponseStream == nullptr) {
+    if (this->streamed) {
+      int fds[2];
+      if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        debug("SchemeHandlers::Response: Failed to create stream for %s", this->request->str().c_str());
+        return false;
+      }
+
+      this->bodyStream = std::make_shared<BodyStream>(this->handlers->bridge);
+      this->bodyStream->fd = fds[1];
+      // the webview polls the read end as written bytes arrive and closes it
+      this->platformResponseStream = g_unix_input_stream_new(fds[0], true);
+    } else if (this->platformResponseStream == nullptr) {
       this->platformResponseStream = g_memory_input_stream_new();
     }
 
@@ -1019,10 +1482,27 @@ namespace ssc::runtime::webview {
       statusText.size() > 0 ? statusText.c_str() : nullptr
     );
 
+    // a streamed response is handed to the webview now, `finish()`
+    // ends its body when every written byte was read
+    if (this->streamed) {
+      webkit_uri_scheme_request_finish_with_response(
+        this->request->platformRequest,
+        this->platformResponse
+      );
+
+      this->request->platformRequest = nullptr;
+    }
+
     return true;
   #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
     const auto statusText = http::getStatusText(this->statusCode);
-    this->platformResponseStream = SHCreateMemStream(nullptr, 0);
+    if (this->streamed) {
+      this->bodyStream = std::make_shared<BodyStream>(this->handlers->bridge);
+      this->platformResponseStream = new SchemeHandlersResponseBodyIStream(this->bodyStream);
+    } else {
+      this->platformResponseStream = SHCreateMemStream(nullptr, 0);
+    }
+
     const auto result = this->request->env->CreateWebResourceResponse(
       this->platformResponseStream,
       this->statusCode,
@@ -1031,6 +1511,14 @@ namespace ssc::runtime::webview {
       &this->platformResponse
     );
 
+    if (this->streamed) {
+      // the response holds its own reference to the stream
+      this->platformResponseStream->Release();
+      if (result == S_OK && this->request->respond != nullptr) {
+        this->request->respond(this->platformResponse);
+      }
+    }
+
     return result == S_OK;
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
     const auto app = app::App::sharedApplication();
@@ -1127,19 +1615,33 @@ namespace ssc::runtime::webview {
       }
       return true;
     #elif SOCKET_RUNTIME_PLATFORM_LINUX
-      const auto tmp = new unsigned char[size]{0};
-      memcpy(tmp, bytes.get(), size);
-      g_memory_input_stream_add_data(
+      if (this->bodyStream != nullptr) {
+        return this->bodyStream->write(size, bytes);
+      }
+
+      // the stream holds a reference to `bytes` until it is consumed, which
+      // avoids copying (possibly memory mapped) resource bytes into the heap
+      const auto data = g_bytes_new_with_free_func(
+        reinterpret_cast<const void*>(bytes.get()),
+        (gsize) size,
+        [](auto pointer) {
+          delete reinterpret_cast<SharedPointer<unsigned char[]>*>(pointer);
+        },
+        new SharedPointer<unsigned char[]>(bytes)
+      );
+
+      g_memory_input_stream_add_bytes(
         reinterpret_cast<GMemoryInputStream*>(this->platformResponseStream),
-        reinterpret_cast<const void*>(tmp),
-        (gssize) size,
-        [](auto p) {
-          const auto tmp = reinterpret_cast<unsigned char*>(p);
-          delete [] tmp;
-        }
+        data
       );
+
+      g_bytes_unref(data);
       return true;
     #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+      if (this->bodyStream != nullptr) {
+        return this->bodyStream->write(size, bytes);
+      }
+
       return S_OK == this->platformResponseStream->Write(
         reinterpret_cast<const void*>(bytes.get()),
         (ULONG) size,
@@ -1221,7 +1723,13 @@ namespace ssc::runtime::webview {
 
     if (contentLength > 0) {
       this->writeHead();
-      return this->write(contentLength, responseResource.read());
+      if (responseResource.read() == nullptr) {
+        return false;
+      }
+
+      // `bytes` may be a memory mapping of the resource which is written
+      // as is (and released when the platform response is done with it)
+      return this->write(responseResource.size(true), responseResource.bytes);
     }
 
     return false;
@@ -1242,6 +1750,57 @@ namespace ssc::runtime::webview {
   }
 
   bool SchemeHandlers::Response::send (const filesystem::Resource& resource) {
+    const auto validators = resource.validators();
+
+    this->setHeader("accept-ranges", "bytes");
+
+    if (validators.etag.size() > 0 && !this->hasHeader("etag")) {
+      this->setHeader("etag", validators.etag);
+    }
+
+    if (validators.lastModified > 0 && !this->hasHeader("last-modified")) {
+      this->setHeader("last-modified", http::formatDate(validators.lastModified));
+    }
+
+    if (isResourceNotModified(this->request, validators)) {
+      return this->writeHead(304) && this->finish();
+    }
+
+    if (this->request->method == "GET" && this->request->hasHeader("range")) {
+      auto responseResource = filesystem::Resource(resource);
+      const auto size = responseResource.size();
+      const auto ifRange = this->request->getHeader("if-range");
+
+      // `If-Range` carries a (strong) validator of the representation the
+      // client has a part of and the ranges are only served if it matches,
+      // otherwise the entire representation is sent
+      const auto isRangeFresh = ifRange.size() == 0 || (
+        !ifRange.starts_with("W/") && (
+          ifRange == this->getHeader("etag") ||
+          ifRange == this->getHeader("last-modified")
+        )
+      );
+
+      if (isRangeFresh) {
+        const auto ranges = http::ByteRanges::parse(
+          this->request->getHeader("range"),
+          size
+        );
+
+        if (ranges.valid && !ranges.satisfiable) {
+          this->setHeader("content-range", "bytes */" + std::to_string(size));
+          return this->writeHead(416) && this->finish();
+        }
+
+        if (ranges.valid) {
+          return (
+            writeResourceRanges(*this, responseResource, ranges) &&
+            this->finish()
+          );
+        }
+      }
+    }
+
     return this->write(resource) && this->finish();
   }
 
@@ -1281,7 +1840,13 @@ namespace ssc::runtime::webview {
   #endif
     this->platformResponse = nullptr;
   #elif SOCKET_RUNTIME_PLATFORM_LINUX
-    if (this->request && this->request->platformRequest && this->platformResponse) {
+    if (this->bodyStream != nullptr) {
+      // the webview owns the stream since the head was written
+      this->bodyStream->close();
+      g_object_unref(this->platformResponseStream);
+      this->platformResponseStream = nullptr;
+      this->platformResponse = nullptr;
+    } else if (this->request && this->request->platformRequest && this->platformResponse) {
       webkit_uri_scheme_request_finish_with_response(
         this->request->platformRequest,
         this->platformResponse
@@ -1306,6 +1871,10 @@ namespace ssc::runtime::webview {
       this->platformResponse = nullptr;
     }
   #elif SOCKET_RUNTIME_PLATFORM_WINDOWS
+    if (this->bodyStream != nullptr) {
+      this->bodyStream->close();
+    }
+
     this->platformResponseStream = nullptr;
     // TODO(@jwerle): move more `WebResourceRequested` logic to here
   #elif SOCKET_RUNTIME_PLATFORM_ANDROID
@@ -1331,6 +1900,16 @@ namespace ssc::runtime::webview {
     return true;
   }
 
+  void SchemeHandlers::Response::drain (const Function<void()> callback) {
+  #if SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_WINDOWS
+    if (this->bodyStream != nullptr) {
+      return this->bodyStream->drain(callback);
+    }
+  #endif
+
+    callback();
+  }
+
   void SchemeHandlers::Response::setHeader (const String& name, const Headers::Value& value) {
     auto app = App::sharedApplication();
     const auto bridge = &this->request->handlers->bridge;
@@ -1414,6 +1993,16 @@ namespace ssc::runtime::webview {
       return false;
     }
 
+  #if SOCKET_RUNTIME_PLATFORM_LINUX || SOCKET_RUNTIME_PLATFORM_WINDOWS
+    // the head of a streamed response was already handed to the
+    // webview, so its body can only end early
+    if (this->bodyStream != nullptr) {
+      this->bodyStream->abort();
+      this->finished = true;
+      return true;
+    }
+  #endif
+
   #if SOCKET_RUNTIME_PLATFORM_APPLE
     const auto error = [NSError
       errorWithDomain: @(bundleIdentifier.c_str())
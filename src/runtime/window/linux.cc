@@ -352,8 +352,7 @@ namespace ssc::runtime::window {
         return false;
       }
 
-      const auto bytes = reinterpret_cast<const char*>(file.read());
-      const auto lines = split(bytes, '\n');
+      const auto lines = split(file.str(), '\n');
 
       for (const auto& line : lines) {
         if (toLowerCase(line).find("dark") != String::npos) {
@@ -1156,16 +1156,24 @@ namespace SSC {
                     return E_FAIL;
                   }
 
+                  // a streamed response is handed over when its head is
+                  // written, before the handler callback below is called
+                  auto responded = std::make_shared<Atomic<bool>>(false);
+                  req->respond = [=](auto platformResponse) mutable {
+                    if (!responded->exchange(true)) {
+                      args->put_Response(platformResponse);
+                      deferral->Complete();
+                    }
+                  };
+
                   const auto handled = this->bridge->schemeHandlers.handleRequest(req, [=](const auto& response) mutable {
-                    args->put_Response(response.platformResponse);
-                    deferral->Complete();
+                    req->respond(response.platformResponse);
                   });
 
                   if (!handled) {
                     auto response = webview::SchemeHandlers::Response(req, 404);
                     response.finish();
-                    args->put_Response(response.platformResponse);
-                    deferral->Complete();
+                    req->respond(response.platformResponse);
                   }
 
                   return S_OK;
@@ -1,6 +1,8 @@
-import { spawn, exec } from 'socket:child_process'
+import { spawn, exec, execSync } from 'socket:child_process'
+import { rand64 } from 'socket:crypto'
 import process from 'socket:process'
 import test from 'socket:test'
+import ipc from 'socket:ipc'
 import os from 'socket:os'
 
 test('child_process.spawn(command[,args[,options]])', async (t) => {
@@ -76,3 +78,130 @@ test('await child_process.exec(command)', async (t) => {
   const { stdout } = await exec('ls -la')
   t.ok(stdout && stdout.length, 'stdout from await exec() has output')
 })
+
+test('child_process.execSync(command) output is binary safe', async (t) => {
+  if (!/linux|darwin/i.test(os.platform())) {
+    return t.comment('skipping on this platform')
+  }
+
+  const output = execSync("printf 'a\\000b\\nc\\377\\r\\n%%'")
+  t.ok(Buffer.isBuffer(output), 'output is a buffer')
+  t.deepEqual(
+    Array.from(output),
+    [0x61, 0x00, 0x62, 0x0a, 0x63, 0xff, 0x0d, 0x0a, 0x25],
+    'NUL bytes, newlines, high bytes and percent signs are kept'
+  )
+
+  t.equal(execSync('printf hello', { encoding: 'utf8' }), 'hello', 'output is decoded with an encoding')
+})
+
+test('child_process.execSync(command, { timeout }) kills the child', async (t) => {
+  if (!/linux|darwin/i.test(os.platform())) {
+    return t.comment('skipping on this platform')
+  }
+
+  const start = Date.now()
+  let error = null
+
+  try {
+    execSync('printf started; sleep 10', { timeout: 200 })
+  } catch (err) {
+    error = err
+  }
+
+  t.ok(error, 'a timed out exec throws')
+  t.equal(error?.code, 'ETIMEDOUT', 'error code is ETIMEDOUT')
+  t.equal(error?.stdout?.toString(), 'started', 'output written before the timeout is kept')
+  t.ok(Date.now() - start < 5000, 'the child was killed before it finished')
+
+  // the killed child no longer holds the exec id
+  t.equal(execSync('printf after', { encoding: 'utf8' }), 'after', 'exec works after a timeout')
+})
+
+test('child_process.spawn(command, args, { stream: true }) output is complete', async (t) => {
+  if (!/linux|darwin/i.test(os.platform())) {
+    return t.comment('skipping on this platform')
+  }
+
+  const size = 2 * 1024 * 1024
+  const child = spawn('head', ['-c', String(size), '/dev/zero'], { stream: true })
+  let received = 0
+  let nonzero = 0
+
+  await new Promise((resolve, reject) => {
+    child.stdout.on('data', (data) => {
+      const buffer = Buffer.from(data)
+      received += buffer.byteLength
+      nonzero += buffer.filter((byte) => byte !== 0).length
+
+      // a slow consumer, the child is paused while the output is not drained
+      if (received < size) {
+        child.stdout.pause()
+        setTimeout(() => child.stdout.resume(), 1)
+      }
+    })
+
+    child.on('close', resolve)
+    child.on('error', reject)
+  })
+
+  t.equal(received, size, 'all streamed output is received')
+  t.equal(nonzero, 0, 'streamed output is byte exact')
+})
+
+test('child_process.pause and child_process.resume', async (t) => {
+  if (!/linux|darwin/i.test(os.platform())) {
+    return t.comment('skipping on this platform')
+  }
+
+  const id = rand64()
+  const chunks = []
+  let closed = null
+
+  const onData = ({ detail }) => {
+    const { source, data } = detail?.params ?? {}
+    if (!/child_?process\.spawn/i.test(source ?? '') || BigInt(data?.id ?? 0) !== id) {
+      return
+    }
+
+    if (data.status === 'close') {
+      closed?.()
+    } else if (data.source === 'stdout' && detail.data) {
+      chunks.push(Buffer.from(detail.data))
+    }
+  }
+
+  const close = new Promise((resolve) => { closed = resolve })
+  globalThis.addEventListener('data', onData)
+
+  const result = await ipc.send('child_process.spawn', {
+    id,
+    args: ['sh', '-c', '"printf a; sleep 0.3; printf b"'].join('\u0001'),
+    stdin: false,
+    stream: true
+  })
+
+  t.ok(!result.err, 'spawns a child process with raw output')
+
+  let err = (await ipc.send('child_process.pause', { id })).err
+  t.ok(!err, 'pauses reading the output of the child process')
+
+  await new Promise((resolve) => setTimeout(resolve, 500))
+
+  err = (await ipc.send('child_process.resume', { id })).err
+  t.ok(!err, 'resumes reading the output of the child process')
+
+  if (result.data?.stream) {
+    const params = new URLSearchParams({ id: String(id), source: 'stdout' })
+    const response = await fetch(`ipc://child_process.stream?${params}`)
+    chunks.push(Buffer.from(await response.arrayBuffer()))
+  }
+
+  await close
+  globalThis.removeEventListener('data', onData)
+
+  t.equal(Buffer.concat(chunks).toString(), 'ab', 'output written while paused is not lost')
+
+  err = (await ipc.send('child_process.pause', { id: rand64() })).err
+  t.equal(err?.name, 'NotFoundError', 'pausing an unknown child process fails')
+})
@@ -1,6 +1,9 @@
 import { test } from 'socket:test'
 import crypto from 'socket:crypto'
 import Buffer from 'socket:buffer'
+import path from 'socket:path'
+import fs from 'socket:fs/promises'
+import os from 'socket:os'
 
 test('crypto', async (t) => {
   t.equal(crypto.webcrypto, window.crypto, 'crypto.webcrypto is window.crypto')
@@ -28,3 +31,92 @@ test('crypto.rand64', (t) => {
   t.ok(randoms.every(b => typeof b === 'bigint'), 'crypto.rand64 returns a bigint')
   t.ok(randoms.some(b => b !== randoms[9]), 'crypto.rand64 returns a different bigint each time')
 })
+
+test('crypto.randomFill', async (t) => {
+  const values = new Uint32Array(1024)
+  const result = await crypto.randomFill(values)
+  t.equal(result, values, 'crypto.randomFill returns the given buffer')
+  t.ok(values.some(value => value !== 0), 'crypto.randomFill fills the buffer')
+
+  const view = new Uint8Array(64).subarray(16, 48)
+  await crypto.randomFill(view)
+  t.ok(new Uint8Array(view.buffer, 0, 16).every(value => value === 0), 'crypto.randomFill only fills the view')
+
+  const large = await crypto.randomFill(new Uint8Array(256 * 1024))
+  t.ok(large.some(value => value !== 0), 'crypto.randomFill fills large buffers')
+})
+
+test('crypto.randomFill(buffer[, offset[, size]], callback)', async (t) => {
+  const values = new Uint16Array(64)
+  const result = await new Promise((resolve, reject) => {
+    crypto.randomFill(values, 16, 32, (err, buffer) => err ? reject(err) : resolve(buffer))
+  })
+
+  t.equal(result, values, 'the callback is called with the given buffer')
+  t.ok(values.subarray(0, 16).every(value => value === 0), 'elements before offset are not filled')
+  t.ok(values.subarray(48).every(value => value === 0), 'elements after offset + size are not filled')
+  t.ok(values.subarray(16, 48).some(value => value !== 0), 'size elements from offset are filled')
+
+  const bytes = new ArrayBuffer(32)
+  await new Promise((resolve, reject) => {
+    crypto.randomFill(bytes, 8, (err) => err ? reject(err) : resolve())
+  })
+
+  t.ok(new Uint8Array(bytes, 0, 8).every(value => value === 0), 'an ArrayBuffer is filled from offset')
+  t.ok(new Uint8Array(bytes, 8).some(value => value !== 0), 'an ArrayBuffer is filled to its end')
+
+  const filled = await new Promise((resolve, reject) => {
+    crypto.randomFill(new Uint8Array(16), (err, buffer) => err ? reject(err) : resolve(buffer))
+  })
+
+  t.ok(filled.some(value => value !== 0), 'a buffer is filled with only a callback')
+  t.equal(crypto.randomFill(new Uint8Array(16), () => {}), undefined, 'nothing is returned with a callback')
+
+  t.throws(() => crypto.randomFill(new Uint8Array(16), 17), /offset/, 'an offset past the end throws')
+  t.throws(() => crypto.randomFill(new Uint8Array(16), 8, 9), /size/, 'a size past the end throws')
+})
+
+test('crypto.digest', async (t) => {
+  const input = Buffer.from('abc')
+  const vectors = {
+    sha1: 'a9993e364706816aba3e25717850c26c9cd0d89d',
+    sha256: 'ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad',
+    blake3: '6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85'
+  }
+
+  for (const [algorithm, expected] of Object.entries(vectors)) {
+    const digest = await crypto.digest(algorithm, input)
+    t.equal(digest.toString('hex'), expected, `crypto.digest('${algorithm}') computes the digest of bytes`)
+  }
+
+  const webDigest = await crypto.createDigest('SHA-256', new Uint8Array(4096))
+  const digest = await crypto.digest('SHA-256', new Uint8Array(4096))
+  t.equal(digest.toString('hex'), webDigest.toString('hex'), 'crypto.digest matches crypto.createDigest')
+
+  const filename = path.join(os.tmpdir(), `crypto digest ${Math.random().toString(16).slice(2)}.txt`)
+  await fs.writeFile(filename, input)
+
+  try {
+    const url = new URL(`file://${filename.replace(/\\/g, '/').replace(/^([a-zA-Z]:)/, '/$1')}`)
+    t.equal(
+      (await crypto.digest('sha256', filename)).toString('hex'),
+      vectors.sha256,
+      'crypto.digest computes the digest of a file path'
+    )
+
+    t.equal(
+      (await crypto.digest('sha256', url)).toString('hex'),
+      vectors.sha256,
+      'crypto.digest computes the digest of a file URL'
+    )
+  } finally {
+    await fs.unlink(filename)
+  }
+
+  try {
+    await crypto.digest('md5', input)
+    t.fail('crypto.digest rejects unsupported algorithms')
+  } catch (err) {
+    t.ok(err, 'crypto.digest rejects unsupported algorithms')
+  }
+})
@@ -1,2 +1,4 @@
 // import './diagnostics/channels.js'
 import './diagnostics/window.js'
+import './diagnostics/ipc.js'
+import './diagnostics/queued-responses.js'
@@ -0,0 +1,43 @@
+import diagnostics from 'socket:diagnostics'
+import test from 'socket:test'
+import ipc from 'socket:ipc'
+import os from 'socket:os'
+
+test('diagnostics - ipc - routes', async (t) => {
+  const calls = 8
+  const before = (await diagnostics.runtime.query()).ipc.routes
+
+  for (let i = 0; i < calls; ++i) {
+    await ipc.request('os.uptime')
+  }
+
+  const missing = `${os.tmpdir()}/diagnostics-ipc-routes-${Date.now()}-missing`
+  const result = await ipc.request('fs.stat', { path: missing })
+  t.ok(result.err, 'fs.stat fails for a missing path')
+
+  const after = (await diagnostics.runtime.query()).ipc.routes
+  const uptime = after['os.uptime']
+  const stat = after['fs.stat']
+
+  t.ok(uptime, 'routes include a called route')
+  t.equal(uptime.calls - (before['os.uptime']?.calls ?? 0), calls, 'calls are counted')
+  t.equal(uptime.replies - (before['os.uptime']?.replies ?? 0), calls, 'replies are counted')
+  t.equal(uptime.errors - (before['os.uptime']?.errors ?? 0), 0, 'successful replies are not errors')
+  t.ok(uptime.bytes.in > 0, 'incoming bytes are counted')
+  t.ok(uptime.latency.max > 0, 'latencies are measured')
+  t.ok(
+    uptime.latency.p50 <= uptime.latency.p99 &&
+    uptime.latency.p99 <= uptime.latency.max,
+    'latency percentiles are ordered'
+  )
+
+  t.ok(stat, 'routes include a failed route')
+  t.equal(stat.errors - (before['fs.stat']?.errors ?? 0), 1, 'errors are counted')
+
+  // routes that reply several times to one call, such as chunked or event
+  // streams, count a single reply
+  t.ok(
+    Object.values(after).every((route) => route.replies <= route.calls),
+    'no route has more replies than calls'
+  )
+})
@@ -0,0 +1,23 @@
+import diagnostics from 'socket:diagnostics'
+import test from 'socket:test'
+import ipc from 'socket:ipc'
+
+test('diagnostics - queued responses - counters', async (t) => {
+  const before = (await diagnostics.runtime.query()).queuedResponses
+  const misses = 4
+
+  for (let i = 0; i < misses; ++i) {
+    const result = await ipc.request('queuedResponse', { id: String(Date.now() + i) })
+    t.equal(result.err?.name, 'NotFoundError', 'an unknown queued response is not found')
+  }
+
+  const after = (await diagnostics.runtime.query()).queuedResponses
+
+  t.equal(after.misses - before.misses, misses, 'misses are counted')
+  t.ok(after.hits >= before.hits, 'hits never decrease')
+  t.ok(after.evictions >= before.evictions, 'evictions never decrease')
+  t.ok(after.expirations >= before.expirations, 'expirations never decrease')
+  t.equal(after.handles.count, after.handles.ids.length, 'every queued response handle is listed')
+  t.ok(after.bytes >= 0, 'queued bytes are reported')
+  t.ok(after.hitLatency.max >= after.hitLatency.average, 'the maximum hit latency bounds the average')
+})
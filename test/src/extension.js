@@ -1,4 +1,6 @@
 import './extensions/simple.js'
 import './extensions/sqlite3.js'
 import './extensions/feature-policies.js'
+import './extensions/work.js'
+import './extensions/bytes.js'
 // import './extensions/wasm.js'
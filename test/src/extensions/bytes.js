@@ -0,0 +1,67 @@
+import extension from 'socket:extension'
+import test from 'socket:test'
+import ipc from 'socket:ipc'
+
+const BYTES_SIZE = 64 * 1024
+
+function isExpectedBody (data) {
+  if (!data || data.byteLength !== BYTES_SIZE) {
+    return false
+  }
+
+  const bytes = new Uint8Array(data.buffer ?? data, data.byteOffset ?? 0, data.byteLength)
+  for (let i = 0; i < bytes.length; ++i) {
+    if (bytes[i] !== i % 256) {
+      return false
+    }
+  }
+
+  return true
+}
+
+async function waitForFrees (count, timeout = 2000) {
+  const started = Date.now()
+  let result = null
+
+  do {
+    result = await ipc.request('simple.bytes.frees')
+    if (result.err || result.data?.frees >= count) {
+      break
+    }
+
+    await new Promise((resolve) => setTimeout(resolve, 16))
+  } while (Date.now() - started < timeout)
+
+  return result
+}
+
+test('extension.load(name) - owned ipc bytes', async (t) => {
+  let bytes = null
+
+  try {
+    bytes = await extension.load('simple-bytes')
+  } catch (err) {
+    return t.ifError(err)
+  }
+
+  let result = await ipc.request('simple.bytes', { value: 'owned' }, { responseType: 'arraybuffer' })
+  if (result.err) return t.ifError(result.err)
+  t.ok(isExpectedBody(result.data), 'bytes with a free callback arrive intact')
+
+  result = await waitForFrees(1)
+  if (result.err) return t.ifError(result.err)
+  t.equal(result.data?.frees, 1, 'free callback is called once the response is released')
+  t.equal(result.data?.invalid, 0, 'free callback is given the owned bytes and user data')
+
+  result = await ipc.request('simple.bytes', { value: 'alloc' }, { responseType: 'arraybuffer' })
+  if (result.err) return t.ifError(result.err)
+  t.ok(isExpectedBody(result.data), 'bytes from sapi_bytes_alloc() arrive intact')
+
+  // give a second release (a double free) a chance to happen
+  await new Promise((resolve) => setTimeout(resolve, 100))
+  result = await ipc.request('simple.bytes.frees')
+  if (result.err) return t.ifError(result.err)
+  t.equal(result.data?.frees, 1, 'free callback is called exactly once')
+
+  t.ok(await bytes.unload(), 'unload')
+})
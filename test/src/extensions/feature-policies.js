@@ -41,3 +41,49 @@ test('extension.load(name) - feature policies', async (t) => {
 
   await simple.unload()
 })
+
+test('extension.load(name, { allow }) - enforced policies', async (t) => {
+  // `simple.policy.ping` is mapped without the extension checking its
+  // policies, so only the runtime can deny it. handling a request needs
+  // `context_create` and replying needs `ipc_router_reply`
+  const cases = [
+    { allow: null, allowed: true, label: 'allowed without policies' },
+    { allow: ['none'], allowed: false, label: 'denied by an unrelated policy' },
+    { allow: ['context', 'env'], allowed: false, label: 'denied without an ipc policy' },
+    { allow: ['context', 'ipc'], allowed: true, label: 'allowed by the ipc prefix' },
+    { allow: ['context', 'ipc_router'], allowed: true, label: 'allowed by the ipc_router prefix' },
+    {
+      allow: ['context_create', 'ipc_router_map', 'ipc_router_unmap', 'ipc_router_reply'],
+      allowed: true,
+      label: 'allowed by exact policies'
+    },
+    {
+      allow: ['context', 'ipc_router_unmap', 'ipc_router_listen', 'ipc_router_reply'],
+      allowed: false,
+      label: 'denied without ipc_router_map'
+    }
+  ]
+
+  for (const { allow, allowed, label } of cases) {
+    let simple = null
+
+    try {
+      simple = await extension.load('simple-ipc-ping', allow ? { allow } : {})
+    } catch (err) {
+      return t.ifError(err)
+    }
+
+    const result = await ipc.request('simple.policy.ping', { value: 'hello world' })
+
+    if (allowed) {
+      t.equal(result.data, 'hello world', `ipc_router_map ${label}`)
+    } else {
+      t.ok(/not found/i.test(result.err?.message), `ipc_router_map ${label}`)
+    }
+
+    await simple.unload()
+
+    const unloaded = await ipc.request('simple.policy.ping', { value: 'hello world' })
+    t.ok(/not found/i.test(unloaded.err?.message), `route is unmapped after unload (${label})`)
+  }
+})
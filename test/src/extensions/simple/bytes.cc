@@ -0,0 +1,91 @@
+#include <socket/extension.h>
+
+#include <atomic>
+#include <cstring>
+
+static constexpr unsigned int BYTES_SIZE = 64 * 1024;
+
+static std::atomic<int> frees = 0;
+static std::atomic<int> invalidFrees = 0;
+static int freeCallbackData = 0;
+
+static void fill (unsigned char* bytes, unsigned int size) {
+  for (unsigned int i = 0; i < size; ++i) {
+    bytes[i] = (unsigned char) (i % 256);
+  }
+}
+
+static void onfree (unsigned char* bytes, void* data) {
+  if (bytes == NULL || data != &freeCallbackData) {
+    invalidFrees++;
+  }
+
+  delete [] bytes;
+  frees++;
+}
+
+static void onbytes (
+  sapi_context_t* context,
+  sapi_ipc_message_t* message,
+  const sapi_ipc_router_t* router
+) {
+  const char* value = sapi_ipc_message_get_value(message);
+  auto result = sapi_ipc_result_create(context, message);
+  unsigned char* bytes = NULL;
+
+  sapi_ipc_result_set_header(result, "content-type", "application/octet-stream");
+
+  if (value != NULL && strcmp(value, "alloc") == 0) {
+    // released by the runtime, no callback is given
+    bytes = sapi_bytes_alloc(BYTES_SIZE);
+    if (bytes == NULL) {
+      sapi_ipc_reply_with_error(result, "Failed to allocate bytes");
+      return;
+    }
+
+    fill(bytes, BYTES_SIZE);
+    sapi_ipc_result_set_bytes_owned(result, BYTES_SIZE, bytes, NULL, NULL);
+  } else {
+    bytes = new unsigned char[BYTES_SIZE];
+    fill(bytes, BYTES_SIZE);
+    sapi_ipc_result_set_bytes_owned(result, BYTES_SIZE, bytes, onfree, &freeCallbackData);
+  }
+
+  sapi_ipc_reply(result);
+}
+
+static void onfrees (
+  sapi_context_t* context,
+  sapi_ipc_message_t* message,
+  const sapi_ipc_router_t* router
+) {
+  auto result = sapi_ipc_result_create(context, message);
+  auto object = sapi_json_object_create(context);
+
+  sapi_json_object_set(object, "frees", sapi_json_number_create(context, frees.load()));
+  sapi_json_object_set(object, "invalid", sapi_json_number_create(context, invalidFrees.load()));
+  sapi_ipc_result_set_json_data(result, sapi_json_any(object));
+  sapi_ipc_reply(result);
+}
+
+bool initialize (sapi_context_t* context, const void *data) {
+  frees = 0;
+  invalidFrees = 0;
+  sapi_ipc_router_map(context, "simple.bytes", onbytes, data);
+  sapi_ipc_router_map(context, "simple.bytes.frees", onfrees, data);
+  return true;
+}
+
+bool deinitialize (sapi_context_t* context, const void *data) {
+  sapi_ipc_router_unmap(context, "simple.bytes");
+  sapi_ipc_router_unmap(context, "simple.bytes.frees");
+  return true;
+}
+
+SOCKET_RUNTIME_REGISTER_EXTENSION(
+  "simple-bytes", // name
+  initialize, // initializer
+  deinitialize, // deinitializer
+  "a simple owned IPC bytes extension", // description
+  "0.1.0" // version
+);
@@ -18,6 +18,9 @@ bool initialize (sapi_context_t* context, const void *data) {
   if (sapi_extension_is_allowed(context, "ipc_router_map")) {
     sapi_ipc_router_map(context, "simple.ping", onping, data);
   }
+
+  // not checked here, the runtime enforces the policies of the extension
+  sapi_ipc_router_map(context, "simple.policy.ping", onping, data);
   return true;
 }
 
@@ -25,6 +28,8 @@ bool deinitialize (sapi_context_t* context, const void *data) {
   if (sapi_extension_is_allowed(context, "ipc_router_unmap")) {
     sapi_ipc_router_unmap(context, "simple.ping");
   }
+
+  sapi_ipc_router_unmap(context, "simple.policy.ping");
   return true;
 }
 
@@ -0,0 +1,61 @@
+#include <socket/extension.h>
+
+#include <chrono>
+#include <thread>
+
+static void onwork (sapi_context_work_t* work, const void* data) {
+  // runs until cancelled, or long enough to be cancelled while running
+  for (int i = 0; i < 200 && !sapi_context_work_cancelled(work); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+static void onafterwork (sapi_context_t* context, const void* data, bool cancelled) {
+  auto result = (sapi_ipc_result_t*) data;
+  auto object = sapi_json_object_create(context);
+  auto boolean = sapi_json_boolean_create(context, cancelled);
+  sapi_json_object_set(object, "cancelled", boolean);
+
+  sapi_ipc_result_set_json_data(result, sapi_json_any(object));
+  sapi_ipc_reply(result);
+}
+
+static void onqueue (
+  sapi_context_t* context,
+  sapi_ipc_message_t* message,
+  const sapi_ipc_router_t* router
+) {
+  const char* value = sapi_ipc_message_get_value(message);
+  auto result = sapi_ipc_result_create(context, message);
+  auto work = sapi_context_queue_work(context, result, onwork, onafterwork);
+
+  if (work == NULL) {
+    sapi_ipc_reply_with_error(result, "Failed to queue work");
+    return;
+  }
+
+  // cleared before `onafterwork()`, so an abort after the reply is ignored
+  sapi_ipc_set_work_cancellation_handler(result, work);
+
+  if (value != NULL && value[0] == '1') {
+    sapi_context_work_cancel(work);
+  }
+}
+
+bool initialize (sapi_context_t* context, const void *data) {
+  sapi_ipc_router_map(context, "simple.work", onqueue, data);
+  return true;
+}
+
+bool deinitialize (sapi_context_t* context, const void *data) {
+  sapi_ipc_router_unmap(context, "simple.work");
+  return true;
+}
+
+SOCKET_RUNTIME_REGISTER_EXTENSION(
+  "simple-work", // name
+  initialize, // initializer
+  deinitialize, // deinitializer
+  "a simple queued work extension", // description
+  "0.1.0" // version
+);
@@ -17,3 +17,28 @@ test('extension.load(name) - wasm', async (t) => {
 
   globalThis.wasm = wasm
 })
+
+test('extension.load(name) - wasm owned bytes', async (t) => {
+  const { wasm } = globalThis
+  const failed = wasm.adapter.instance.exports.ok_failed()
+  const count = wasm.adapter.instance.exports.ok_count()
+  const result = await wasm.binding['bytes.owned']()
+
+  t.equal(
+    new TextDecoder().decode(result.data),
+    'world',
+    'sapi_ipc_result_set_bytes_owned() replies with a copy of the bytes'
+  )
+
+  t.equal(
+    wasm.adapter.instance.exports.ok_count() - count,
+    8,
+    'owned bytes tests ran in the extension'
+  )
+
+  t.equal(
+    wasm.adapter.instance.exports.ok_failed(),
+    failed,
+    'owned bytes tests passed in the extension'
+  )
+})
@@ -15,6 +15,46 @@ static void onhello (
   sapi_ipc_reply(result);
 }
 
+static int freed = 0;
+static void onfree (unsigned char* bytes, void* data) {
+  freed++;
+  sapi_bytes_free(bytes);
+}
+
+static void onbytesowned (
+  sapi_context_t* context,
+  sapi_ipc_message_t* message,
+  const sapi_ipc_router_t* router
+) {
+  auto result = sapi_ipc_result_create(context, message);
+  auto bytes = sapi_bytes_alloc(5);
+  memcpy(bytes, "hello", 5);
+  freed = 0;
+
+  // released through `onfree()`, the result keeps a copy
+  sapi_ipc_result_set_bytes_owned(result, 5, bytes, onfree, NULL);
+  test(freed == 1);
+  test(sapi_ipc_result_get_bytes(result) != NULL);
+  test(sapi_ipc_result_get_bytes(result) != bytes);
+  test(sapi_ipc_result_get_bytes_size(result) == 5);
+  test(memcmp(sapi_ipc_result_get_bytes(result), "hello", 5) == 0);
+
+  // released by the runtime, replacing the previous copy
+  bytes = sapi_bytes_alloc(5);
+  memcpy(bytes, "world", 5);
+  sapi_ipc_result_set_bytes_owned(result, 5, bytes, NULL, NULL);
+  test(freed == 1);
+  test(memcmp(sapi_ipc_result_get_bytes(result), "world", 5) == 0);
+
+  // reusing the released bytes must not change the result
+  bytes = sapi_bytes_alloc(5);
+  memcpy(bytes, "xxxxx", 5);
+  test(memcmp(sapi_ipc_result_get_bytes(result), "world", 5) == 0);
+  sapi_bytes_free(bytes);
+
+  sapi_ipc_reply(result);
+}
+
 void initialize_sapi_tests (sapi_context_t* context) {
   auto object = sapi_json_object_create(context);
   auto string = sapi_json_string_create(context, "world");
@@ -33,4 +73,5 @@ void initialize_sapi_tests (sapi_context_t* context) {
   test(strcmp("bar", sapi_context_config_get(context, "foo")) == 0);
 
   sapi_ipc_router_map(context, "wasm.hello", onhello, NULL);
+  sapi_ipc_router_map(context, "wasm.bytes.owned", onbytesowned, NULL);
 }
@@ -0,0 +1,33 @@
+import extension from 'socket:extension'
+import test from 'socket:test'
+import ipc from 'socket:ipc'
+
+test('extension.load(name) - queued work', async (t) => {
+  let work = null
+
+  try {
+    work = await extension.load('simple-work')
+  } catch (err) {
+    return t.ifError(err)
+  }
+
+  let result = await ipc.request('simple.work', { value: '0' })
+  if (result.err) return t.ifError(result.err)
+  t.equal(result.data?.cancelled, false, 'after_work(cancelled = false) for completed work')
+
+  result = await ipc.request('simple.work', { value: '1' })
+  if (result.err) return t.ifError(result.err)
+  t.equal(result.data?.cancelled, true, 'after_work(cancelled = true) for cancelled work')
+
+  // many requests that complete while their cancellation handlers are set
+  const results = await Promise.all(
+    Array.from({ length: 16 }, (_, i) => ipc.request('simple.work', { value: String(i % 2) }))
+  )
+
+  t.ok(
+    results.every((result, i) => !result.err && result.data?.cancelled === (i % 2 === 1)),
+    'after_work(cancelled) matches for concurrent work'
+  )
+
+  t.ok(await work.unload(), 'unload')
+})
@@ -21,6 +21,9 @@ import './test.js'
 import './enumeration.js'
 import './language.js'
 import './i18n.js'
+import './resources.js'
+import './service-worker.js'
+import './timers.js'
 import './router-resolution.js'
 import './mime.js'
 import './application-url-event.js'
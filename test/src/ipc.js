@@ -143,3 +143,26 @@ test('ipc.send success', async (t) => {
   const { data } = response
   t.ok(typeof data === 'object', 'sendSync works')
 })
+
+test('ipc loop dispatch latency', async (t) => {
+  // `timers.setTimeout` with `wait` replies from a zero delay timer, so each
+  // round trip includes a dispatch to the runtime loop and its callback
+  const samples = []
+  for (let i = 0; i < 128; ++i) {
+    const start = performance.now()
+    const result = await ipc.request('timers.setTimeout', { timeout: 0, wait: true })
+    if (result.err) {
+      return t.fail(result.err)
+    }
+
+    samples.push(performance.now() - start)
+  }
+
+  samples.sort((a, b) => a - b)
+
+  const median = samples[samples.length >> 1]
+  const p99 = samples[Math.floor(samples.length * 0.99)]
+
+  t.comment(`dispatch round trip: median ${median.toFixed(3)}ms, p99 ${p99.toFixed(3)}ms`)
+  t.ok(median < 16, 'median dispatch round trip is within a frame')
+})
@@ -0,0 +1,93 @@
+import test from 'socket:test'
+
+const alphabet = 'abcdefghijklmnopqrstuvwxyz'
+const alphabetURL = new URL('./resources/alphabet.txt', import.meta.url)
+
+test('resources - range requests', async (t) => {
+  let response = await fetch(alphabetURL)
+  t.equal(response.status, 200, 'responds with 200 without a range')
+  t.equal(response.headers.get('accept-ranges'), 'bytes', 'advertises byte ranges')
+  t.equal(await response.text(), alphabet, 'responds with the entire resource')
+
+  response = await fetch(alphabetURL, { headers: { range: 'bytes=2-5' } })
+  t.equal(response.status, 206, 'responds with 206 for a single range')
+  t.equal(response.headers.get('content-range'), 'bytes 2-5/26', 'sets content-range')
+  t.equal(response.headers.get('content-length'), '4', 'sets content-length to the range size')
+  t.equal(await response.text(), 'cdef', 'responds with the bytes in range')
+
+  response = await fetch(alphabetURL, { headers: { range: 'bytes=-3' } })
+  t.equal(response.status, 206, 'responds with 206 for a suffix range')
+  t.equal(await response.text(), 'xyz', 'responds with the last bytes')
+
+  response = await fetch(alphabetURL, { headers: { range: 'bytes=0-2,10-12' } })
+  t.equal(response.status, 206, 'responds with 206 for multiple ranges')
+  t.ok(
+    response.headers.get('content-type')?.startsWith('multipart/byteranges; boundary='),
+    'responds with a multipart/byteranges body'
+  )
+
+  const body = await response.text()
+  t.ok(body.includes('content-range: bytes 0-2/26\r\n\r\nabc'), 'includes the first part')
+  t.ok(body.includes('content-range: bytes 10-12/26\r\n\r\nklm'), 'includes the second part')
+
+  response = await fetch(alphabetURL, { headers: { range: 'bytes=100-200' } })
+  t.equal(response.status, 416, 'responds with 416 for an unsatisfiable range')
+  t.equal(response.headers.get('content-range'), 'bytes */26', 'sets content-range to the size')
+
+  for (const range of ['bytes=', 'bytes= , ']) {
+    response = await fetch(alphabetURL, { headers: { range } })
+    t.equal(response.status, 200, `ignores '${range}' without range specs`)
+    t.equal(await response.text(), alphabet, `serves the full body for '${range}'`)
+  }
+})
+
+test('resources - conditional requests', async (t) => {
+  let response = await fetch(alphabetURL, { cache: 'no-store' })
+  const etag = response.headers.get('etag')
+  const lastModified = response.headers.get('last-modified')
+  await response.text()
+
+  t.ok(etag, 'sets an etag')
+  t.ok(lastModified, 'sets last-modified')
+
+  response = await fetch(alphabetURL, { cache: 'no-store' })
+  await response.text()
+  t.equal(response.headers.get('etag'), etag, 'the etag is stable across requests')
+  t.equal(response.headers.get('last-modified'), lastModified, 'last-modified is stable across requests')
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { 'if-none-match': etag } })
+  t.equal(response.status, 304, 'responds with 304 for a matching if-none-match')
+  t.equal(await response.text(), '', 'a 304 response has no body')
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { 'if-none-match': `"other", ${etag}` } })
+  t.equal(response.status, 304, 'responds with 304 when any if-none-match entry matches')
+  await response.text()
+
+  const weak = etag.startsWith('W/') ? etag : `W/${etag}`
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { 'if-none-match': weak } })
+  t.equal(response.status, 304, 'if-none-match uses the weak comparison')
+  await response.text()
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { 'if-none-match': '"not-the-etag"' } })
+  t.equal(response.status, 200, 'responds with 200 for a mismatched if-none-match')
+  t.equal(await response.text(), alphabet, 'a mismatched if-none-match gets the entire resource')
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { 'if-modified-since': lastModified } })
+  t.equal(response.status, 304, 'responds with 304 for if-modified-since at last-modified')
+  t.equal(await response.text(), '', 'a 304 response to if-modified-since has no body')
+
+  response = await fetch(alphabetURL, {
+    cache: 'no-store',
+    headers: { 'if-modified-since': new Date(Date.parse(lastModified) - 60 * 1000).toUTCString() }
+  })
+  t.equal(response.status, 200, 'responds with 200 for if-modified-since before last-modified')
+  await response.text()
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { range: 'bytes=2-5', 'if-range': etag } })
+  t.equal(response.status, 206, 'serves the range for a matching if-range')
+  t.equal(await response.text(), 'cdef', 'a matching if-range gets the bytes in range')
+
+  response = await fetch(alphabetURL, { cache: 'no-store', headers: { range: 'bytes=2-5', 'if-range': weak } })
+  t.equal(response.status, 200, 'responds with 200 for a weak if-range validator')
+  t.equal(await response.text(), alphabet, 'a weak if-range gets the entire resource')
+})
@@ -1,5 +1,8 @@
 import test from 'socket:test'
+import process from 'socket:process'
+import path from 'socket:path'
 import URL from 'socket:url'
+import fs from 'socket:fs/promises'
 import os from 'socket:os'
 
 const basePath = 'router-resolution'
@@ -87,6 +90,51 @@ test('router-resolution', async (t) => {
   }
 })
 
+if (!['android', 'ios'].includes(os.platform())) {
+  test('router-resolution - files added after the index was built', async (t) => {
+    const name = `added-${Math.random().toString(16).slice(2)}`
+    const directory = path.join(process.cwd(), basePath, name)
+
+    let response = await fetch(`${dirname}/${name}/`)
+    t.equal(response.status, 404, `404 for '/${name}/' before it exists`)
+
+    await fs.mkdir(directory, { recursive: true })
+
+    if (!isWindows) {
+      // a directory symlink back into the tree must not stop the index
+      // from being rebuilt
+      await fs.symlink('..', path.join(directory, 'loop'))
+    }
+
+    await fs.writeFile(path.join(directory, 'index.html'), `/${name}/index.html`)
+    await fs.writeFile(path.join(directory, 'page.html'), `/${name}/page.html`)
+
+    try {
+      response = await fetch(`${dirname}/${name}/`)
+      t.equal(response.status, 200, `'/${name}/' resolves once it exists`)
+      t.ok((await response.text()).includes(`/${name}/index.html`), `'/${name}/' resolves to '/${name}/index.html'`)
+
+      response = await fetch(`${dirname}/${name}`, { redirect: 'manual' })
+      const body = (await response.text()).trim()
+      t.equal(extractUrl(response, body), `/${basePath}/${name}/`, `'/${name}' redirects to '/${name}/'`)
+
+      response = await fetch(`${dirname}/${name}/page`)
+      t.ok((await response.text()).includes(`/${name}/page.html`), `'/${name}/page' resolves to '/${name}/page.html'`)
+
+      // the rebuilt index still resolves what was indexed before
+      response = await fetch(`${dirname}/an-index-file/`)
+      t.ok((await response.text()).includes('/an-index-file/index.html'), 'rebuilt index resolves existing files')
+    } finally {
+      await fs.unlink(path.join(directory, 'index.html'))
+      await fs.unlink(path.join(directory, 'page.html'))
+      if (!isWindows) {
+        await fs.unlink(path.join(directory, 'loop'))
+      }
+      await fs.rmdir(directory)
+    }
+  })
+}
+
 function extractUrl (response, content) {
   const location = response.headers.get('content-location') || response.headers.get('location')
   const regex = /url\s*=\s*(["'])([^"']+)\1/i
@@ -0,0 +1,172 @@
+#include "tests.hh"
+#include "src/runtime/bytes.hh"
+
+namespace SSC::Tests {
+  using namespace ssc::runtime::bytes;
+
+  // deterministic bytes, every value appears for sizes above 256
+  static String createBytes (size_t size) {
+    String output(size, 0);
+    uint32_t state = 0x9e3779b9;
+
+    for (size_t i = 0; i < size; ++i) {
+      state = state * 1664525 + 1013904223;
+      output[i] = (char) (i < 256 ? i : state >> 24);
+    }
+
+    return output;
+  }
+
+  static String toURLSafe (String input) {
+    for (auto& c : input) {
+      if (c == '+') c = '-';
+      else if (c == '/') c = '_';
+    }
+
+    while (input.size() > 0 && input.back() == '=') {
+      input.pop_back();
+    }
+
+    return input;
+  }
+
+  void bytes (Harness& t) {
+    t.test("ssc::runtime::bytes::base64::encode()", [](auto t) {
+      t.equals(base64::encode(String("")), "", "encodes ''");
+      t.equals(base64::encode(String("f")), "Zg==", "encodes 'f'");
+      t.equals(base64::encode(String("fo")), "Zm8=", "encodes 'fo'");
+      t.equals(base64::encode(String("foo")), "Zm9v", "encodes 'foo'");
+      t.equals(base64::encode(String("foob")), "Zm9vYg==", "encodes 'foob'");
+      t.equals(base64::encode(String("fooba")), "Zm9vYmE=", "encodes 'fooba'");
+      t.equals(base64::encode(String("foobar")), "Zm9vYmFy", "encodes 'foobar'");
+      t.equals(base64::encode(String("\xfb\xff\xbf")), "+/+/", "encodes with the standard alphabet");
+      t.equals(
+        base64::encode(String("\xfb\xff\xbf\xfb"), base64::Alphabet::URLSafe),
+        "-_-_-w",
+        "encodes with the URL safe alphabet and without padding"
+      );
+    });
+
+    t.test("ssc::runtime::bytes::base64::decode()", [](auto t) {
+      t.equals(base64::decode("Zm9vYmFy"), "foobar", "decodes 'Zm9vYmFy'");
+      t.equals(base64::decode("Zm9vYg=="), "foob", "decodes padded input");
+      t.equals(base64::decode("Zm9vYg"), "foob", "decodes unpadded input");
+      t.equals(base64::decode("+/+/"), "\xfb\xff\xbf", "decodes the standard alphabet");
+      t.equals(base64::decode("-_-_"), "\xfb\xff\xbf", "decodes the URL safe alphabet");
+      t.equals(base64::decode("-_-_-w"), "\xfb\xff\xbf\xfb", "decodes unpadded URL safe input");
+    });
+
+    t.test("ssc::runtime::bytes::base64 round trips", [](auto t) {
+      bool standard = true;
+      bool urlsafe = true;
+      bool alphabets = true;
+
+      // covers the vectorized blocks and every scalar tail size
+      for (size_t size = 0; size <= 1024; ++size) {
+        const auto input = createBytes(size);
+        const auto encoded = base64::encode(input);
+        const auto encodedURLSafe = base64::encode(input, base64::Alphabet::URLSafe);
+
+        standard = standard && base64::decode(encoded) == input;
+        urlsafe = urlsafe && base64::decode(encodedURLSafe) == input;
+        alphabets = alphabets && encodedURLSafe == toURLSafe(encoded);
+      }
+
+      t.assert(standard, "standard input round trips for sizes 0 to 1024");
+      t.assert(urlsafe, "URL safe input round trips for sizes 0 to 1024");
+      t.assert(alphabets, "URL safe output only differs in its alphabet and padding");
+    });
+
+    t.test("ssc::runtime::bytes::base64_decode() invalid input", [](auto t) {
+      const auto input = createBytes(300);
+      const auto encoded = base64::encode(input);
+      unsigned char output[512] = {0};
+      bool rejected = true;
+
+      // an invalid character at every position of vectorized and scalar input
+      for (size_t i = 0; i < encoded.size(); ++i) {
+        for (const auto c : { '!', '*', '.', ' ', '\0', '\x80' }) {
+          auto invalid = encoded;
+          invalid[i] = c;
+          rejected = rejected && base64_decode(invalid.data(), invalid.size(), output, sizeof(output)) == 0;
+        }
+      }
+
+      t.assert(rejected, "an invalid character at any position is rejected");
+      t.equals(base64::decode("Zm9v!"), "", "invalid input decodes to an empty string");
+      t.equals(base64_decode("Zm9vYmFy", 8, output, 5), (size_t) 0, "a too small output is rejected");
+      t.equals(base64_decode("", 0, output, sizeof(output)), (size_t) 0, "empty input decodes to nothing");
+      t.assert(
+        base64_decode_length(encoded.size()) >= input.size() &&
+        base64_decode_length(toURLSafe(encoded).size()) >= input.size(),
+        "decode length is an upper bound for padded and unpadded input"
+      );
+    });
+
+    t.test("ssc::runtime::bytes::base64::Encoder and Decoder", [](auto t) {
+      const auto input = createBytes(1000);
+      bool encoded = true;
+      bool decoded = true;
+
+      // chunk sizes that split groups at every offset
+      for (const auto chunkSize : { 1, 2, 3, 4, 5, 7, 64, 100, 999 }) {
+        for (const auto alphabet : { base64::Alphabet::Standard, base64::Alphabet::URLSafe }) {
+          const auto expected = base64::encode(input, alphabet);
+          base64::Encoder encoder(alphabet);
+          base64::Decoder decoder;
+          String output;
+          String result;
+
+          for (size_t offset = 0; offset < input.size(); offset += chunkSize) {
+            output += encoder.update(input.substr(offset, chunkSize));
+          }
+
+          output += encoder.finalize();
+          encoded = encoded && output == expected;
+
+          for (size_t offset = 0; offset < expected.size(); offset += chunkSize) {
+            result += decoder.update(expected.substr(offset, chunkSize));
+          }
+
+          result += decoder.finalize();
+          decoded = decoded && result == input && !decoder.failed();
+        }
+      }
+
+      t.assert(encoded, "chunked encoding matches a single encode");
+      t.assert(decoded, "chunked decoding matches the input");
+
+      base64::Decoder decoder;
+      decoder.update(String("Zm9v"));
+      decoder.update(String("Zm!v"));
+      decoder.finalize();
+      t.assert(decoder.failed(), "chunked decoding fails on an invalid character");
+    });
+
+    t.test("ssc::runtime::bytes::encodeHexString()", [](auto t) {
+      t.equals(encodeHexString(String("hello world")), "68656C6C6F20776F726C64", "encodes a string in uppercase");
+      t.equals(
+        encodeHexString(Vector<uint8_t> { 0x00, 0x0f, 0xab, 0xff }),
+        "000fabff",
+        "encodes bytes in lowercase"
+      );
+    });
+
+    t.test("ssc::runtime::bytes::decodeHexString()", [](auto t) {
+      bool roundtrip = true;
+
+      for (size_t size = 0; size <= 512; ++size) {
+        const auto input = createBytes(size);
+        const auto encoded = encodeHexString(input);
+        const auto lowercase = encodeHexString(Vector<uint8_t>(input.begin(), input.end()));
+        roundtrip = roundtrip && decodeHexString(encoded) == input && decodeHexString(lowercase) == input;
+      }
+
+      t.assert(roundtrip, "uppercase and lowercase hex round trips for sizes 0 to 512");
+      t.equals(decodeHexString("68656C6C6F"), "hello", "decodes '68656C6C6F'");
+      t.equals(decodeHexString("68656c6c6f0"), "hello", "ignores a trailing odd character");
+      t.equals(decodeHexString("68656G6C6F"), "", "invalid input decodes to an empty string");
+      t.equals(decodeHexString("6865 6C6F"), "", "whitespace is invalid");
+    });
+  }
+}
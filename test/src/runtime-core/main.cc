@@ -4,6 +4,7 @@
 static bool initialize (sapi_context_t* context, const void *data) {
   SSC::Tests::Harness harness;
   return harness.run("runtime-core-tests", [](auto t) {
+    t.run(SSC::Tests::bytes);
     t.run(SSC::Tests::codec);
     t.run(SSC::Tests::config);
     t.run(SSC::Tests::env);
@@ -11,6 +12,7 @@ static bool initialize (sapi_context_t* context, const void *data) {
     t.run(SSC::Tests::json);
     t.run(SSC::Tests::platform);
     t.run(SSC::Tests::preload);
+    t.run(SSC::Tests::queuedResponses);
     t.run(SSC::Tests::string);
     t.run(SSC::Tests::version);
   });
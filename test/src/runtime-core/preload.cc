@@ -1,7 +1,177 @@
+#include <fstream>
+
 #include "tests.hh"
+#include "src/runtime/filesystem.hh"
+#include "src/runtime/webview/preload.hh"
 
 namespace SSC::Tests {
+  namespace fs = ssc::fs;
+  using ssc::runtime::types::Path;
+  using ssc::runtime::filesystem::Resource;
+  using ssc::runtime::webview::Preload;
+
+  static Path createTemporaryDirectory (const String& name) {
+    const auto directory = fs::temp_directory_path() / (
+      "socket-runtime-core-preload-" + name + "-" +
+      std::to_string(std::chrono::system_clock::now().time_since_epoch().count())
+    );
+
+    fs::create_directories(directory);
+    return directory;
+  }
+
+  static void writeFile (const Path& path, const String& contents) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream << contents;
+  }
+
+  static Preload::InsertIntoHTMLOptions createInsertIntoHTMLOptions (
+    const Preload& preload
+  ) {
+    auto options = Preload::InsertIntoHTMLOptions {};
+    options.userConfig = preload.options.userConfig;
+    options.protocolHandlerSchemes = { "web+test:" };
+    return options;
+  }
+
   void preload (Harness& t) {
-    t.assert(createPreload(WindowOptions {}), "createPreload() returns non-empty string");;
+    t.test("ssc::runtime::webview::Preload::compile", [](auto t) {
+      const auto preload = Preload::compile(Preload::Options {});
+      t.assert(preload.str().size() > 0, "compile() returns a non-empty preload");
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML protocol handlers", [](auto t) {
+      const auto preload = Preload::compile(Preload::Options {});
+      const auto options = createInsertIntoHTMLOptions(preload);
+      const auto html = preload.insertIntoHTML(
+        R"HTML(<html><head></head><body>{{protocol_handlers}}|{{{protocol_handlers}}}|{{other}}</body></html>)HTML",
+        options
+      );
+
+      t.equals(
+        html,
+        "<html><head>" + preload.str() + "</head><body>" +
+        "web+test: node: npm:|web+test: node: npm:|{{other}}" +
+        "</body></html>",
+        "every '{{protocol_handlers}}' placeholder is replaced and other keys are kept"
+      );
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML without <head>", [](auto t) {
+      const auto preload = Preload::compile(Preload::Options {});
+      const auto options = createInsertIntoHTMLOptions(preload);
+
+      t.equals(
+        preload.insertIntoHTML("<html><body><p>hello</p></body></html>", options),
+        "<html><body>" + preload.str() + "<p>hello</p></body></html>",
+        "preload is inserted at the start of <body>"
+      );
+
+      t.equals(
+        preload.insertIntoHTML("<html><p>hello</p></html>", options),
+        "<html>" + preload.str() + "<p>hello</p></html>",
+        "preload is inserted at the start of <html>"
+      );
+
+      t.equals(
+        preload.insertIntoHTML("<p>hello</p>", options),
+        preload.str() + "<p>hello</p>",
+        "preload is inserted at the start of the document"
+      );
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML import maps and opt out", [](auto t) {
+      const auto preload = Preload::compile(Preload::Options {});
+      const auto options = createInsertIntoHTMLOptions(preload);
+      const auto importmap = String(R"HTML(<script type="importmap">{"imports":{}}</script>)HTML");
+      const auto disabled = String(R"HTML(<meta name="runtime-preload-injection" content="disabled">)HTML");
+
+      t.equals(
+        preload.insertIntoHTML("<html><head>" + importmap + "</head></html>", options),
+        "<html><head>" + importmap + preload.str() + "</head></html>",
+        "preload is inserted after an existing import map"
+      );
+
+      t.equals(
+        preload.insertIntoHTML("<html><head>" + disabled + "</head></html>", options),
+        "<html><head>" + disabled + "</head></html>",
+        "preload is not inserted when injection is disabled"
+      );
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML cache invalidation", [](auto t) {
+      const auto directory = createTemporaryDirectory("invalidation");
+      const auto page = directory / "index.html";
+      const auto importmap = directory / "importmap.json";
+
+      writeFile(importmap, R"JSON({"imports":{"a":"./a.js"}})JSON");
+      writeFile(page, "<html><head></head><body>first</body></html>");
+
+      auto preloadOptions = Preload::Options {};
+      preloadOptions.userConfig["webview_importmap"] = importmap.string();
+
+      const auto preload = Preload::compile(preloadOptions);
+      const auto options = createInsertIntoHTMLOptions(preload);
+
+      auto html = preload.insertIntoHTML(Resource(page), options);
+      t.assert(html.find("first") != String::npos, "page is rendered");
+      t.assert(html.find("./a.js") != String::npos, "import map is rendered");
+      t.equals(
+        preload.insertIntoHTML(Resource(page), options),
+        html,
+        "unchanged page is served from the cache"
+      );
+
+      writeFile(page, "<html><head></head><body>second page</body></html>");
+      html = preload.insertIntoHTML(Resource(page), options);
+      t.assert(html.find("second page") != String::npos, "changed page is rendered again");
+
+      writeFile(importmap, R"JSON({"imports":{"b":"./b/index.js"}})JSON");
+      html = preload.insertIntoHTML(Resource(page), options);
+      t.assert(html.find("./b/index.js") != String::npos, "changed import map is rendered again");
+      t.assert(html.find("./a.js") == String::npos, "stale import map is not served");
+
+      fs::remove_all(directory);
+    });
+
+    t.test("ssc::runtime::webview::Preload::insertIntoHTML cache eviction", [](auto t) {
+      const auto directory = createTemporaryDirectory("eviction");
+      const auto preload = Preload::compile(Preload::Options {});
+      const auto options = createInsertIntoHTMLOptions(preload);
+      const auto page = directory / "index.html";
+
+      writeFile(page, "<html><body>alpha</body></html>");
+      t.assert(
+        preload.insertIntoHTML(Resource(page), options).find("alpha") != String::npos,
+        "page is rendered"
+      );
+
+      // rewrite the page with the same size and modification time so its
+      // validators (and therefore its cache entry) are left untouched, the
+      // stale output is only replaced once the entry has been evicted
+      const auto modified = fs::last_write_time(page);
+      writeFile(page, "<html><body>omega</body></html>");
+      fs::last_write_time(page, modified);
+
+      t.assert(
+        preload.insertIntoHTML(Resource(page), options).find("alpha") != String::npos,
+        "page with unchanged validators is served from the cache"
+      );
+
+      // 64 entries is the cache capacity, filling it with other pages
+      // must evict the least recently used entry first
+      for (int i = 0; i < 64; ++i) {
+        const auto other = directory / ("page-" + std::to_string(i) + ".html");
+        writeFile(other, "<html><body>" + std::to_string(i) + "</body></html>");
+        preload.insertIntoHTML(Resource(other), options);
+      }
+
+      t.assert(
+        preload.insertIntoHTML(Resource(page), options).find("omega") != String::npos,
+        "least recently used page is evicted past 64 entries"
+      );
+
+      fs::remove_all(directory);
+    });
   }
 }
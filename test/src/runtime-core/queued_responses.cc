@@ -0,0 +1,91 @@
+#include <thread>
+
+#include "tests.hh"
+#include "src/runtime/queued_response.hh"
+
+namespace SSC::Tests {
+  using ssc::runtime::QueuedResponse;
+  using ssc::runtime::QueuedResponses;
+
+  static QueuedResponse createQueuedResponse (uint64_t id, size_t length, uint64_t ttl = 0) {
+    auto response = QueuedResponse {};
+    response.id = id;
+    response.ttl = ttl;
+    response.length = length;
+    response.body = std::make_shared<unsigned char[]>(length);
+    return response;
+  }
+
+  static void sleep (uint64_t milliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+  }
+
+  void queuedResponses (Harness& t) {
+    t.test("ssc::runtime::QueuedResponses ttl", [](auto t) {
+      QueuedResponses queuedResponses(QueuedResponses::Options { .ttl = 50 });
+      QueuedResponse response;
+
+      queuedResponses.put(createQueuedResponse(1, 8));
+      queuedResponses.put(createQueuedResponse(2, 8, 60 * 1000));
+      queuedResponses.put(createQueuedResponse(3, 8));
+
+      t.equals(queuedResponses.expire(), (size_t) 0, "nothing expires before the ttl");
+      sleep(80);
+
+      t.assert(!queuedResponses.take(3, response), "an expired entry is not taken");
+      t.equals((size_t) queuedResponses.counters.expirations.load(), (size_t) 1, "taking an expired entry counts an expiration");
+      t.equals(queuedResponses.expire(), (size_t) 1, "expire() removes the other expired entry");
+      t.equals((size_t) queuedResponses.counters.expirations.load(), (size_t) 2, "expire() counts its expirations");
+      t.assert(queuedResponses.contains(2), "a response ttl overrides the default ttl");
+      t.equals(queuedResponses.bytes(), (size_t) 8, "expired bytes are released");
+    });
+
+    t.test("ssc::runtime::QueuedResponses budget", [](auto t) {
+      QueuedResponses queuedResponses(QueuedResponses::Options { .maxBytes = 100, .evictionGracePeriod = 0 });
+
+      queuedResponses.put(createQueuedResponse(1, 40));
+      queuedResponses.put(createQueuedResponse(2, 40));
+      queuedResponses.put(createQueuedResponse(3, 40));
+
+      t.assert(!queuedResponses.contains(1), "the oldest entry is evicted");
+      t.assert(queuedResponses.contains(2) && queuedResponses.contains(3), "newer entries are kept");
+      t.equals((size_t) queuedResponses.counters.evictions.load(), (size_t) 1, "evictions are counted");
+      t.equals(queuedResponses.bytes(), (size_t) 80, "the store stays within its budget");
+
+      queuedResponses.put(createQueuedResponse(4, 200));
+      t.equals(queuedResponses.size(), (size_t) 1, "a response larger than the budget is kept on its own");
+    });
+
+    t.test("ssc::runtime::QueuedResponses eviction grace period", [](auto t) {
+      QueuedResponses queuedResponses(QueuedResponses::Options { .maxBytes = 100, .evictionGracePeriod = 50 });
+
+      queuedResponses.put(createQueuedResponse(1, 40));
+      queuedResponses.put(createQueuedResponse(2, 40));
+      queuedResponses.put(createQueuedResponse(3, 40));
+
+      t.equals(queuedResponses.size(), (size_t) 3, "entries in their grace period are not evicted");
+      t.equals((size_t) queuedResponses.counters.evictions.load(), (size_t) 0, "no evictions are counted");
+      t.equals(queuedResponses.bytes(), (size_t) 120, "the store may exceed its budget");
+
+      sleep(80);
+      queuedResponses.put(createQueuedResponse(4, 40));
+      t.equals(queuedResponses.size(), (size_t) 2, "entries past their grace period are evicted");
+      t.equals((size_t) queuedResponses.counters.evictions.load(), (size_t) 2, "evictions after the grace period are counted");
+    });
+
+    t.test("ssc::runtime::QueuedResponses counters", [](auto t) {
+      QueuedResponses queuedResponses;
+      QueuedResponse response;
+
+      queuedResponses.put(createQueuedResponse(1, 16));
+      t.assert(queuedResponses.take(1, response), "a queued entry is taken");
+      t.equals(response.length, (size_t) 16, "the taken response is the queued one");
+      t.assert(!queuedResponses.take(1, response), "an entry is only taken once");
+      t.assert(!queuedResponses.take(2, response), "an unknown entry is not taken");
+
+      t.equals((size_t) queuedResponses.counters.hits.load(), (size_t) 1, "hits are counted");
+      t.equals((size_t) queuedResponses.counters.misses.load(), (size_t) 2, "misses are counted");
+      t.equals(queuedResponses.bytes(), (size_t) 0, "taken bytes are released");
+    });
+  }
+}
@@ -69,6 +69,7 @@ namespace SSC::Tests {
   };
 
   // tests
+  void bytes (Harness&);
   void codec (Harness&);
   void config (Harness&);
   void env (Harness&);
@@ -76,6 +77,7 @@ namespace SSC::Tests {
   void json (Harness&);
   void platform (Harness&);
   void preload (Harness&);
+  void queuedResponses (Harness&);
   void string (Harness&);
   void version (Harness&);
 }
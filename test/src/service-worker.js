@@ -0,0 +1,152 @@
+import test from 'socket:test'
+import process from 'socket:process'
+import caches from 'socket:service-worker/cache'
+
+test('service-worker - native cache storage', async (t) => {
+  const name = `test-cache-${Math.random().toString(16).slice(2)}`
+  const url = new URL('/service-worker-cache/entry.txt', globalThis.location.href)
+
+  t.equal(await caches.has(name), false, 'cache does not exist before it is opened')
+
+  const cache = await caches.open(name)
+  t.equal(cache.name, name, 'opens a cache by name')
+  t.equal(await caches.has(name), true, 'cache exists once opened')
+  t.ok((await caches.keys()).includes(name), 'cache name is listed')
+
+  await cache.put(url, new Response('hello cache', {
+    status: 200,
+    headers: { 'content-type': 'text/plain' }
+  }))
+
+  let response = await cache.match(url)
+  t.ok(response, 'matches a stored request')
+  t.equal(response?.status, 200, 'matched response has the stored status')
+  t.equal(response?.headers.get('content-type'), 'text/plain', 'matched response has the stored headers')
+  t.equal(await response?.text(), 'hello cache', 'matched response has the stored body')
+
+  response = await caches.match(url, { cacheName: name })
+  t.equal(await response?.text(), 'hello cache', 'matches across cache storage')
+
+  const keys = await cache.keys()
+  t.equal(keys.length, 1, 'cache has a single key')
+  t.equal(keys[0]?.url, url.href, 'key is the stored request URL')
+
+  t.equal(await cache.delete(url), true, 'deletes a stored request')
+  t.equal(await cache.match(url), undefined, 'deleted request no longer matches')
+
+  t.equal(await caches.delete(name), true, 'deletes the cache')
+  t.equal(await caches.has(name), false, 'deleted cache no longer exists')
+})
+
+test('service-worker - streamed responses and large uploads', async (t) => {
+  const scriptURL = new URL('./service-worker/streaming.js', import.meta.url)
+  const scope = new URL('./service-worker/', import.meta.url)
+  const registration = await globalThis.navigator.serviceWorker.register(scriptURL, {
+    scope: scope.pathname
+  })
+
+  t.ok(registration, 'registers the service worker')
+
+  for (let i = 0; i < 100 && registration?.active?.state !== 'activated'; ++i) {
+    await new Promise((resolve) => setTimeout(resolve, 50))
+  }
+
+  const count = 512
+  let response = await fetch(new URL(`chunks?count=${count}`, scope))
+  t.equal(response.status, 200, 'streamed response has the worker status')
+  t.equal(response.headers.get('content-type'), 'text/plain', 'streamed response has the worker headers')
+
+  const expected = Array.from({ length: count }, (_, i) => `chunk-${i};`).join('')
+  t.equal(await response.text(), expected, 'streamed response body is complete and in order')
+
+  // larger than a single request body range
+  const upload = new Uint8Array(3 * 1024 * 1024 + 17)
+  let sum = 0
+  for (let i = 0; i < upload.byteLength; ++i) {
+    upload[i] = (i * 31) & 0xff
+    sum = (sum + upload[i]) % 65521
+  }
+
+  response = await fetch(new URL('echo', scope), { method: 'POST', body: upload })
+  t.equal(response.status, 200, 'upload response has the worker status')
+
+  const json = await response.json()
+  t.equal(json.size, upload.byteLength, 'worker receives the whole upload')
+  t.equal(json.sum, sum, 'worker receives the upload bytes in order')
+
+  await registration?.unregister()
+})
+
+test('service-worker - cached responses are served without the worker', async (t) => {
+  const scriptURL = new URL('./service-worker/streaming.js', import.meta.url)
+  const scope = new URL('./service-worker/', import.meta.url)
+  const registration = await globalThis.navigator.serviceWorker.register(scriptURL, {
+    scope: scope.pathname
+  })
+
+  for (let i = 0; i < 100 && registration?.active?.state !== 'activated'; ++i) {
+    await new Promise((resolve) => setTimeout(resolve, 50))
+  }
+
+  // the worker answers '404 not found' for this path
+  const url = new URL(`cached-${Math.random().toString(16).slice(2)}.txt`, scope)
+  let response = await fetch(url)
+  t.equal(response.status, 404, 'the worker does not know the request')
+
+  const name = `test-cache-${Math.random().toString(16).slice(2)}`
+  const cache = await caches.open(name)
+  await cache.put(url, new Response('from the cache', {
+    status: 200,
+    headers: { 'content-type': 'text/plain' }
+  }))
+
+  response = await fetch(url)
+  t.equal(response.status, 200, 'a cached GET has the cached status')
+  t.equal(response.headers.get('content-type'), 'text/plain', 'a cached GET has the cached headers')
+  t.equal(await response.text(), 'from the cache', 'a cached GET is answered from the cache')
+
+  response = await fetch(url, { method: 'POST', body: 'ignored' })
+  t.equal(response.status, 404, 'requests other than GET still reach the worker')
+
+  await caches.delete(name)
+  await registration?.unregister()
+})
+
+if (process.platform === 'linux') {
+  test('service-worker - streamed response memory stays bounded', async (t) => {
+    const scriptURL = new URL('./service-worker/streaming.js', import.meta.url)
+    const scope = new URL('./service-worker/', import.meta.url)
+    const registration = await globalThis.navigator.serviceWorker.register(scriptURL, {
+      scope: scope.pathname
+    })
+
+    for (let i = 0; i < 100 && registration?.active?.state !== 'activated'; ++i) {
+      await new Promise((resolve) => setTimeout(resolve, 50))
+    }
+
+    // `ru_maxrss` is the peak resident set size in kilobytes, a response
+    // buffered before it reaches the webview raises it by its whole size
+    const size = 64 * 1024 * 1024
+    const before = process.memoryUsage.rss()
+    const response = await fetch(new URL(`bytes?size=${size}`, scope))
+    t.equal(response.status, 200, 'streamed response has the worker status')
+
+    const reader = response.body.getReader()
+    let received = 0
+
+    while (true) {
+      const { done, value } = await reader.read()
+      if (done) {
+        break
+      }
+
+      received += value.byteLength
+    }
+
+    const growth = process.memoryUsage.rss() - before
+    t.equal(received, size, 'streamed response body is complete')
+    t.ok(growth < 32 * 1024, `peak memory grows by less than half the body (${growth} KB)`)
+
+    await registration?.unregister()
+  })
+}
@@ -0,0 +1,54 @@
+const encoder = new TextEncoder()
+
+export default {
+  async fetch (request) {
+    const url = new URL(request.url)
+
+    if (url.pathname.endsWith('/chunks')) {
+      const count = parseInt(url.searchParams.get('count')) || 0
+      let index = 0
+      return new Response(new ReadableStream({
+        pull (controller) {
+          if (index === count) {
+            controller.close()
+          } else {
+            controller.enqueue(encoder.encode(`chunk-${index++};`))
+          }
+        }
+      }), {
+        headers: { 'content-type': 'text/plain' }
+      })
+    }
+
+    if (url.pathname.endsWith('/bytes')) {
+      const size = parseInt(url.searchParams.get('size')) || 0
+      const chunk = new Uint8Array(64 * 1024).fill(0x61)
+      let written = 0
+      return new Response(new ReadableStream({
+        pull (controller) {
+          if (written >= size) {
+            controller.close()
+          } else {
+            const length = Math.min(chunk.byteLength, size - written)
+            controller.enqueue(chunk.subarray(0, length))
+            written += length
+          }
+        }
+      }), {
+        headers: { 'content-type': 'application/octet-stream' }
+      })
+    }
+
+    if (url.pathname.endsWith('/echo')) {
+      const body = new Uint8Array(await request.arrayBuffer())
+      let sum = 0
+      for (const byte of body) {
+        sum = (sum + byte) % 65521
+      }
+
+      return Response.json({ size: body.byteLength, sum })
+    }
+
+    return new Response('not found', { status: 404 })
+  }
+}
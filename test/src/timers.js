@@ -0,0 +1,52 @@
+import test from 'socket:test'
+import ipc from 'socket:ipc'
+
+// native timers resolve through the runtime timer wheel, a timer is never
+// early and is only late by the loop and IPC latency
+const TIMER_LATENESS_TOLERANCE = 40
+
+async function nativeTimeout (timeout) {
+  const start = performance.now()
+  const result = await ipc.request('timers.setTimeout', { timeout, wait: true })
+  return { err: result.err, timeout, elapsed: performance.now() - start }
+}
+
+test('timers - native timeouts with mixed deadlines fire on time', async (t) => {
+  // short deadlines keep level 0 occupied while the longer ones are parked
+  // on higher levels and cascade down
+  const timeouts = [
+    5, 10, 15, 20, 25, 30, 40, 50, 63, 64, 65, 90, 100, 110, 128, 150,
+    200, 250, 300
+  ]
+
+  const results = await Promise.all(timeouts.map(nativeTimeout))
+
+  for (const { err, timeout, elapsed } of results) {
+    t.ok(!err, `${timeout}ms timer fires without error`)
+    t.ok(elapsed >= timeout - 1, `${timeout}ms timer is not early (${elapsed.toFixed(1)}ms)`)
+    t.ok(
+      elapsed <= timeout + TIMER_LATENESS_TOLERANCE,
+      `${timeout}ms timer is not late (${elapsed.toFixed(1)}ms)`
+    )
+  }
+})
+
+test('timers - native timeouts keep firing while long timers are pending', async (t) => {
+  const long = nativeTimeout(1200)
+  const results = []
+
+  // a steady stream of short timers while a far deadline waits to cascade
+  for (let i = 0; i < 20; ++i) {
+    results.push(await nativeTimeout(7 + (i % 5) * 3))
+  }
+
+  results.push(await long)
+
+  for (const { err, timeout, elapsed } of results) {
+    t.ok(!err && elapsed >= timeout - 1, `${timeout}ms timer is not early`)
+    t.ok(
+      elapsed <= timeout + TIMER_LATENESS_TOLERANCE,
+      `${timeout}ms timer is not late (${elapsed.toFixed(1)}ms)`
+    )
+  }
+})